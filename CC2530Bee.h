@@ -8,6 +8,7 @@
 #include <PlatformTypes.h>
 #include <USART.h>
 #include <IEEE_802.15.4.h>
+#include "RxQueue.h"
    
 /*******************| Macros |*****************************************/
    
@@ -39,10 +40,280 @@
 #define CC2530BEE_Default_SourceAdressingMode           IEEE802154_FCF_ADDRESS_MODE_16BIT
 
 
+/**
+ * Default USART baud rate. Can be overridden at build time to boot at a
+ * faster rate.
+*/
+#ifndef CC2530BEE_Default_Baudrate
+#define CC2530BEE_Default_Baudrate                      USART_Baudrate_57600
+#endif
+
 /**
  * Default RO Time in multiple of character times
 */
 #define CC2530BEE_Default_RO_PacketizationTimeout       (uint8_t)0x03
+
+/**
+ * Operating modes of UART interface (AP). In transparent mode bytes received
+ * via UART are sent via radio as they are and received radio payload is
+ * written to UART unframed.
+*/
+#define CC2530BEE_APIMODE_TRANSPARENT                   (uint8_t)0x00
+#define CC2530BEE_APIMODE_UNESCAPED                     (uint8_t)0x01
+#define CC2530BEE_APIMODE_ESCAPED                       (uint8_t)0x02
+
+/**
+ * Default operating mode of UART interface
+*/
+#define CC2530BEE_Default_APIMode                       CC2530BEE_APIMODE_ESCAPED
+
+/**
+ * Sleep timer frequency (32kHz crystal) and mask of its 24bit count
+*/
+#define CC2530BEE_SLEEPTIMER_FREQUENCY                  (uint32_t)32768
+#define CC2530BEE_SLEEPTIMER_MASK                       (uint32_t)0x00ffffff
+
+/**
+ * Number of bits per UART character (start, 8 data and stop bit)
+*/
+#define CC2530BEE_UART_BITS_PER_CHARACTER               (uint8_t)10
+
+/**
+ * Valid channels (CH) of IEEE 802.15.4 in 2.4GHz band
+*/
+#define CC2530BEE_CHANNEL_FIRST                         (uint8_t)11
+#define CC2530BEE_CHANNEL_LAST                          (uint8_t)26
+
+/**
+ * Data frame carries payload of a TX request unchanged, so that other IEEE
+ * 802.15.4 nodes (XBee, SmartRF) receive and send plain payloads. Control
+ * frames of this firmware set reserved bit CC2530BEE_FCF_RESERVED_CONTROL in
+ * frame control field, which other nodes always send as 0, and start their
+ * payload with frame type.
+*/
+#define CC2530BEE_FCF_RESERVED_CONTROL                  (uint8_t)0x01
+#define CC2530BEE_FRAME_TYPE                            (uint8_t)0x00
+#define CC2530BEE_FRAME_TYPE_REMOTEAT                   (uint8_t)0x01
+#define CC2530BEE_FRAME_TYPE_AGGREGATE                  (uint8_t)0x02
+#define CC2530BEE_FRAME_TYPE_FRAGMENT                   (uint8_t)0x03
+
+/**
+ * Remote AT command request and response are sent via radio as frame of type
+ * CC2530BEE_FRAME_TYPE_REMOTEAT followed by the API frame. Addresses of
+ * request are removed as they are part of IEEE 802.15.4 header.
+*/
+#define CC2530BEE_REMOTEAT_API_IDENTIFIER               (uint8_t)0x01
+#define CC2530BEE_REMOTEAT_REQUEST_FRAMEID              (uint8_t)0x02
+#define CC2530BEE_REMOTEAT_REQUEST_OPTIONS              (uint8_t)0x03
+#define CC2530BEE_REMOTEAT_REQUEST_COMMAND              (uint8_t)0x04
+#define CC2530BEE_REMOTEAT_REQUEST_DATA                 (uint8_t)0x06
+
+/**
+ * Remote AT command response in transmit queue: API identifier
+ * UARTAPI_REMOTE_AT_COMMAND_RESPONSE and destination addresses as in remote
+ * AT command request, followed by payload of radio frame
+*/
+#define CC2530BEE_REMOTEAT_RESPONSE_PAYLOAD             UARTAPI_REMOTEAT_OPTIONS
+
+/**
+ * Maximum delay in sleep timer ticks of remote AT command response to a
+ * broadcast request, so that responses of all nodes don't collide.
+*/
+#ifndef CC2530BEE_REMOTEAT_JITTER
+#define CC2530BEE_REMOTEAT_JITTER                       (uint16_t)2048
+#endif
+
+/**
+ * Default number of retransmissions if no ACK was received (RR,
+ * macMaxFrameRetries) and minimum CSMA-CA backoff exponent (RN, macMinBE)
+*/
+#define CC2530BEE_Default_MACRetries                    (uint8_t)3
+#define CC2530BEE_Default_MinBackoffExponent            (uint8_t)0
+
+/**
+ * Limits of unslotted CSMA-CA and MAC retries. Transmission fails with CCA
+ * failure after CC2530BEE_CSMA_MAX_BACKOFFS further busy CCAs.
+*/
+#define CC2530BEE_CSMA_MAX_BACKOFFS                     (uint8_t)4
+#define CC2530BEE_CSMA_MAX_BACKOFF_EXPONENT             (uint8_t)5
+#define CC2530BEE_MIN_BACKOFF_EXPONENT_LAST             (uint8_t)3
+#define CC2530BEE_MACRETRIES_LAST                       (uint8_t)7
+
+/**
+ * Unit backoff period (20 symbols, 320us) in sleep timer ticks, rounded up
+ * by one tick as sleep timer is read at arbitrary phase.
+*/
+#define CC2530BEE_BACKOFF_PERIOD_TICKS                  (uint32_t)12
+
+/**
+ * ACK wait in sleep timer ticks. Timer starts when frame is handed to radio,
+ * thus it covers air time of a frame of maximum size (133 bytes, 4256us)
+ * plus macAckWaitDuration (54 symbols, 864us), rounded up.
+*/
+#define CC2530BEE_ACK_WAIT_TICKS                        (uint32_t)169
+
+/**
+ * Aggregated frame (AG): frame type CC2530BEE_FRAME_TYPE_AGGREGATE followed by
+ * one record per TX request, made of its payload length and payload.
+*/
+#define CC2530BEE_AGGREGATE_RECORDS                     (uint8_t)0x01
+
+/**
+ * Largest payload sent in one radio frame (aggregated frame, fragment or TX
+ * request), must fit into RX queue slot of receiving node
+*/
+#define CC2530BEE_MAX_FRAME_PAYLOAD_LENGTH              (uint8_t)RXQUEUE_MAX_PAYLOAD_LENGTH
+
+/**
+ * Fragment of a TX request payload larger than
+ * CC2530BEE_MAX_FRAME_PAYLOAD_LENGTH: frame type CC2530BEE_FRAME_TYPE_FRAGMENT,
+ * tag of payload, index of fragment and number of fragments followed by data.
+ * All but the last fragment carry CC2530BEE_FRAGMENT_DATA_LENGTH bytes of data.
+*/
+#define CC2530BEE_FRAGMENT_TAG                          (uint8_t)0x01
+#define CC2530BEE_FRAGMENT_INDEX                        (uint8_t)0x02
+#define CC2530BEE_FRAGMENT_COUNT                        (uint8_t)0x03
+#define CC2530BEE_FRAGMENT_DATA                         (uint8_t)0x04
+#define CC2530BEE_FRAGMENT_DATA_LENGTH                  (uint8_t)(CC2530BEE_MAX_FRAME_PAYLOAD_LENGTH - CC2530BEE_FRAGMENT_DATA)
+
+/**
+ * Time in sleep timer ticks after which an incomplete reassembly is
+ * discarded
+*/
+#ifndef CC2530BEE_REASSEMBLY_TIMEOUT
+#define CC2530BEE_REASSEMBLY_TIMEOUT                    (uint32_t)32768
+#endif
+
+/**
+ * Default aggregation window in milliseconds (AG), 0 disables aggregation
+*/
+#define CC2530BEE_Default_AggregationWindow             (uint8_t)0
+
+/**
+ * Default time in ms a received frame is remembered to drop retransmissions
+ * of it (DW), 0 disables suppression. Covers all MAC retries but is shorter
+ * than a sender needs for 256 frames, after which sequence numbers repeat.
+*/
+#define CC2530BEE_Default_DuplicateWindow               (uint16_t)250
+
+/**
+ * Sleep modes (SM) as XBee: pin hibernate (PM2) and pin doze (PM1, faster
+ * wake-up) sleep while SLEEP_RQ pin is high, cyclic sleep wakes every SP after
+ * ST of inactivity, with pin wake-up also while SLEEP_RQ is low. 3 is
+ * reserved and behaves like no sleep.
+*/
+#define CC2530BEE_SLEEPMODE_NONE                        (uint8_t)0x00
+#define CC2530BEE_SLEEPMODE_PIN_HIBERNATE               (uint8_t)0x01
+#define CC2530BEE_SLEEPMODE_PIN_DOZE                    (uint8_t)0x02
+#define CC2530BEE_SLEEPMODE_CYCLIC                      (uint8_t)0x04
+#define CC2530BEE_SLEEPMODE_CYCLIC_PIN                  (uint8_t)0x05
+
+/**
+ * Default sleep mode (SM), cyclic sleep period in 10 ms (SP) and time of
+ * inactivity in ms before cyclic sleep (ST)
+*/
+#define CC2530BEE_Default_SleepMode                     CC2530BEE_SLEEPMODE_NONE
+#define CC2530BEE_Default_SleepPeriod                   (uint16_t)100
+#define CC2530BEE_Default_TimeBeforeSleep               (uint16_t)5000
+
+/**
+ * Wake-up time from PM2 (regulator and 32MHz crystal start-up, about 0.4 ms)
+ * and PM1 in sleep timer ticks. Sleep timer compare is set this much earlier,
+ * so that UART and radio are ready when sleep period ends.
+*/
+#define CC2530BEE_WAKEUP_TICKS_PM2                      (uint32_t)14
+#define CC2530BEE_WAKEUP_TICKS_PM1                      (uint32_t)1
+
+/**
+ * Longest sleep in sleep timer ticks before main loop runs again, keeps
+ * watchdog (250 ms) fed
+*/
+#define CC2530BEE_SLEEP_MAX_TICKS                       (uint32_t)6554
+
+/**
+ * Interval in sleep timer ticks at which SLEEP_RQ pin is checked while
+ * asleep, bounds latency of pin wake-up
+*/
+#ifndef CC2530BEE_PINSLEEP_POLL_TICKS
+#define CC2530BEE_PINSLEEP_POLL_TICKS                   (uint32_t)655
+#endif
+
+/**
+ * Levels of CC2530BEE_CTS_PIN, CTS is deasserted while asleep so that host
+ * holds back bytes until UART is running again
+*/
+#define CC2530BEE_CTS_ASSERTED                          (uint8_t)0
+#define CC2530BEE_CTS_DEASSERTED                        (uint8_t)1
+
+/**
+ * Default channels of energy scan (SC), bit 0 is channel 11
+*/
+#define CC2530BEE_Default_ScanChannels                  (uint16_t)0xffff
+
+/**
+ * Default energy scan duration exponent (SD), each channel is sampled for
+ * 2^SD * 15.36 ms as XBee
+*/
+#define CC2530BEE_Default_ScanDuration                  (uint8_t)2
+#define CC2530BEE_SCANDURATION_LAST                     (uint8_t)0x0f
+
+/**
+ * Energy scan time per channel for SD 0 in sleep timer ticks (15.36 ms)
+*/
+#define CC2530BEE_SCAN_TICKS                            (uint32_t)503
+
+/**
+ * Coordinator association (A2) as XBee. Only reassign channel is supported:
+ * if set, channels of SC are scanned at boot and the one with least energy
+ * is used instead of CH. Other bits are stored but have no effect.
+*/
+#define CC2530BEE_A2_REASSIGN_CHANNEL                   (uint8_t)0x02
+#define CC2530BEE_A2_LAST                               (uint8_t)0x07
+#define CC2530BEE_Default_CoordinatorAssociation        (uint8_t)0x00
+
+/**
+ * Radio registers used by energy scan: RSSISTAT.RSSI_VALID, offset of RSSI
+ * register to dBm, FREQCTRL of channel 11 and channel spacing and RFST
+ * command strobes
+*/
+#define CC2530BEE_RSSISTAT_VALID                        (uint8_t)0x01
+#define CC2530BEE_RSSI_OFFSET                           (sint8_t)(-73)
+#define CC2530BEE_FREQCTRL_FIRST                        (uint8_t)11
+#define CC2530BEE_FREQCTRL_SPACING                      (uint8_t)5
+#define CC2530BEE_RFST_ISRXON                           (uint8_t)0xe3
+#define CC2530BEE_RFST_ISRFOFF                          (uint8_t)0xef
+
+/**
+ * Sniffer mode (SN): 1 streams every frame received, including those with CRC
+ * errors or addressed to other nodes, as capture records (see Sniffer.h)
+ * instead of RX packets. FRMFILT0.FRM_FILTER_EN and FRMCTRL0.AUTOACK are
+ * cleared meanwhile, so that frames of other nodes are neither dropped nor
+ * acknowledged.
+*/
+#define CC2530BEE_SNIFFERMODE_OFF                       (uint8_t)0x00
+#define CC2530BEE_SNIFFERMODE_ON                        (uint8_t)0x01
+#define CC2530BEE_Default_SnifferMode                   CC2530BEE_SNIFFERMODE_OFF
+#define CC2530BEE_FRMFILT0_FRM_FILTER_EN                (uint8_t)0x01
+#define CC2530BEE_FRMCTRL0_AUTOACK                      (uint8_t)0x20
+
+/**
+ * Marks CC2530Bee_statistics as valid after a reset which kept RAM content
+*/
+#define CC2530BEE_STATISTICS_MAGIC                      (uint16_t)0x5a17
+
+/**
+ * FSMSTAT1.CCA, set while channel is clear
+*/
+#define CC2530BEE_FSMSTAT1_CCA                          (uint8_t)0x10
+
+/**
+ * Side effects of parameter changes staged in shadow configuration, see
+ * CC2530Bee_stageConfig. CC2530BEE_CONFIGCHANGE_PARAMETER has none.
+*/
+#define CC2530BEE_CONFIGCHANGE_PARAMETER                (uint8_t)0x01
+#define CC2530BEE_CONFIGCHANGE_RADIO                    (uint8_t)0x02           /* radio must be re-initialized */
+#define CC2530BEE_CONFIGCHANGE_APIMODE                  (uint8_t)0x04
+#define CC2530BEE_CONFIGCHANGE_BAUDRATE                 (uint8_t)0x08
    
 /** 
  * UART crc ok
@@ -54,6 +325,29 @@
 */
 #define UARTFrame_CRC_Not_OK                            (uint8_t)0x00
 
+/** 
+ * UART frame not yet completely received
+*/
+#define UARTFrame_Incomplete                            (uint8_t)0x02
+
+/**
+ * Maximum length of UART API frame data (buffer size), TX request with
+ * largest payload
+*/
+#define UARTAPI_MAX_PAYLOAD_LENGTH                      (uint16_t)(UARTAPI_64BITTRANSMIT_DATA + FRAGMENT_MAX_PAYLOAD_LENGTH)
+
+/**
+ * In transparent mode transmit queue slot is sent once it holds this many
+ * bytes including TX request header, so that it fits into one radio frame
+*/
+#define CC2530BEE_TRANSPARENT_MAX_LENGTH                (uint16_t)100
+
+/**
+ * Maximum length of UART API frames built in txAPIFrame.data (AT command
+ * responses, status frames). RX packets are sent from receive queue directly.
+*/
+#define UARTAPI_MAX_RESPONSE_LENGTH                     (uint16_t)64
+
 /**
  * UART rx frame escape mask
 */
@@ -79,6 +373,19 @@
 */
 #define UARTFrame_XOFF                                  (uint8_t)0x13
 
+/**
+ * Character classes of UART API frame bytes, see UARTAPI_charClass in main.c.
+ * ESCAPE: byte must be escaped when sent. CONTROL: delimiter or escape
+ * character, needs special handling on receive.
+*/
+#define UARTAPI_CHARCLASS_ESCAPE                        (uint8_t)0x01
+#define UARTAPI_CHARCLASS_CONTROL                       (uint8_t)0x02
+
+/**
+ * Number of bytes fetched from USART rx buffer at once by UARTAPI_receiveFrame
+*/
+#define UARTAPI_RX_BUFFER_SIZE                          (uint8_t)16
+
 #define UARTAPI_MODEMSTATUS                             (uint8_t)0x8a
 #define UARTAPI_ATCOMMAND                               (uint8_t)0x08
 #define UARTAPI_ATCOMMAND_QUEUE                         (uint8_t)0x09
@@ -92,6 +399,21 @@
 #define UARTAPI_RECEIVE_PACKAGE_16BIT                   (uint8_t)0x81
 #define UARTAPI_RECEIVE_PACKAGE_NONE                    (uint8_t)0x82   /* Not defined in original chip */
 #define UARTAPI_ECHOTEST                                (uint8_t)0x44   /* Not defined in original chip, only for testing UART communication */
+#define UARTAPI_TRACE_DUMP_REQUEST                      (uint8_t)0x45   /* Not defined in original chip, see UARTAPI_traceDump */
+#define UARTAPI_TRACE_DUMP                              (uint8_t)0xc5   /* Not defined in original chip */
+#define UARTAPI_NEIGHBOUR_TABLE_REQUEST                 (uint8_t)0x46   /* Not defined in original chip, see UARTAPI_neighbourTable */
+#define UARTAPI_NEIGHBOUR_TABLE                         (uint8_t)0xc6   /* Not defined in original chip */
+
+#define UARTAPI_TRACE_DUMP_REQUEST_LENGTH               (uint16_t)0x02
+#define UARTAPI_TRACE_DUMP_FRAMEID                      (uint8_t)0x01
+#define UARTAPI_TRACE_DUMP_COUNT                        (uint8_t)0x02           /* Number of entries in frame */
+#define UARTAPI_TRACE_DUMP_DROPPED                      (uint8_t)0x03           /* Entries lost since last dump, saturates at 255 */
+#define UARTAPI_TRACE_DUMP_ENTRIES                      (uint8_t)0x04           /* Trace_Entry_t oldest first */
+
+#define UARTAPI_NEIGHBOUR_TABLE_REQUEST_LENGTH          (uint16_t)0x02
+#define UARTAPI_NEIGHBOUR_TABLE_FRAMEID                 (uint8_t)0x01
+#define UARTAPI_NEIGHBOUR_TABLE_COUNT                   (uint8_t)0x02           /* Number of entries in frame */
+#define UARTAPI_NEIGHBOUR_TABLE_ENTRIES                 (uint8_t)0x03           /* NEIGHBOUR_ENTRY_LENGTH bytes each, see Neighbour.h */
 
 #define UARTAPI_MODEMSTATUS_DATA                        (uint8_t)0x01
 #define UARTAPI_MODEMSTATUS_LENGTH                      (uint16_t)0x02
@@ -110,14 +432,54 @@
 
 #define UARTAPI_ATCOMMAND_WRITE                         (uint16_t)0x5752        /* WR */
 #define UARTAPI_ATCOMMAND_RESTOREDEFAULTS               (uint16_t)0x5245        /* RE */
+#define UARTAPI_ATCOMMAND_APPLYCHANGES                  (uint16_t)0x4143        /* AC */
 #define UARTAPI_ATCOMMAND_SOFTWARERESET                 (uint16_t)0x4652        /* FR */
 #define UARTAPI_ATCOMMAND_CHANNEL                       (uint16_t)0x4348        /* CH */
 #define UARTAPI_ATCOMMAND_PANID                         (uint16_t)0x4944        /* ID */
 #define UARTAPI_ATCOMMAND_DESTINATIONADDRESSHIGH        (uint16_t)0x4448        /* DH */
 #define UARTAPI_ATCOMMAND_DESTINATIONADDRESSLOW         (uint16_t)0x444c        /* DL */
+#define UARTAPI_ATCOMMAND_DUPLICATEWINDOW               (uint16_t)0x4457        /* DW */
 #define UARTAPI_ATCOMMAND_SOURCEADDRESS16BIT            (uint16_t)0x4d59        /* MY */
 #define UARTAPI_ATCOMMAND_SERIALNUMBERHIGH              (uint16_t)0x5348        /* SH */
 #define UARTAPI_ATCOMMAND_SERIALNUMBERLOW               (uint16_t)0x534c        /* SL */
+#define UARTAPI_ATCOMMAND_APIENABLE                     (uint16_t)0x4150        /* AP */
+#define UARTAPI_ATCOMMAND_BAUDRATE                      (uint16_t)0x4244        /* BD */
+#define UARTAPI_ATCOMMAND_MACRETRIES                    (uint16_t)0x5252        /* RR */
+#define UARTAPI_ATCOMMAND_RANDOMDELAYSLOTS              (uint16_t)0x524e        /* RN */
+#define UARTAPI_ATCOMMAND_AGGREGATIONWINDOW             (uint16_t)0x4147        /* AG */
+#define UARTAPI_ATCOMMAND_SLEEPMODE                     (uint16_t)0x534d        /* SM */
+#define UARTAPI_ATCOMMAND_SNIFFERMODE                   (uint16_t)0x534e        /* SN */
+#define UARTAPI_ATCOMMAND_SLEEPPERIOD                   (uint16_t)0x5350        /* SP */
+#define UARTAPI_ATCOMMAND_TIMEBEFORESLEEP               (uint16_t)0x5354        /* ST */
+#define UARTAPI_ATCOMMAND_ACKFAILURES                   (uint16_t)0x4541        /* EA */
+#define UARTAPI_ATCOMMAND_CCAFAILURES                   (uint16_t)0x4543        /* EC */
+#define UARTAPI_ATCOMMAND_STATISTICS                    (uint16_t)0x5853        /* XS */
+#define UARTAPI_ATCOMMAND_ENERGYSCAN                    (uint16_t)0x4544        /* ED */
+#define UARTAPI_ATCOMMAND_SCANCHANNELS                  (uint16_t)0x5343        /* SC */
+#define UARTAPI_ATCOMMAND_SCANDURATION                  (uint16_t)0x5344        /* SD */
+#define UARTAPI_ATCOMMAND_COORDINATORASSOCIATION        (uint16_t)0x4132        /* A2 */
+#define UARTAPI_ATCOMMAND_LINKQUALITY                   (uint16_t)0x4c51        /* LQ */
+
+/**
+ * Access rights and storage of AT command parameter, see UARTAPI_ATCommand_t
+*/
+#define UARTAPI_ATPARAM_READ                            (uint8_t)0x01
+#define UARTAPI_ATPARAM_WRITE                           (uint8_t)0x02
+#define UARTAPI_ATPARAM_EXECUTE                         (uint8_t)0x04           /* no parameter, execute is called after response was sent */
+#define UARTAPI_ATPARAM_TXHEADER                        (uint8_t)0x08           /* offset is relative to tx header template instead of CC2530Bee_Config_t */
+#define UARTAPI_ATPARAM_BAUDRATE                        (uint8_t)0x10           /* parameter is BD value, stored as USART_Baudrate_t */
+#define UARTAPI_ATPARAM_STATISTICS                      (uint8_t)0x20           /* offset is relative to CC2530Bee_statistics, writing 0 clears counters */
+#define UARTAPI_ATPARAM_DEFERRED                        (uint8_t)0x40           /* with EXECUTE: execute sends response itself once done, see UARTAPI_sendDeferredResponse */
+#define UARTAPI_ATPARAM_NEIGHBOUR                       (uint8_t)0x80           /* read only, parameter is index of neighbour table entry, see UARTAPI_readNeighbour */
+#define UARTAPI_ATPARAM_NUMBER                          (uint16_t)0x0100        /* two byte number, sent most significant byte first */
+
+/**
+ * Number of entries in #UARTAPI_atCommands
+*/
+#define UARTAPI_NUM_ATCOMMANDS                          29
+
+#define UARTAPI_BAUDRATE_FIRST                          (uint8_t)0x01           /* BD value of first entry in UARTAPI_baudrates (2400) */
+#define UARTAPI_NUM_BAUDRATES                           (uint8_t)8
 
 #define UARTAPI_ATCOMMAND_RESPONSE_FRAMEID              (uint8_t)0x01
 #define UARTAPI_ATCOMMAND_RESPONSE_COMMAND              (uint8_t)0x02
@@ -142,16 +504,30 @@
 #define UARTAPI_16BITTRANSMIT_OPTIONS                   (uint8_t)0x04
 #define UARTAPI_16BITTRANSMIT_DATA                      (uint8_t)0x05
 
-#define UARTAPI_TX_STATUS_HEADER_SIZE                   (uint8_t)0x04
-#define UARTAPI_TX_STATUS_PAYLOAD_SIZE                  (uint8_t)0x02
+#define UARTAPI_REMOTEAT_FRAMEID                        (uint8_t)0x01
+#define UARTAPI_REMOTEAT_ADDRESS64                      (uint8_t)0x02
+#define UARTAPI_REMOTEAT_ADDRESS16                      (uint8_t)0x0a
+#define UARTAPI_REMOTEAT_OPTIONS                        (uint8_t)0x0c
+#define UARTAPI_REMOTEAT_COMMAND                        (uint8_t)0x0d
+#define UARTAPI_REMOTEAT_DATA                           (uint8_t)0x0f
+#define UARTAPI_REMOTEAT_OPTIONS_APPLYCHANGES           (uint8_t)0x02
+#define UARTAPI_REMOTEAT_USE_64BIT_ADDRESS              (uint16_t)0xfffe        /* 16bit address of request if 64bit address is used */
+
+#define UARTAPI_REMOTEAT_RESPONSE_FRAMEID               (uint8_t)0x01
+#define UARTAPI_REMOTEAT_RESPONSE_ADDRESS64             (uint8_t)0x02
+#define UARTAPI_REMOTEAT_RESPONSE_ADDRESS16             (uint8_t)0x0a
+#define UARTAPI_REMOTEAT_RESPONSE_COMMAND               (uint8_t)0x0c
+#define UARTAPI_REMOTEAT_RESPONSE_STATUS                (uint8_t)0x0e
+
 #define UARTAPI_TX_STATUS_FRAME_ID                      (uint8_t)0x01
 #define UARTAPI_TX_STATUS_STATUS_BYTE                   (uint8_t)0x02
+#define UARTAPI_TX_STATUS_LENGTH                        (uint16_t)0x03
 #define UARTAPI_TX_STATUS_SUCCESS                       (uint8_t)0x00
-#define UARTAPI_TX_STATUS_NOACK                         (uint8_t)0x00
-#define UARTAPI_TX_STATUS_CCAFAILURE                    (uint8_t)0x00
-#define UARTAPI_TX_STATUS_PURGED                        (uint8_t)0x00
+#define UARTAPI_TX_STATUS_NOACK                         (uint8_t)0x01
+#define UARTAPI_TX_STATUS_CCAFAILURE                    (uint8_t)0x02
+#define UARTAPI_TX_STATUS_PURGED                        (uint8_t)0x03
    
-#define UARTAPI_64BITRECEIVE_HEADER_SIZE                (uint8_t)0x05
+#define UARTAPI_64BITRECEIVE_HEADER_SIZE                (uint8_t)0x0b
    
 #define UARTAPI_16BITRECEIVE_HEADER_SIZE                (uint8_t)0x05
 
@@ -162,17 +538,35 @@
 
 /*******************| Type definitions |*******************************/
 
+/* Frame headers are read/written byte-wise from/to USART, thus they must not
+ * contain any padding when compiled for a non 8-bit host (see HostSim). */
+#ifdef __GNUC__
+#pragma pack(push, 1)
+#endif
+
 /**
  * \brief Struct to store all kind of configuration data for CC2530Bee.
- * This variable will be stored in EEPROM
+ * This variable will be stored in flash (see ConfigStore.h)
  */
 typedef struct {
   USART_Baudrate_t USART_Baudrate;
   USART_Parity_t USART_Parity;
   IEEE802154_Config_t IEEE802154_config;
   IEEE802154_DataFrameHeader_t IEEE802154_TxDataFrame;  /*!< IEEE 802.15.4 struct to store tx configuration information */
-  uint8_t RO_PacketizationTimeout;  /*!< Timout in milliseconds after which data received via UART will be packed and sent via radio. */
-  uint8_t crc;                 /*!< crc to be saved in EEPROM to check if data is valid */
+  uint8_t RO_PacketizationTimeout;  /*!< Timeout in character times after which data received via UART in transparent mode will be packed and sent via radio. */
+  uint8_t APIMode;             /*!< Operating mode of UART interface (AP) */
+  uint8_t MACRetries;          /*!< Retransmissions of unacknowledged frames (RR) */
+  uint8_t MinBackoffExponent;  /*!< Minimum backoff exponent of CSMA-CA (RN) */
+  uint8_t AggregationWindow;   /*!< Time in ms TX requests to same destination are collected into one frame (AG), 0: off */
+  uint8_t SleepMode;           /*!< CC2530BEE_SLEEPMODE_* (SM) */
+  uint16_t SleepPeriod;        /*!< Cyclic sleep period in 10 ms (SP), 0: no cyclic sleep */
+  uint16_t TimeBeforeSleep;    /*!< Time of inactivity in ms before cyclic sleep (ST) */
+  uint16_t ScanChannels;       /*!< Channels of energy scan, bit 0 is channel 11 (SC) */
+  uint8_t ScanDuration;        /*!< Exponent of energy scan time per channel (SD) */
+  uint8_t CoordinatorAssociation; /*!< CC2530BEE_A2_* (A2) */
+  uint16_t DuplicateWindow;    /*!< Time in ms retransmissions of a received frame are dropped (DW), 0: off */
+  uint8_t SnifferMode;         /*!< CC2530BEE_SNIFFERMODE_* (SN) */
+  uint8_t crc;                 /*!< CRC of flash record up to this byte, see ConfigStore_Record_t */
 } CC2530Bee_Config_t;
 
 typedef struct {
@@ -196,6 +590,9 @@ typedef struct {
   uint8_t delimiter; 
   uint16_t length;
 } APIFrameHeader_t;
+#ifdef __GNUC__
+#pragma pack(pop)
+#endif
 
 /**
  * Datatype used for USAR API payload and pointer to payload
@@ -212,26 +609,301 @@ typedef struct {
   uint8_t crc;
 } APIFrame_t;
 
+/**
+ * \brief Collection of UART bytes into a radio frame in transparent mode.
+ * Bytes are read into the next free transmit queue slot behind a TX request
+ * header addressed to DH/DL.
+*/
+typedef struct {
+  uint16_t length;              /*!< Bytes in transmit queue slot including TX request header, 0 if none */
+  uint32_t lastRxTime;          /*!< Sleep timer count when bytes were read from USART last */
+  uint32_t timeout;             /*!< RO_PacketizationTimeout in sleep timer ticks */
+} CC2530Bee_TransparentTx_t;
+
+/**
+ * \brief UART API frame codec.
+ * Escaping of frame data on send and unescaping on receive of one API mode.
+*/
+typedef struct {
+  uint8_t (*write)(const APIFramePayload_t *data, uint16_t length);  /*!< Writes data via USART, returns sum of data */
+  void (*receiveData)(APIFrame_t *frame);                            /*!< Decodes frame data from #UARTAPI_rxParser buffer */
+} UARTAPI_Codec_t;
+
+/**
+ * \brief Segment of UART API frame data.
+ * Used to send frame data scattered over several buffers without copying.
+*/
+typedef struct {
+  const APIFramePayload_t *data;
+  uint16_t length;
+} UARTAPI_Segment_t;
+
+/**
+ * \brief States of UART API frame receiver
+*/
+typedef enum {
+  UARTAPI_RxState_Delimiter,
+  UARTAPI_RxState_Length0,
+  UARTAPI_RxState_Length1,
+  UARTAPI_RxState_Data,
+  UARTAPI_RxState_Checksum,
+} UARTAPI_RxState_t;
+
+/**
+ * \brief UART API frame receiver.
+ * Keeps state of frame reception between calls of UARTAPI_receiveFrame.
+*/
+typedef struct {
+  UARTAPI_RxState_t state;
+  uint16_t index;       /*!< Next position in frame data */
+  uint8_t crc;          /*!< Sum of data received so far */
+  uint8_t escaped;      /*!< Last byte was escape character */
+  uint8_t bufferIndex;  /*!< Next unparsed byte in buffer */
+  uint8_t bufferLength; /*!< Number of bytes in buffer */
+  uint8_t buffer[UARTAPI_RX_BUFFER_SIZE]; /*!< Bytes read from USART but not yet parsed */
+} UARTAPI_RxParser_t;
+
+/**
+ * \brief AT command descriptor.
+ * Describes where parameter of AT command is stored and how it can be accessed.
+*/
+typedef struct {
+  uint16_t command;             /*!< Two characters of AT command, e.g. 0x4348 for CH */
+  uint16_t flags;               /*!< Access rights and storage, UARTAPI_ATPARAM_* */
+  uint8_t offset;               /*!< Offset of parameter in CC2530Bee_Config_t or tx header template */
+  uint8_t width;                /*!< Number of bytes of parameter in AT command */
+  uint8_t min;                  /*!< Smallest valid value, only checked for one byte parameters */
+  uint8_t max;                  /*!< Largest valid value, only checked for one byte parameters */
+  uint8_t changes;              /*!< Side effects of write, CC2530BEE_CONFIGCHANGE_* */
+  void (*execute)(void);        /*!< Function of UARTAPI_ATPARAM_EXECUTE command */
+} UARTAPI_ATCommand_t;
+
+/**
+ * \brief Remote AT command response waiting to be sent via radio.
+ * Response to broadcast request is delayed by a random jitter, afterwards it
+ * is sent via transmit queue. Command is executed or changes are applied once
+ * response was sent.
+*/
+typedef struct {
+  uint8_t length;               /*!< Bytes in payload, 0 if no response is pending */
+  uint8_t queued;               /*!< 1 once response was appended to transmit queue */
+  uint32_t startTime;           /*!< Sleep timer count when request was received */
+  uint16_t delay;               /*!< Sleep timer ticks to wait before sending */
+  uint8_t destinationAddressMode;
+  IEEE802154_ShortAddress_t shortAddress;               /*!< Valid if destinationAddressMode is 16bit */
+  IEEE802154_ExtendedAddress_t extendedAddress;         /*!< Valid if destinationAddressMode is 64bit */
+  const __code UARTAPI_ATCommand_t *command;            /*!< Command to finish once response was sent, NULL if it failed */
+  uint8_t apply;                /*!< Apply staged changes once response was sent */
+  APIFramePayload_t payload[CC2530BEE_REMOTEAT_API_IDENTIFIER + UARTAPI_REMOTEAT_RESPONSE_STATUS + UARTAPI_MAX_RESPONSE_LENGTH];
+} CC2530Bee_RemoteATResponse_t;
+
+/**
+ * Buffer in which fragments of a payload from one sender are reassembled.
+ * Fragments must arrive in order, a repeated fragment is ignored.
+*/
+typedef struct {
+  uint8_t inUse;
+  RxQueue_Source_t source;      /*!< Sender and reception of first fragment */
+  uint8_t tag;
+  uint8_t numFragments;
+  uint8_t nextFragment;
+  uint16_t length;              /*!< Number of bytes reassembled so far */
+  uint32_t startTime;           /*!< Sleep timer when first fragment was received */
+  IEEE802154_Payload payload[FRAGMENT_MAX_PAYLOAD_LENGTH];
+} CC2530Bee_Reassembly_t;
+
+/**
+ * \brief Sleep state, see CC2530Bee_sleepPoll
+*/
+typedef struct {
+  uint8_t asleep;
+  uint8_t powerMode;            /*!< SLEEPCMD_MODE_* used while asleep */
+  uint32_t lastActivity;        /*!< Sleep timer count when module was busy last (ST) */
+  uint32_t sleepStart;          /*!< Sleep timer count when module went to sleep (SP) */
+} CC2530Bee_Sleep_t;
+
+/**
+ * \brief Runtime statistics (XS), see UARTAPI_readParameter.
+ * Counters wrap around. They are kept across watchdog and software resets and
+ * cleared on power-on or by writing 0 to XS. Queue counters are maintained by
+ * the queues themselves and restart with them.
+*/
+typedef struct {
+  uint16_t uartRxATCommand;     /*!< AT command and queued AT command frames (0x08, 0x09) */
+  uint16_t uartRxTxRequest;     /*!< TX request frames (0x00, 0x01) */
+  uint16_t uartRxRemoteAT;      /*!< Remote AT command request frames (0x17) */
+  uint16_t uartRxEcho;          /*!< Echo test frames (0x44), each is sent back */
+  uint16_t uartRxUnknown;       /*!< Frames with unsupported API identifier */
+  uint16_t uartChecksumErrors;
+  uint16_t uartLengthErrors;    /*!< Frames discarded as length was 0 or too large */
+  uint16_t uartRxBufferFull;    /*!< USART rx ring buffer found full, further bytes may have been lost */
+  uint16_t uartTxATResponse;    /*!< AT command response frames (0x88) */
+  uint16_t uartTxStatus;        /*!< TX status frames (0x89) */
+  uint16_t uartTxRxPacket;      /*!< RX packet frames (0x80, 0x81, 0x82) */
+  uint16_t uartTxRemoteAT;      /*!< Remote AT command response frames (0x97) */
+  uint16_t uartTxModemStatus;   /*!< Modem status frames (0x8a) */
+  uint16_t radioTxFrames;       /*!< Radio frames sent including retries and fragments */
+  uint16_t ackTimeouts;         /*!< ACK waits expired, frame is retried if RR allows */
+  uint16_t ackFailures;         /*!< Transmissions given up without ACK (EA) */
+  uint16_t ccaFailures;         /*!< Transmissions given up as channel was busy (EC) */
+  uint16_t radioRxFrames;       /*!< Data frames received */
+  uint16_t radioCRCErrors;
+  uint16_t radioOtherFrames;    /*!< Beacon and MAC command frames received, they are ignored */
+  uint16_t radioRxDuplicates;   /*!< Data frames dropped as copy of a frame received within DW */
+  uint16_t rxQueueOverflows;    /*!< Data frames lost as receive queue or frame pool was full (RxQueue_overflowCount) */
+  uint16_t snifferOverflows;    /*!< Capture records lost as sniffer buffer was full (Sniffer_overflowCount) */
+  uint16_t watchdogResets;      /*!< Including software resets (FR) */
+  uint8_t txQueueHighWater;     /*!< Most transmit queue slots used at once (TxQueue_highWater) */
+  uint8_t rxQueueHighWater;     /*!< Most receive queue slots used at once (RxQueue_highWater) */
+  uint8_t framePoolHighWater;   /*!< Most frame pool buffers used at once (FramePool_highWater) */
+} CC2530Bee_Statistics_t;
+
+/**
+ * States of energy scan, see CC2530Bee_scanPoll
+*/
+typedef enum {
+  CC2530BeeScan_Idle,
+  CC2530BeeScan_Pending,                /*!< Waiting for radio to finish current frame */
+  CC2530BeeScan_Running,                /*!< Radio is tuned to scanned channel, transmissions are held back */
+} CC2530BeeScanState_t;
+
+/**
+ * \brief Energy scan (ED, A2) state
+*/
+typedef struct {
+  CC2530BeeScanState_t state;
+  uint8_t reassign;             /*!< Use quietest channel once done (A2) instead of sending ED response */
+  uint8_t frameId;              /*!< Frame ID of ED command */
+  uint8_t channel;              /*!< Channel sampled currently */
+  sint8_t peak;                 /*!< Highest energy in dBm on channel so far */
+  uint32_t startTime;           /*!< Sleep timer when channel was tuned */
+  uint32_t dwell;               /*!< Sleep timer ticks per channel (SD) */
+  uint8_t energy[CC2530BEE_CHANNEL_LAST - CC2530BEE_CHANNEL_FIRST + 1]; /*!< Peak energy in -dBm per channel, valid for channels of SC */
+} CC2530Bee_Scan_t;
+
 /**
  * \brief States for CC2530 
  * States for CC2530 main state machine
 */
 typedef enum {
   CC2530BeeState_Normal,
-  CC2530BeeState_ReInitIEEE802154,
+  CC2530BeeState_SetBaudrate,           /*!< Waiting for USART tx buffer to drain before setting new baud rate */
 } CC2530BeeState_t;
 
+/**
+ * States of frame at head of transmit queue, see CC2530Bee_radioTxPoll
+*/
+typedef enum {
+  CC2530BeeRadioTx_Idle,
+  CC2530BeeRadioTx_Backoff,             /*!< Waiting for random backoff to pass before CCA */
+  CC2530BeeRadioTx_WaitAck,             /*!< Frame sent, waiting for ACK */
+} CC2530BeeRadioTxState_t;
+
+/**
+ * Frame at head of transmit queue. Its slot is released once outcome is
+ * known, header is kept in radioTxFrame for retransmissions.
+*/
+typedef struct {
+  CC2530BeeRadioTxState_t state;
+  uint8_t payloadLength;        /*!< Payload of current radio frame */
+  const APIFramePayload_t *data; /*!< Payload of TX request if fragmented */
+  uint16_t length;              /*!< Number of bytes of data */
+  uint8_t numFragments;         /*!< 0 if not fragmented */
+  uint8_t fragmentIndex;        /*!< Fragment currently sent */
+  uint8_t numFrames;            /*!< Number of transmit queue slots sent in this frame, see CC2530Bee_aggregate */
+  uint8_t statusRequired;       /*!< TX status is sent for each frame ID not 0 once outcome is known (API mode) */
+  uint8_t aggregating;          /*!< Waiting for further TX requests since aggregateStart */
+  uint32_t aggregateStart;
+  uint8_t backoffs;             /*!< Number of busy CCAs so far (NB) */
+  uint8_t backoffExponent;      /*!< Current backoff exponent (BE) */
+  uint8_t retries;              /*!< Retransmissions so far */
+  volatile uint8_t ackReceived; /*!< Set by IEEE802154_UserCbk_AckFrameReceived */
+  uint32_t startTime;           /*!< Sleep timer at start of backoff or ACK wait */
+  uint32_t delay;               /*!< Backoff or ACK wait in sleep timer ticks */
+} CC2530Bee_RadioTx_t;
+
 /*******************| Global variables |*******************************/
+extern CC2530Bee_Config_t CC2530Bee_Config;
+extern CC2530Bee_RadioTx_t CC2530Bee_radioTx;
+extern CC2530Bee_Sleep_t CC2530Bee_sleep;
+extern CC2530Bee_Statistics_t CC2530Bee_statistics;
+extern CC2530Bee_Scan_t CC2530Bee_scan;
+extern const __code UARTAPI_ATCommand_t UARTAPI_atCommands[UARTAPI_NUM_ATCOMMANDS];
+extern UARTAPI_RxParser_t UARTAPI_rxParser;
+extern const UARTAPI_Codec_t UARTAPI_codecEscaped;
+extern const UARTAPI_Codec_t *UARTAPI_codec;
 
 /*******************| Function prototypes |****************************/
 
+void CC2530Bee_init(void);
+void CC2530Bee_mainFunction(void);
 void CC2530Bee_loadConfig(CC2530Bee_Config_t *config);
+void CC2530Bee_defaultConfig(CC2530Bee_Config_t *config);
+void CC2530Bee_restoreDefaults(void);
+CC2530Bee_Config_t *CC2530Bee_stageConfig(uint8_t changes);
+void CC2530Bee_applyConfig(void);
+void CC2530Bee_writeConfig(void);
+void CC2530Bee_softwareReset(void);
+
+uint8_t CC2530Bee_radioTransmit(APIFramePayload_t *data, uint16_t length);
+void CC2530Bee_radioTxPoll(void);
+void CC2530Bee_radioTxNeighbour(uint8_t acked);
+void CC2530Bee_radioTxSent(void);
+void CC2530Bee_fragment(void);
+uint8_t CC2530Bee_aggregate(void);
+void CC2530Bee_aggregatePayload(uint8_t numFrames);
+void CC2530Bee_radioTxBackoff(void);
+void CC2530Bee_radioTxFinish(uint8_t status);
+void CC2530Bee_radioTxPurge(void);
+uint8_t CC2530Bee_random(void);
+uint8_t CC2530Bee_deliverRxFrame(RxQueue_Slot_t *slot);
+void CC2530Bee_sendRxPacket(const RxQueue_Source_t *source, const IEEE802154_Payload *payload, uint16_t length);
+void CC2530Bee_reassemble(const RxQueue_Slot_t *slot);
+void CC2530Bee_reassemblyPoll(void);
+uint8_t CC2530Bee_isIdle(void);
+void CC2530Bee_sleepPoll(void);
+void CC2530Bee_enterSleep(uint8_t powerMode);
+void CC2530Bee_sleepFor(uint32_t ticks);
+void CC2530Bee_wakeUp(void);
+void CC2530Bee_clearStatistics(void);
+void CC2530Bee_collectStatistics(void);
+void CC2530Bee_energyScan(void);
+void CC2530Bee_scanPoll(void);
+void CC2530Bee_scanNext(void);
+void CC2530Bee_scanFinish(void);
+void CC2530Bee_transparentReceive(void);
+uint8_t CC2530Bee_transparentHeader(APIFramePayload_t *data);
+uint32_t CC2530Bee_getSleepTimer(void);
+void CC2530Bee_radioInit(void);
+uint32_t CC2530Bee_readSleepTimer(void);
+void CC2530Bee_setBaudrate(USART_Baudrate_t baudrate);
+uint32_t CC2530Bee_getBaudrate(USART_Baudrate_t baudrate);
+uint8_t CC2530Bee_isRemoteAT(const RxQueue_Slot_t *slot);
+void CC2530Bee_remoteATRequest(const RxQueue_Slot_t *slot);
+void CC2530Bee_remoteATPoll(void);
+void CC2530Bee_remoteATQueue(void);
+void CC2530Bee_remoteATSent(void);
 
 uint8_t UARTAPI_receiveFrame(APIFrame_t *frame);
+void UARTAPI_receiveDataEscaped(APIFrame_t *frame);
+void UARTAPI_receiveDataUnescaped(APIFrame_t *frame);
+uint8_t UARTAPI_numBytesInRxBuffer(void);
 void UARTAPI_sentFrame(APIFramePayload_t *data, uint16_t length);
-
-void UARTAPI_readParameter(APIFramePayload_t *data);
-void UARTAPI_setParameter(APIFramePayload_t *data);
+void UARTAPI_sentFrameSegments(const UARTAPI_Segment_t *segments, uint8_t numSegments);
+uint8_t UARTAPI_writeEscaped(const APIFramePayload_t *data, uint16_t length);
+uint8_t UARTAPI_writeUnescaped(const APIFramePayload_t *data, uint16_t length);
+void UARTAPI_setAPIMode(uint8_t apiMode);
+
+void UARTAPI_traceDump(const APIFramePayload_t *data, uint16_t length);
+void UARTAPI_neighbourTable(APIFramePayload_t *data, uint16_t length);
+void UARTAPI_atCommand(APIFramePayload_t *data, uint16_t length);
+const __code UARTAPI_ATCommand_t *UARTAPI_handleATCommand(const APIFramePayload_t *command, uint8_t parameterLength, APIFramePayload_t *response, uint8_t *responseLength);
+void UARTAPI_finishATCommand(const __code UARTAPI_ATCommand_t *command, uint8_t apply);
+void UARTAPI_sendDeferredResponse(uint16_t atCommand, uint8_t frameId, uint8_t status, const APIFramePayload_t *value, uint8_t length);
+const __code UARTAPI_ATCommand_t *UARTAPI_findATCommand(uint16_t atCommand);
+uint8_t UARTAPI_readNeighbour(const APIFramePayload_t *index, uint8_t length, APIFramePayload_t *value, uint8_t *valueLength);
+uint8_t UARTAPI_readParameter(const __code UARTAPI_ATCommand_t *command, APIFramePayload_t *value);
+uint8_t UARTAPI_setParameter(const __code UARTAPI_ATCommand_t *command, const APIFramePayload_t *value, uint8_t length);
 
 #endif
 /** @}*/
\ No newline at end of file
@@ -36,9 +36,100 @@
 
 /**
  * Size for USART Rx and Tx buffer. Thus, twice the size will be allocated in RAM.
+ * Only used until UartDma_init took USART over.
 */
 #define USART_RING_BUFFER_SIZE   32
 
+/**
+ * Size of circular DMA rx buffer in bytes, each byte takes a 16bit word of RAM
+ * (see UartDma.c). Must be a power of two, at most 128.
+*/
+#define UARTDMA_RX_BUFFER_SIZE   128
+
+/**
+ * Size of UART tx ring sent via DMA. Must be a power of two. API frames larger
+ * than this are sent as the ring drains.
+*/
+#define UARTDMA_TX_BUFFER_SIZE   256
+
+/**
+ * Number of frame buffers shared by transmit and receive queue (see
+ * FramePool.c). Each buffer takes UARTAPI_MAX_PAYLOAD_LENGTH bytes of RAM,
+ * thus grows with FRAGMENT_MAX_PAYLOAD_LENGTH. One buffer is reserved for
+ * responses, one is always held by radio to receive into and one by UART
+ * while a frame is received. The others hold queued frames of either
+ * direction.
+*/
+#define FRAMEPOOL_NUM_BUFFERS    6
+
+/**
+ * Most TX request frames which can be queued for radio transmission, frames
+ * are stored in frame pool buffers. Each slot only takes a few bytes of RAM.
+*/
+#define TXQUEUE_NUM_SLOTS        4
+
+/**
+ * Most received radio frames which can be buffered until they are sent via
+ * UART, frames are stored in frame pool buffers. Must be a power of two. Each
+ * slot only takes a few bytes of RAM.
+*/
+#define RXQUEUE_NUM_SLOTS        4
+
+/**
+ * Largest payload of a TX request or RX packet. Payloads which do not fit
+ * into one radio frame are sent as fragments and reassembled by the receiver.
+ * Each frame pool buffer and each reassembly buffer takes about this many
+ * bytes of RAM.
+*/
+#define FRAGMENT_MAX_PAYLOAD_LENGTH 256
+
+/**
+ * Number of fragmented payloads which can be reassembled at the same time,
+ * e.g. from different senders
+*/
+#define REASSEMBLY_NUM_BUFFERS   2
+
+/**
+ * Flash pages reserved for configuration records. Records are appended to
+ * the current page, the other page is erased once it is full. Page 127 holds
+ * the lock bits of CC2530F256 and must not be used.
+*/
+#define CONFIGSTORE_FIRST_PAGE   125
+#define CONFIGSTORE_NUM_PAGES    2
+
+/**
+ * Entries of hot path trace (see Trace.h), each takes 4 bytes of RAM. Must
+ * be a power of two. Trace points are only compiled in if TRACE_ENABLE is
+ * defined, e.g. via compiler options.
+*/
+#define TRACE_NUM_ENTRIES        32
+
+/**
+ * Number of neighbours whose link quality is kept (LQ), each takes about
+ * 30 bytes of RAM. Neighbour table frame is built in a transmit queue slot,
+ * thus 3 + 20 * NEIGHBOUR_NUM_ENTRIES must not exceed UARTAPI_MAX_PAYLOAD_LENGTH.
+*/
+#define NEIGHBOUR_NUM_ENTRIES    8
+
+/**
+ * Entries of duplicate cache (DW), each takes 16 bytes of RAM. Must be a
+ * power of two.
+*/
+#define DUPLICATE_NUM_ENTRIES    16
+
+/**
+ * Bytes of capture records buffered in sniffer mode (SN) until they are sent
+ * via UART, a record takes 8 bytes plus PSDU. Must be a power of two.
+*/
+#define SNIFFER_BUFFER_SIZE      512
+
+/**
+ * Port pins used by sleep modes (SM): SLEEP_RQ input, high requests sleep,
+ * and CTS output, low while host may send via UART
+*/
+#define CC2530BEE_SLEEPRQ_PIN    P0_1
+#define CC2530BEE_CTS_PIN        P0_0
+
 /*******************| Type definitions |*******************************/
 
 /*******************| Type definitions |*******************************/
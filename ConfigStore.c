@@ -0,0 +1,156 @@
+/** @ingroup ConfigStore
+ * @{
+ */
+#include <PlatformTypes.h>
+#include <string.h>
+#include <stddef.h>
+#include "ConfigStore.h"
+
+/*
+ * Configuration is stored as CRC protected records appended to
+ * #CONFIGSTORE_NUM_PAGES flash pages used round-robin. Writing a record never
+ * erases the page it is written to, only once the current page is full the
+ * next one is erased. Thus each page is erased once per
+ * #CONFIGSTORE_RECORDS_PER_PAGE writes. On boot only record headers are read
+ * to find the newest record, records are checked from newest to oldest until
+ * one with valid CRC is found (torn write or interrupted erase).
+ */
+
+/**
+ * Page (0 to CONFIGSTORE_NUM_PAGES-1) new records are appended to
+ */
+static uint8_t ConfigStore_page;
+
+/**
+ * Number of records in ConfigStore_page, free record follows
+ */
+static uint16_t ConfigStore_numRecords;
+
+/**
+ * Sequence of newest record
+ */
+static uint16_t ConfigStore_sequence;
+
+/**
+ * @return Flash address of record
+ */
+static uint32_t ConfigStore_address(uint8_t page, uint16_t record)
+{
+  return (uint32_t)(CONFIGSTORE_FIRST_PAGE + page) * FLASH_PAGE_SIZE + (uint32_t)record * CONFIGSTORE_RECORD_SIZE;
+}
+
+/**
+ * Reads record and checks version and CRC
+ * @return 1 if record is valid
+ */
+static uint8_t ConfigStore_readRecord(uint8_t page, uint16_t record, ConfigStore_Record_t *buffer)
+{
+  Flash_read(ConfigStore_address(page, record), (uint8_t *)buffer, sizeof(ConfigStore_Record_t));
+  return (buffer->version == CONFIGSTORE_VERSION) &&
+         (buffer->config.crc == ConfigStore_crc((uint8_t *)buffer, offsetof(ConfigStore_Record_t, config) + offsetof(CC2530Bee_Config_t, crc)));
+}
+
+/**
+ * Loads newest valid configuration record from flash and prepares appending
+ * of further records. Must be called once on boot before ConfigStore_save.
+ * @param config Configuration to overwrite, left untouched if no valid record exists
+ * @return 1 if a valid record was found, 0 else
+ */
+uint8_t ConfigStore_load(CC2530Bee_Config_t *config)
+{
+  ConfigStore_Record_t record;
+  uint16_t numRecords[CONFIGSTORE_NUM_PAGES];
+  uint16_t lastSequence[CONFIGSTORE_NUM_PAGES];
+  uint8_t page;
+  uint8_t newest = 0;
+  uint8_t i;
+  sint16_t r;
+
+  /* count used records per page reading version and sequence only */
+  for (page=0; page<CONFIGSTORE_NUM_PAGES; page++)
+  {
+    numRecords[page] = 0;
+    while (numRecords[page] < CONFIGSTORE_RECORDS_PER_PAGE)
+    {
+      Flash_read(ConfigStore_address(page, numRecords[page]), (uint8_t *)&record, offsetof(ConfigStore_Record_t, config));
+      if (record.version == CONFIGSTORE_ERASED)
+      {
+        break;
+      }
+      lastSequence[page] = record.sequence;
+      numRecords[page]++;
+    }
+    if ((numRecords[page] > 0) &&
+        ((numRecords[newest] == 0) || ((sint16_t)(lastSequence[page] - lastSequence[newest]) > 0)))
+    {
+      newest = page;
+    }
+  }
+  ConfigStore_page = newest;
+  ConfigStore_numRecords = numRecords[newest];
+  ConfigStore_sequence = (numRecords[newest] > 0) ? lastSequence[newest] : 0;
+
+  /* newest record first, continue with older pages if it is invalid */
+  for (i=0; i<CONFIGSTORE_NUM_PAGES; i++)
+  {
+    page = (newest + CONFIGSTORE_NUM_PAGES - i) % CONFIGSTORE_NUM_PAGES;
+    for (r=(sint16_t)numRecords[page]-1; r>=0; r--)
+    {
+      if (ConfigStore_readRecord(page, (uint16_t)r, &record))
+      {
+        *config = record.config;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+/**
+ * Appends configuration as new record. Erases next page first if current
+ * page is full.
+ * @param config Configuration to store
+ */
+void ConfigStore_save(const CC2530Bee_Config_t *config)
+{
+  union {
+    ConfigStore_Record_t record;
+    uint8_t bytes[CONFIGSTORE_RECORD_SIZE];
+  } buffer;
+  if (ConfigStore_numRecords >= CONFIGSTORE_RECORDS_PER_PAGE)
+  {
+    ConfigStore_page = (ConfigStore_page + 1) % CONFIGSTORE_NUM_PAGES;
+    Flash_erasePage(CONFIGSTORE_FIRST_PAGE + ConfigStore_page);
+    ConfigStore_numRecords = 0;
+  }
+  memset(buffer.bytes, 0xff, sizeof(buffer.bytes));
+  buffer.record.version = CONFIGSTORE_VERSION;
+  buffer.record.sequence = ++ConfigStore_sequence;
+  buffer.record.config = *config;
+  buffer.record.config.crc = ConfigStore_crc(buffer.bytes, offsetof(ConfigStore_Record_t, config) + offsetof(CC2530Bee_Config_t, crc));
+  Flash_write(ConfigStore_address(ConfigStore_page, ConfigStore_numRecords), buffer.bytes, sizeof(buffer.bytes));
+  ConfigStore_numRecords++;
+}
+
+/**
+ * CRC-8 (polynomial 0x07) over data
+ * @param data Pointer to data
+ * @param length Number of bytes of data
+ * @return CRC of data
+ */
+uint8_t ConfigStore_crc(const uint8_t *data, uint16_t length)
+{
+  uint8_t crc = 0;
+  uint8_t bit;
+  while (length--)
+  {
+    crc ^= *data++;
+    for (bit=0; bit<8; bit++)
+    {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/** @}*/
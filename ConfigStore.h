@@ -0,0 +1,56 @@
+/** @ingroup ConfigStore
+ * @{
+ */
+#ifndef CONFIGSTORE_H_
+#define CONFIGSTORE_H_
+
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include <Flash.h>
+#include "Config.h"
+#include "CC2530Bee.h"
+   
+/*******************| Macros |*****************************************/
+/**
+ * Version of record format. Must be changed whenever CC2530Bee_Config_t
+ * changes, records of other versions are ignored.
+*/
+#define CONFIGSTORE_VERSION             (uint8_t)0x07
+
+/**
+ * Value of version byte in erased flash, marks first free record
+*/
+#define CONFIGSTORE_ERASED              (uint8_t)0xff
+
+/**
+ * Size of one record in flash, rounded up to whole flash words
+*/
+#define CONFIGSTORE_RECORD_SIZE         ((sizeof(ConfigStore_Record_t) + FLASH_WORD_SIZE - 1) / FLASH_WORD_SIZE * FLASH_WORD_SIZE)
+
+/**
+ * Number of records per flash page
+*/
+#define CONFIGSTORE_RECORDS_PER_PAGE    (FLASH_PAGE_SIZE / CONFIGSTORE_RECORD_SIZE)
+
+/*******************| Type definitions |*******************************/
+
+/**
+ * \brief Configuration record as stored in flash.
+ * config.crc covers all bytes of the record in front of it.
+ */
+typedef struct {
+  uint8_t version;              /*!< Record format version, #CONFIGSTORE_ERASED if record is unused */
+  uint8_t reserved;
+  uint16_t sequence;            /*!< Incremented with each record, newest record has highest sequence */
+  CC2530Bee_Config_t config;
+} ConfigStore_Record_t;
+
+/*******************| Global variables |*******************************/
+
+/*******************| Function prototypes |****************************/
+uint8_t ConfigStore_load(CC2530Bee_Config_t *config);
+void ConfigStore_save(const CC2530Bee_Config_t *config);
+uint8_t ConfigStore_crc(const uint8_t *data, uint16_t length);
+
+#endif
+/** @}*/
@@ -0,0 +1,129 @@
+/** @ingroup DMA
+ * @{
+ */
+#include <ioCC2530.h>
+#include <PlatformTypes.h>
+#include <board.h>
+#include "DMA.h"
+
+/*
+ * Driver of CC2530 DMA controller. DMA0CFG points to descriptor of channel 0,
+ * DMA1CFG to those of channels 1 to 4 which must follow each other, thus all
+ * descriptors read by DMA controller are kept here. Addresses are 16bit
+ * xdata addresses, SFRs must be given by their xdata mapping (e.g. X_U0DBUF).
+ */
+
+/**
+ * Number of NOPs between arming a channel and triggering it, DMA controller
+ * needs 9 system clocks to load descriptor
+ */
+#define DMA_ARM_DELAY                   (uint8_t)9
+
+/**
+ * \brief Descriptor as read by DMA controller, addresses high byte first
+ */
+typedef struct {
+  uint8_t sourceHigh;
+  uint8_t sourceLow;
+  uint8_t destinationHigh;
+  uint8_t destinationLow;
+  uint8_t lengthHigh;           /*!< VLEN (0, use LEN) and LEN[12:8] */
+  uint8_t lengthLow;
+  uint8_t trigger;              /*!< WORDSIZE, TMODE and TRIG */
+  uint8_t config;               /*!< SRCINC, DESTINC, IRQMASK, M8 and PRIORITY */
+} DMA_HardwareDescriptor_t;
+
+/**
+ * Descriptors of all channels, see above
+ */
+static __xdata DMA_HardwareDescriptor_t DMA_descriptors[DMA_NUM_CHANNELS];
+
+/**
+ * Copies descriptor to the one read by DMA controller and enables DMA
+ * interrupt. Channel must not be armed.
+ * @param channel DMA channel 0 to 4
+ * @param descriptor Transfer of channel
+ */
+void DMA_setDescriptor(uint8_t channel, DMA_Descriptor_t *descriptor)
+{
+  DMA_HardwareDescriptor_t __xdata *hardware = &DMA_descriptors[channel];
+  uint16_t address;
+  address = (uint16_t)descriptor->source;
+  hardware->sourceHigh = HI_UINT16(address);
+  hardware->sourceLow = LO_UINT16(address);
+  address = (uint16_t)descriptor->destination;
+  hardware->destinationHigh = HI_UINT16(address);
+  hardware->destinationLow = LO_UINT16(address);
+  hardware->lengthHigh = HI_UINT16(descriptor->length) & 0x1f;
+  hardware->lengthLow = LO_UINT16(descriptor->length);
+  hardware->trigger = descriptor->trigger;
+  hardware->config = descriptor->config;
+  address = (uint16_t)&DMA_descriptors[0];
+  DMA0CFGH = HI_UINT16(address);
+  DMA0CFGL = LO_UINT16(address);
+  address = (uint16_t)&DMA_descriptors[1];
+  DMA1CFGH = HI_UINT16(address);
+  DMA1CFGL = LO_UINT16(address);
+  DMAIE = 1;
+}
+
+/**
+ * Arms channel, waits until descriptor was loaded so that channel can be
+ * triggered right away
+ */
+void DMA_arm(uint8_t channel)
+{
+  uint8_t i;
+  DMAARM = (uint8_t)(1 << channel);
+  for (i=0; i<DMA_ARM_DELAY; i++)
+  {
+    asm("NOP");
+  }
+}
+
+/**
+ * Triggers one transfer (or block) of armed channel by software
+ */
+void DMA_trigger(uint8_t channel)
+{
+  DMAREQ = (uint8_t)(1 << channel);
+}
+
+/**
+ * Disarms channel, transfer in progress is stopped
+ */
+void DMA_abort(uint8_t channel)
+{
+  DMAARM = (uint8_t)(0x80 | (1 << channel));
+}
+
+/**
+ * @return 1 if channel is armed, i.e. transfers are pending
+ */
+uint8_t DMA_isArmed(uint8_t channel)
+{
+  return (DMAARM >> channel) & 0x01;
+}
+
+/**
+ * DMA interrupt, calls DMA_UserCbk_TransferComplete for each channel whose
+ * block was transferred (only those with DMA_IRQMASK_ENABLE)
+ */
+#pragma vector = DMA_VECTOR
+__interrupt void DMA_isr(void)
+{
+  uint8_t channel;
+  uint8_t mask;
+  DMAIF = 0;
+  for (channel=0; channel<DMA_NUM_CHANNELS; channel++)
+  {
+    mask = (uint8_t)(1 << channel);
+    if ((DMAIRQ & mask) && (DMA_descriptors[channel].config & DMA_IRQMASK_ENABLE))
+    {
+      DMAIRQ = (uint8_t)~mask;
+      DMA_UserCbk_TransferComplete(channel);
+    }
+  }
+}
+
+/** @}*/
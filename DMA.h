@@ -0,0 +1,64 @@
+/** @ingroup DMA
+ * @{
+ */
+#ifndef DMA_H_
+#define DMA_H_
+
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+
+/*******************| Macros |*****************************************/
+#define DMA_NUM_CHANNELS                (uint8_t)5
+
+/* Trigger (TRIG), combined with word size and transfer mode */
+#define DMA_TRIG_NONE                   (uint8_t)0x00
+#define DMA_TRIG_URX0                   (uint8_t)0x0e
+#define DMA_TRIG_UTX0                   (uint8_t)0x0f
+#define DMA_TRIG_FLASH                  (uint8_t)0x12
+#define DMA_TRIG_MASK                   (uint8_t)0x1f
+#define DMA_WORDSIZE_8BIT               (uint8_t)0x00
+#define DMA_WORDSIZE_16BIT              (uint8_t)0x80
+#define DMA_TMODE_SINGLE                (uint8_t)0x00
+#define DMA_TMODE_BLOCK                 (uint8_t)0x20
+#define DMA_TMODE_REPEATED_SINGLE       (uint8_t)0x40
+#define DMA_TMODE_REPEATED_BLOCK        (uint8_t)0x60
+#define DMA_TMODE_MASK                  (uint8_t)0x60
+
+/* Address increment, interrupt and priority (config) */
+#define DMA_SRCINC_0                    (uint8_t)0x00
+#define DMA_SRCINC_1                    (uint8_t)0x40
+#define DMA_DESTINC_0                   (uint8_t)0x00
+#define DMA_DESTINC_1                   (uint8_t)0x10
+#define DMA_IRQMASK_ENABLE              (uint8_t)0x08
+#define DMA_PRIORITY_LOW                (uint8_t)0x00
+#define DMA_PRIORITY_GUARANTEED         (uint8_t)0x01
+#define DMA_PRIORITY_HIGH               (uint8_t)0x02
+
+/*******************| Type definitions |*******************************/
+
+/**
+ * \brief Transfer of one DMA channel.
+ * Copied to the descriptor read by DMA controller by DMA_setDescriptor, thus
+ * it must be set again after it was changed.
+ */
+typedef struct {
+  volatile void __xdata *source;
+  volatile void __xdata *destination;
+  uint16_t length;              /*!< Number of transfers (bytes or words), at most 8191 */
+  uint8_t trigger;              /*!< DMA_WORDSIZE_*, DMA_TMODE_* and DMA_TRIG_* */
+  uint8_t config;               /*!< DMA_SRCINC_*, DMA_DESTINC_*, DMA_IRQMASK_ENABLE and DMA_PRIORITY_* */
+} DMA_Descriptor_t;
+
+/*******************| Global variables |*******************************/
+
+/*******************| Function prototypes |****************************/
+void DMA_setDescriptor(uint8_t channel, DMA_Descriptor_t *descriptor);
+void DMA_arm(uint8_t channel);
+void DMA_trigger(uint8_t channel);
+void DMA_abort(uint8_t channel);
+uint8_t DMA_isArmed(uint8_t channel);
+
+void DMA_UserCbk_TransferComplete(uint8_t channel);
+
+#endif
+/** @}*/
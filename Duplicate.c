@@ -0,0 +1,154 @@
+/** @ingroup Duplicate
+ * @{
+ */
+#include <PlatformTypes.h>
+#include <string.h>
+#include <board.h>
+#include "Duplicate.h"
+
+/*
+ * Retransmissions of a frame whose ACK was lost carry the sequence number of
+ * the first transmission. Source and sequence number of each data frame are
+ * kept for Duplicate_window, so that copies can be dropped before a receive
+ * queue slot is used. Entries are direct-mapped by a hash of source and
+ * sequence number, thus a lookup compares a single entry in interrupt
+ * context. An entry overwritten by another frame only means that a copy is
+ * passed on.
+ */
+
+/**
+ * Cache of data frames received, index see Duplicate_index
+ */
+Duplicate_Entry_t Duplicate_entries[DUPLICATE_NUM_ENTRIES];
+
+/**
+ * Time in sleep timer ticks a frame is kept, 0 disables suppression
+ */
+uint32_t Duplicate_window;
+
+/**
+ * Empties the cache
+ * @param window Time in sleep timer ticks a frame is kept, 0 disables suppression
+ * @note Interrupts must be disabled if radio is running
+ */
+void Duplicate_init(uint32_t window)
+{
+  uint8_t i;
+  for (i=0; i<DUPLICATE_NUM_ENTRIES; i++)
+  {
+    Duplicate_entries[i].addressMode = IEEE802154_FCF_ADDRESS_MODE_NONE;
+  }
+  Duplicate_window = window;
+}
+
+/**
+ * @return Index of entry of frame in Duplicate_entries
+ */
+static uint8_t Duplicate_index(uint8_t addressMode, IEEE802154_ShortAddress_t shortAddress, const uint8_t *extendedAddress,
+                               uint8_t sequenceNumber)
+{
+  uint8_t hash = sequenceNumber;
+  uint8_t i;
+  if (addressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT)
+  {
+    for (i=0; i<sizeof(IEEE802154_ExtendedAddress_t); i++)
+    {
+      hash ^= extendedAddress[i];
+    }
+  }
+  else
+  {
+    hash ^= HI_UINT16(shortAddress) ^ LO_UINT16(shortAddress);
+  }
+  return hash & (DUPLICATE_NUM_ENTRIES - 1);
+}
+
+/**
+ * Checks whether frame was received within Duplicate_window already
+ * @param addressMode Source address mode of frame
+ * @param shortAddress Source address if addressMode is 16bit
+ * @param extendedAddress Source address if addressMode is 64bit
+ * @param sequenceNumber Sequence number of frame
+ * @param now Sleep timer count
+ * @return 1 if frame is a copy and must be dropped
+ * @note To be called from interrupt context only
+ */
+uint8_t Duplicate_check(uint8_t addressMode, IEEE802154_ShortAddress_t shortAddress, const uint8_t *extendedAddress,
+                        uint8_t sequenceNumber, uint32_t now)
+{
+  Duplicate_Entry_t *entry;
+  if ((Duplicate_window == 0) || (addressMode == IEEE802154_FCF_ADDRESS_MODE_NONE))
+  {
+    return 0;
+  }
+  entry = &Duplicate_entries[Duplicate_index(addressMode, shortAddress, extendedAddress, sequenceNumber)];
+  if ((entry->addressMode == addressMode) &&
+      (entry->sequenceNumber == sequenceNumber) &&
+      ((addressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT) ?
+       (memcmp(entry->extendedAddress, extendedAddress, sizeof(IEEE802154_ExtendedAddress_t)) == 0) :
+       (entry->shortAddress == shortAddress)) &&
+      (((now - entry->received) & DUPLICATE_SLEEPTIMER_MASK) < Duplicate_window))
+  {
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * Records frame, so that its copies are dropped by Duplicate_check. Only
+ * called once frame was queued, a frame lost meanwhile is taken again.
+ * @param addressMode Source address mode of frame
+ * @param shortAddress Source address if addressMode is 16bit
+ * @param extendedAddress Source address if addressMode is 64bit
+ * @param sequenceNumber Sequence number of frame
+ * @param now Sleep timer count
+ * @note To be called from interrupt context only
+ */
+void Duplicate_record(uint8_t addressMode, IEEE802154_ShortAddress_t shortAddress, const uint8_t *extendedAddress,
+                      uint8_t sequenceNumber, uint32_t now)
+{
+  Duplicate_Entry_t *entry;
+  if ((Duplicate_window == 0) || (addressMode == IEEE802154_FCF_ADDRESS_MODE_NONE))
+  {
+    return;
+  }
+  entry = &Duplicate_entries[Duplicate_index(addressMode, shortAddress, extendedAddress, sequenceNumber)];
+  entry->addressMode = addressMode;
+  entry->sequenceNumber = sequenceNumber;
+  if (addressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT)
+  {
+    memcpy(entry->extendedAddress, extendedAddress, sizeof(IEEE802154_ExtendedAddress_t));
+  }
+  else
+  {
+    entry->shortAddress = shortAddress;
+  }
+  entry->received = now;
+}
+
+/**
+ * Frees entries older than Duplicate_window, so that a frame received once
+ * the sleep timer wrapped around is not taken as copy. Must be called more
+ * often than sleep timer wraps around. An entry recorded from interrupt after
+ * now was read appears to be almost a full sleep timer period old, entries
+ * older than half the period are therefore kept.
+ * @param now Sleep timer count
+ */
+void Duplicate_poll(uint32_t now)
+{
+  uint32_t age;
+  uint8_t i;
+  for (i=0; i<DUPLICATE_NUM_ENTRIES; i++)
+  {
+    disableAllInterrupt();
+    age = (now - Duplicate_entries[i].received) & DUPLICATE_SLEEPTIMER_MASK;
+    if ((Duplicate_entries[i].addressMode != IEEE802154_FCF_ADDRESS_MODE_NONE) &&
+        (age >= Duplicate_window) && (age <= DUPLICATE_SLEEPTIMER_MASK / 2))
+    {
+      Duplicate_entries[i].addressMode = IEEE802154_FCF_ADDRESS_MODE_NONE;
+    }
+    enableAllInterrupt();
+  }
+}
+
+/** @}*/
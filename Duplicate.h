@@ -0,0 +1,46 @@
+/** @ingroup Duplicate
+ * @{
+ */
+#ifndef DUPLICATE_H_
+#define DUPLICATE_H_
+
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include <IEEE_802.15.4.h>
+#include "Config.h"
+
+/*******************| Macros |*****************************************/
+
+/**
+ * Sleep timer: 24bit count. Entries must expire via Duplicate_poll before
+ * their age wraps around, thus Duplicate_window is less than half of it.
+ */
+#define DUPLICATE_SLEEPTIMER_MASK       (uint32_t)0x00ffffff
+
+/*******************| Type definitions |*******************************/
+
+/**
+ * \brief Data frame received lately
+ */
+typedef struct {
+  uint8_t addressMode;                                  /*!< Source address mode, IEEE802154_FCF_ADDRESS_MODE_NONE if entry is free */
+  uint8_t sequenceNumber;
+  IEEE802154_ShortAddress_t shortAddress;               /*!< Valid if addressMode is 16bit */
+  IEEE802154_ExtendedAddress_t extendedAddress;         /*!< Valid if addressMode is 64bit */
+  uint32_t received;                                    /*!< Sleep timer when frame was received */
+} Duplicate_Entry_t;
+
+/*******************| Global variables |*******************************/
+extern Duplicate_Entry_t Duplicate_entries[DUPLICATE_NUM_ENTRIES];
+extern uint32_t Duplicate_window;
+
+/*******************| Function prototypes |****************************/
+void Duplicate_init(uint32_t window);
+uint8_t Duplicate_check(uint8_t addressMode, IEEE802154_ShortAddress_t shortAddress, const uint8_t *extendedAddress,
+                        uint8_t sequenceNumber, uint32_t now);
+void Duplicate_record(uint8_t addressMode, IEEE802154_ShortAddress_t shortAddress, const uint8_t *extendedAddress,
+                      uint8_t sequenceNumber, uint32_t now);
+void Duplicate_poll(uint32_t now);
+
+#endif
+/** @}*/
@@ -0,0 +1,94 @@
+/** @ingroup Flash
+ * @{
+ */
+#include <ioCC2530.h>
+#include <PlatformTypes.h>
+#include "DMA.h"
+#include "Flash.h"
+
+/*
+ * Driver of CC2530 flash controller. Flash is read through the 32KB xdata
+ * window selected by MEMCTR.XBANK. Words are written by DMA feeding FWDATA
+ * on FLASH trigger once FCTL.WRITE was set, pages are erased via FCTL.ERASE.
+ * CPU stalls while flash is busy, thus both wait for FCTL.BUSY to clear.
+ */
+
+/**
+ * Transfer of FLASH_DMA_CHANNEL, set up per write
+ */
+static DMA_Descriptor_t Flash_descriptor;
+
+/**
+ * Waits until flash controller finished write or erase
+ */
+static void Flash_waitIdle(void)
+{
+  while (FCTL & FLASH_FCTL_BUSY)
+  {
+  }
+}
+
+/**
+ * Copies bytes from flash, may cross bank boundaries
+ * @param address Byte address in flash
+ * @param buffer Buffer to copy to
+ * @param length Number of bytes
+ */
+void Flash_read(uint32_t address, uint8_t *buffer, uint16_t length)
+{
+  uint8_t memctr = MEMCTR;
+  const uint8_t __xdata *window;
+  uint16_t offset;
+  while (length > 0)
+  {
+    MEMCTR = (memctr & ~FLASH_MEMCTR_XBANK_MASK) | (uint8_t)(address / FLASH_XBANK_SIZE);
+    offset = (uint16_t)(address % FLASH_XBANK_SIZE);
+    window = (const uint8_t __xdata *)(FLASH_XBANK_BASE + offset);
+    do {
+      *buffer++ = *window++;
+      address++;
+      length--;
+      offset++;
+    } while ((length > 0) && (offset < FLASH_XBANK_SIZE));
+  }
+  MEMCTR = memctr;
+}
+
+/**
+ * Writes whole words to flash, words must have been erased before
+ * @param address Byte address in flash, multiple of #FLASH_WORD_SIZE
+ * @param data Data to write, must be in RAM
+ * @param length Number of bytes, multiple of #FLASH_WORD_SIZE
+ */
+void Flash_write(uint32_t address, const uint8_t *data, uint16_t length)
+{
+  uint16_t wordAddress = (uint16_t)(address / FLASH_WORD_SIZE);
+  Flash_waitIdle();
+  Flash_descriptor.source = (volatile void __xdata *)data;
+  Flash_descriptor.destination = &FWDATA;
+  Flash_descriptor.length = length;
+  Flash_descriptor.trigger = DMA_WORDSIZE_8BIT | DMA_TMODE_SINGLE | DMA_TRIG_FLASH;
+  Flash_descriptor.config = DMA_SRCINC_1 | DMA_DESTINC_0 | DMA_PRIORITY_HIGH;
+  DMA_setDescriptor(FLASH_DMA_CHANNEL, &Flash_descriptor);
+  DMA_arm(FLASH_DMA_CHANNEL);
+  FADDRL = LO_UINT16(wordAddress);
+  FADDRH = HI_UINT16(wordAddress);
+  FCTL |= FLASH_FCTL_WRITE;
+  Flash_waitIdle();
+}
+
+/**
+ * Erases page, i.e. sets all its bytes to 0xff
+ * @param page Page number 0 to #FLASH_NUM_PAGES - 1
+ */
+void Flash_erasePage(uint8_t page)
+{
+  Flash_waitIdle();
+  /* FADDRH[7:1] select page, FADDR is a word address */
+  FADDRL = 0;
+  FADDRH = (uint8_t)(page << 1);
+  FCTL |= FLASH_FCTL_ERASE;
+  Flash_waitIdle();
+}
+
+/** @}*/
@@ -0,0 +1,56 @@
+/** @ingroup Flash
+ * @{
+ */
+#ifndef FLASH_H_
+#define FLASH_H_
+
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+
+/*******************| Macros |*****************************************/
+/**
+ * Flash page size, smallest erasable unit
+ */
+#define FLASH_PAGE_SIZE                 (uint16_t)2048
+
+/**
+ * Flash word size, smallest writable unit. Each word can only be written
+ * once after page erase.
+ */
+#define FLASH_WORD_SIZE                 (uint8_t)4
+
+/**
+ * Number of flash pages (CC2530F256)
+ */
+#define FLASH_NUM_PAGES                 (uint8_t)128
+
+/**
+ * DMA channel feeding FWDATA, channels 0 and 1 are used by UartDma
+ */
+#define FLASH_DMA_CHANNEL               (uint8_t)2
+
+/**
+ * FCTL: controller busy, write and erase
+ */
+#define FLASH_FCTL_BUSY                 (uint8_t)0x80
+#define FLASH_FCTL_WRITE                (uint8_t)0x02
+#define FLASH_FCTL_ERASE                (uint8_t)0x01
+
+/**
+ * Size of flash bank mapped to xdata at FLASH_XBANK_BASE via MEMCTR.XBANK
+ */
+#define FLASH_XBANK_SIZE                (uint16_t)0x8000
+#define FLASH_XBANK_BASE                (uint16_t)0x8000
+#define FLASH_MEMCTR_XBANK_MASK         (uint8_t)0x07
+
+/*******************| Type definitions |*******************************/
+
+/*******************| Global variables |*******************************/
+
+/*******************| Function prototypes |****************************/
+void Flash_read(uint32_t address, uint8_t *buffer, uint16_t length);
+void Flash_write(uint32_t address, const uint8_t *data, uint16_t length);
+void Flash_erasePage(uint8_t page);
+
+#endif
+/** @}*/
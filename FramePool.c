@@ -0,0 +1,150 @@
+/** @ingroup FramePool
+ * @{
+ */
+#include <ioCC2530.h>
+#include <PlatformTypes.h>
+#include <stddef.h>
+#include "CC2530Bee.h"
+#include "FramePool.h"
+
+/*
+ * Fixed size buffers shared by both directions, so that one RAM budget covers
+ * frames received via UART waiting for radio (transmit queue) and frames
+ * received via radio waiting for UART (receive queue). A frame stays in the
+ * buffer it was received into until it was sent, queues only hold pointers.
+ * A buffer has one owner at a time, it is returned to the pool by the queue
+ * or function which took it. Buffers are taken by radio callbacks in
+ * interrupt context as well as by main loop, thus they are taken and returned
+ * with interrupts disabled. EA is restored afterwards instead of being set, so that interrupts
+ * stay disabled when called from an interrupt or with interrupts disabled.
+ */
+#if (FRAMEPOOL_NUM_BUFFERS < 4)
+#error "FRAMEPOOL_NUM_BUFFERS must leave a buffer for queued frames besides reserved, radio and UART ones"
+#endif
+
+/**
+ * Buffers of pool, too large for internal RAM. Not cleared at startup as
+ * contents only matter once a buffer was taken.
+ */
+static __no_init __xdata uint8_t FramePool_buffers[FRAMEPOOL_NUM_BUFFERS][FRAMEPOOL_BUFFER_SIZE];
+
+/**
+ * 1 if buffer is taken, 0 if buffer is free
+ */
+static uint8_t FramePool_taken[FRAMEPOOL_NUM_BUFFERS];
+
+/**
+ * Number of buffers taken
+ */
+static uint8_t FramePool_used;
+
+/**
+ * Most buffers used at once since init
+ */
+uint8_t FramePool_highWater;
+
+/**
+ * Frees all buffers and resets high-water mark
+ */
+void FramePool_init(void)
+{
+  uint8_t i;
+  for (i=0; i<FRAMEPOOL_NUM_BUFFERS; i++)
+  {
+    FramePool_taken[i] = 0;
+  }
+  FramePool_used = 0;
+  FramePool_highWater = 0;
+}
+
+/**
+ * Takes a free buffer
+ * @param reserve Number of buffers which must stay free
+ * @return buffer, NULL if no more than reserve buffers are free
+ */
+static uint8_t *FramePool_take(uint8_t reserve)
+{
+  uint8_t *buffer = NULL;
+  uint8_t interruptState = EA;
+  uint8_t i;
+  EA = 0;
+  if (FramePool_used + reserve < FRAMEPOOL_NUM_BUFFERS)
+  {
+    for (i=0; FramePool_taken[i] != 0; i++)
+    {
+    }
+    FramePool_taken[i] = 1;
+    FramePool_used++;
+    if (FramePool_used > FramePool_highWater)
+    {
+      FramePool_highWater = FramePool_used;
+    }
+    buffer = FramePool_buffers[i];
+  }
+  EA = interruptState;
+  return buffer;
+}
+
+/**
+ * Takes a buffer for a frame to be queued. #FRAMEPOOL_NUM_RESERVED buffers
+ * are never handed out, so that responses can always be built.
+ * @return buffer of #FRAMEPOOL_BUFFER_SIZE bytes, NULL if pool is exhausted
+ */
+uint8_t *FramePool_alloc(void)
+{
+  return FramePool_take(FRAMEPOOL_NUM_RESERVED);
+}
+
+/**
+ * Takes a buffer for a frame which is built and sent at once, including
+ * reserved ones. FramePool_alloc, the only one used by radio interrupt, always
+ * leaves #FRAMEPOOL_NUM_RESERVED buffers free, so this only fails if more of
+ * these buffers are held at once. Precondition: caller releases the buffer
+ * before it calls this again, then NULL is never returned.
+ * @return buffer of #FRAMEPOOL_BUFFER_SIZE bytes, NULL if precondition is violated
+ */
+uint8_t *FramePool_allocReserved(void)
+{
+  return FramePool_take(0);
+}
+
+/**
+ * @return index of buffer returned by FramePool_alloc
+ */
+static uint8_t FramePool_index(const uint8_t *buffer)
+{
+  return (uint8_t)((uint16_t)(buffer - FramePool_buffers[0]) / FRAMEPOOL_BUFFER_SIZE);
+}
+
+/**
+ * Returns buffer to pool
+ * @param buffer Buffer returned by FramePool_alloc
+ */
+void FramePool_release(const uint8_t *buffer)
+{
+  uint8_t index = FramePool_index(buffer);
+  uint8_t interruptState = EA;
+  EA = 0;
+  FramePool_taken[index] = 0;
+  FramePool_used--;
+  EA = interruptState;
+}
+
+/**
+ * @return number of buffers currently taken
+ */
+uint8_t FramePool_numUsed(void)
+{
+  return FramePool_used;
+}
+
+/**
+ * @return number of buffers FramePool_alloc can still hand out
+ */
+uint8_t FramePool_numAvailable(void)
+{
+  uint8_t used = FramePool_used;
+  return (used + FRAMEPOOL_NUM_RESERVED < FRAMEPOOL_NUM_BUFFERS) ? (uint8_t)(FRAMEPOOL_NUM_BUFFERS - FRAMEPOOL_NUM_RESERVED - used) : 0;
+}
+
+/** @}*/
@@ -0,0 +1,40 @@
+/** @ingroup FramePool
+ * @{
+ */
+#ifndef FRAMEPOOL_H_
+#define FRAMEPOOL_H_
+
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include "Config.h"
+
+/*******************| Macros |*****************************************/
+
+/**
+ * Size of each buffer, TX request with largest payload. Also holds any radio
+ * frame payload (at most IEEE802154_aMaxPHYPacketSize bytes).
+ * @note Expands to UARTAPI_MAX_PAYLOAD_LENGTH of CC2530Bee.h
+ */
+#define FRAMEPOOL_BUFFER_SIZE           UARTAPI_MAX_PAYLOAD_LENGTH
+
+/**
+ * Number of buffers FramePool_alloc leaves for frames built and sent at once
+ * (AT command responses, status frames), see FramePool_allocReserved
+ */
+#define FRAMEPOOL_NUM_RESERVED          (uint8_t)1
+
+/*******************| Type definitions |*******************************/
+
+/*******************| Global variables |*******************************/
+extern uint8_t FramePool_highWater;
+
+/*******************| Function prototypes |****************************/
+void FramePool_init(void);
+uint8_t *FramePool_alloc(void);
+uint8_t *FramePool_allocReserved(void);
+void FramePool_release(const uint8_t *buffer);
+uint8_t FramePool_numUsed(void);
+uint8_t FramePool_numAvailable(void);
+
+#endif
+/** @}*/
@@ -0,0 +1,602 @@
+/** @ingroup HostSim
+ * @{
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ioCC2530.h>
+#include "CC2530Bee.h"
+#include "HostSim.h"
+#include "ConfigStore.h"
+#include "UartDma.h"
+#include "Trace.h"
+
+/**
+ * Default number of frames per benchmark case
+ */
+#define BENCHMARK_DEFAULT_ITERATIONS    100000
+
+/**
+ * Source via which frame of benchmark case is fed to firmware
+ */
+typedef enum {
+  Benchmark_Source_Uart,
+  Benchmark_Source_Radio16Bit,
+  Benchmark_Source_Radio64Bit,
+} Benchmark_Source_t;
+
+/**
+ * One benchmark case. Frames with API identifier of a UART request are fed
+ * via USART, payloads of radio receive cases are injected via radio.
+ */
+typedef struct {
+  const char *name;
+  Benchmark_Source_t source;
+  uint8_t length;
+  uint8_t payload[32];
+} Benchmark_Case_t;
+
+static const Benchmark_Case_t benchmarkCases[] = {
+  { "0x44 Echo test", Benchmark_Source_Uart, 7, { UARTAPI_ECHOTEST, 0x01, 0xff, 0xff, 0x00, 0xaf, 0xfe } },
+  { "0x44 Echo test escaped", Benchmark_Source_Uart, 7, { UARTAPI_ECHOTEST, 0x01, 0x7e, 0x7d, 0x11, 0x13, 0x7e } },
+  { "0x08 AT read CH", Benchmark_Source_Uart, 4, { UARTAPI_ATCOMMAND, 0x01, 0x43, 0x48 } },
+  { "0x08 AT read SL", Benchmark_Source_Uart, 4, { UARTAPI_ATCOMMAND, 0x01, 0x53, 0x4c } },
+  { "0x08 AT write DL", Benchmark_Source_Uart, 8, { UARTAPI_ATCOMMAND, 0x01, 0x44, 0x4c, 0x00, 0x00, 0xaa, 0x55 } },
+  { "0x09 AT queue", Benchmark_Source_Uart, 5, { UARTAPI_ATCOMMAND_QUEUE, 0x01, 0x43, 0x48, 0x19 } },
+  { "0x01 TX 16bit", Benchmark_Source_Uart, 25, { UARTAPI_TRAMSMIT_REQUEST_16BIT, 0x01, 0xee, 0xee, 0x00,
+                                   0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 } },
+  { "0x01 TX 16bit no ACK", Benchmark_Source_Uart, 25, { UARTAPI_TRAMSMIT_REQUEST_16BIT, 0x01, 0xee, 0xee, UARTAPI_TRANSMIT_OPTIONS_DISABLEACK,
+                                   0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 } },
+  { "0x00 TX 64bit", Benchmark_Source_Uart, 31, { UARTAPI_TRAMSMIT_REQUEST_64BIT, 0x01, 0, 0, 0, 0, 0, 0, 0xee, 0xee, 0x00,
+                                   0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 } },
+  { "0x81 RX 16bit (radio)", Benchmark_Source_Radio16Bit, 20, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 } },
+  { "0x80 RX 64bit (radio)", Benchmark_Source_Radio64Bit, 20, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 } },
+};
+
+/**
+ * Share of escapable bytes in percent for UART escape/checksum benchmark
+ */
+static const uint8_t escapeRatios[] = { 0, 10, 100 };
+
+/**
+ * Runs main function until all bytes of USART source were consumed
+ */
+static void Benchmark_runUntilIdle(void)
+{
+  do {
+    CC2530Bee_mainFunction();
+  } while ((HostSim_uartRxPending() > 0) || (UARTAPI_numBytesInRxBuffer() > 0));
+}
+
+/**
+ * Runs one case iterations times.
+ * @return total number of cycles
+ */
+static uint64_t Benchmark_runCase(const Benchmark_Case_t *bc, uint32_t iterations, uint64_t *minCycles, uint64_t *ns)
+{
+  uint8_t frame[2 * sizeof(bc->payload) + 4];
+  uint16_t frameLength = HostSim_encodeFrame(bc->payload, bc->length, frame);
+  IEEE802154_DataFrameHeader_t header;
+  uint64_t total = 0;
+  uint64_t start = HostSim_nanoseconds();
+  *minCycles = UINT64_MAX;
+
+  memset(&header, 0, sizeof(header));
+  header.fcf.frameType = IEEE802154_FCF_FRAME_TYPE_DATA;
+  header.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.destinationPANID = CC2530BEE_Default_PanID;
+  header.destinationAddress.shortAddress = CC2530BEE_Default_ShortAddress;
+  if (bc->source == Benchmark_Source_Radio64Bit)
+  {
+    header.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_64BIT;
+    memset(header.sourceAddress.extendedAdress, 0xee, sizeof(IEEE802154_ExtendedAddress_t));
+  }
+  else
+  {
+    header.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+    header.sourceAddress.shortAddress = 0xeeee;
+  }
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    uint64_t t0, t1;
+    HostSim_uartTxClear();
+    if (bc->source != Benchmark_Source_Uart)
+    {
+      t0 = HostSim_cycles();
+      HostSim_radioReceive(&header, bc->payload, bc->length, HOSTSIM_LOOPBACK_RSSI);
+      CC2530Bee_mainFunction();
+      t1 = HostSim_cycles();
+    }
+    else
+    {
+      HostSim_setUartSource(frame, frameLength);
+      t0 = HostSim_cycles();
+      Benchmark_runUntilIdle();
+      t1 = HostSim_cycles();
+    }
+    total += t1 - t0;
+    if (t1 - t0 < *minCycles)
+    {
+      *minCycles = t1 - t0;
+    }
+  }
+  *ns = HostSim_nanoseconds() - start;
+  return total;
+}
+
+/**
+ * Fills payload such that percent of its bytes need escaping
+ */
+static void Benchmark_fillPayload(uint8_t *payload, uint16_t length, uint8_t percent)
+{
+  static const uint8_t escapable[] = { UARTFrame_Delimiter, UARTFrame_Escape_Character, UARTFrame_XON, UARTFrame_XOFF };
+  for (uint16_t i = 0; i < length; i++)
+  {
+    if ((i * percent) % 100 < percent)
+    {
+      payload[i] = escapable[i % sizeof(escapable)];
+    }
+    else
+    {
+      payload[i] = 0x20 + (i % 0x50);
+    }
+  }
+}
+
+/**
+ * Reference for UARTAPI_writeEscaped: escaping as before the character class
+ * table, four comparisons and one USART write per byte
+ */
+static uint8_t Benchmark_writeReference(const APIFramePayload_t *data, uint16_t length)
+{
+  uint8_t crc = 0;
+  for (uint16_t i = 0; i < length; i++)
+  {
+    if ((data[i] == UARTFrame_Delimiter) || (data[i] == UARTFrame_Escape_Character) || (data[i] == UARTFrame_XON) || (data[i] == UARTFrame_XOFF))
+    {
+      UartDma_putc(UARTFrame_Escape_Character);
+      UartDma_putc(data[i] ^ UARTFrame_Escape_Mask);
+    }
+    else
+    {
+      UartDma_putc(data[i]);
+    }
+    crc += data[i];
+  }
+  return crc;
+}
+
+/**
+ * Reference for UARTAPI_receiveDataEscaped: unescaping as before the
+ * character class table, one byte per call with a comparison per control
+ * character
+ */
+static void Benchmark_receiveDataReference(APIFrame_t *frame)
+{
+  uint8_t c = UARTAPI_rxParser.buffer[UARTAPI_rxParser.bufferIndex++];
+  if (c == UARTFrame_Delimiter)
+  {
+    /* start of new frame, previous one was truncated */
+    frame->header.delimiter = c;
+    UARTAPI_rxParser.state = UARTAPI_RxState_Length0;
+    return;
+  }
+  if (c == UARTFrame_Escape_Character)
+  {
+    UARTAPI_rxParser.escaped = 1;
+    return;
+  }
+  if (UARTAPI_rxParser.escaped)
+  {
+    c ^= UARTFrame_Escape_Mask;
+    UARTAPI_rxParser.escaped = 0;
+  }
+  frame->data[UARTAPI_rxParser.index++] = c;
+  UARTAPI_rxParser.crc += c;
+  if (UARTAPI_rxParser.index == frame->header.length)
+  {
+    UARTAPI_rxParser.state = UARTAPI_RxState_Checksum;
+  }
+}
+
+/**
+ * Codec of per-byte escaping path the table-driven one is compared with. Both
+ * read from and write to the same DMA rings, so only escaping is compared.
+ */
+static const UARTAPI_Codec_t Benchmark_codecReference = { Benchmark_writeReference, Benchmark_receiveDataReference };
+
+/**
+ * Measures cycles per payload byte of UARTAPI_sentFrame (escaping, checksum,
+ * USART writes) and UARTAPI_receiveFrame (unescaping, checksum, USART reads)
+ * with codec for a frame of UARTAPI_MAX_PAYLOAD_LENGTH bytes. Fastest
+ * iteration is used as timer interrupts and other processes on host add noise.
+ */
+static void Benchmark_runEscape(const UARTAPI_Codec_t *codec, uint8_t percent, uint32_t iterations, double *txCyclesPerByte, double *rxCyclesPerByte)
+{
+  APIFramePayload_t payload[UARTAPI_MAX_PAYLOAD_LENGTH];
+  APIFramePayload_t received[UARTAPI_MAX_PAYLOAD_LENGTH];
+  uint8_t frame[2 * UARTAPI_MAX_PAYLOAD_LENGTH + 4];
+  uint16_t frameLength;
+  APIFrame_t rxFrame;
+  uint64_t txMin = UINT64_MAX;
+  uint64_t rxMin = UINT64_MAX;
+
+  Benchmark_fillPayload(payload, sizeof(payload), percent);
+  frameLength = HostSim_encodeFrame(payload, sizeof(payload), frame);
+  rxFrame.data = received;
+  UARTAPI_codec = codec;
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    uint64_t t0, t1;
+    HostSim_uartTxClear();
+    t0 = HostSim_cycles();
+    UARTAPI_sentFrame(payload, sizeof(payload));
+    t1 = HostSim_cycles();
+    if (t1 - t0 < txMin)
+    {
+      txMin = t1 - t0;
+    }
+
+    HostSim_setUartSource(frame, frameLength);
+    t0 = HostSim_cycles();
+    while (UARTAPI_receiveFrame(&rxFrame) == UARTFrame_Incomplete)
+    {
+    }
+    t1 = HostSim_cycles();
+    if (t1 - t0 < rxMin)
+    {
+      rxMin = t1 - t0;
+    }
+  }
+  UARTAPI_codec = &UARTAPI_codecEscaped;
+  *txCyclesPerByte = (double)txMin / sizeof(payload);
+  *rxCyclesPerByte = (double)rxMin / sizeof(payload);
+}
+
+/**
+ * Number of records in flash for config boot benchmark
+ */
+static const uint16_t configRecords[] = { 0, 1, CONFIGSTORE_RECORDS_PER_PAGE, CONFIGSTORE_RECORDS_PER_PAGE + 1 };
+
+/**
+ * Number of WR for flash erase count of config store benchmark
+ */
+#define BENCHMARK_CONFIG_WRITES         1000
+
+/**
+ * Measures cycles and flash bytes read by CC2530Bee_loadConfig (boot) with
+ * numRecords configuration records in flash. Fastest iteration is used.
+ */
+static void Benchmark_runConfigLoad(uint16_t numRecords, uint32_t iterations, uint64_t *minCycles, uint32_t *bytesRead)
+{
+  CC2530Bee_Config_t config;
+  HostSim_flashEraseAll();
+  CC2530Bee_loadConfig(&config);
+  for (uint16_t i = 0; i < numRecords; i++)
+  {
+    ConfigStore_save(&config);
+  }
+  *minCycles = UINT64_MAX;
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    uint64_t t0, t1;
+    HostSim_flashBytesRead = 0;
+    t0 = HostSim_cycles();
+    CC2530Bee_loadConfig(&config);
+    t1 = HostSim_cycles();
+    if (t1 - t0 < *minCycles)
+    {
+      *minCycles = t1 - t0;
+    }
+  }
+  *bytesRead = HostSim_flashBytesRead;
+}
+
+/**
+ * Aggregation windows (AG) in ms for small TX request benchmark
+ */
+static const uint8_t aggregationWindows[] = { 0, 5 };
+
+/**
+ * Payload length of small TX requests
+ */
+#define BENCHMARK_SMALL_PAYLOAD         8
+
+/**
+ * Air time in us per radio frame besides payload: PHY header, MAC header
+ * with 16bit addresses and FCS (17 bytes), CCA (8 symbols), turnaround and
+ * ACK (12 symbols + 11 bytes)
+ */
+#define BENCHMARK_FRAME_OVERHEAD_US     (17 * 32 + 8 * 16 + 12 * 16 + 11 * 32)
+
+/**
+ * Sends small TX requests to the same destination in bursts filling the
+ * transmit queue and reports messages per radio frame and estimated air time
+ * per message.
+ */
+static void Benchmark_runAggregation(uint8_t window, uint32_t iterations, double *messagesPerFrame, double *airtimePerMessage)
+{
+  uint8_t request[UARTAPI_16BITTRANSMIT_DATA + BENCHMARK_SMALL_PAYLOAD] = { UARTAPI_TRAMSMIT_REQUEST_16BIT, 0x01, 0xee, 0xee, 0x00 };
+  static uint8_t stream[TXQUEUE_NUM_SLOTS * (2 * sizeof(request) + 4)];
+  uint16_t n = 0;
+  uint32_t frames = HostSim_radioTxFrames;
+  uint32_t bytes = HostSim_radioTxBytes;
+  uint32_t messages = 0;
+  for (uint8_t i = 0; i < TXQUEUE_NUM_SLOTS; i++)
+  {
+    n += HostSim_encodeFrame(request, sizeof(request), &stream[n]);
+  }
+  CC2530Bee_Config.AggregationWindow = window;
+  while (messages < iterations)
+  {
+    HostSim_uartTxClear();
+    HostSim_setUartSource(stream, n);
+    Benchmark_runUntilIdle();
+    HostSim_advanceTime((uint32_t)window * 1000 + 1000);
+    CC2530Bee_mainFunction();
+    messages += TXQUEUE_NUM_SLOTS;
+  }
+  CC2530Bee_Config.AggregationWindow = CC2530BEE_Default_AggregationWindow;
+  frames = HostSim_radioTxFrames - frames;
+  bytes = HostSim_radioTxBytes - bytes;
+  *messagesPerFrame = (double)messages / frames;
+  *airtimePerMessage = ((double)frames * BENCHMARK_FRAME_OVERHEAD_US + (double)bytes * 32) / messages;
+}
+
+/**
+ * Sleep modes (SM) of sleep benchmark with SP 1 s and ST 10 ms
+ */
+static const struct {
+  const char *name;
+  uint8_t sleepMode;
+} sleepModes[] = {
+  { "SM 0 no sleep", CC2530BEE_SLEEPMODE_NONE },
+  { "SM 1 pin hibernate", CC2530BEE_SLEEPMODE_PIN_HIBERNATE },
+  { "SM 2 pin doze", CC2530BEE_SLEEPMODE_PIN_DOZE },
+  { "SM 4 cyclic", CC2530BEE_SLEEPMODE_CYCLIC },
+  { "SM 5 cyclic, pin wake-up", CC2530BEE_SLEEPMODE_CYCLIC_PIN },
+};
+
+/**
+ * Simulated time of sleep benchmark, interval at which host sends a TX
+ * request and time of one main loop iteration while awake
+ */
+#define BENCHMARK_SLEEP_DURATION_NS     60000000000ull
+#define BENCHMARK_SLEEP_INTERVAL_NS     1337000000ull
+#define BENCHMARK_SLEEP_LOOP_US         100
+
+/**
+ * Host sends a TX request every BENCHMARK_SLEEP_INTERVAL_NS, releasing
+ * SLEEP_RQ before and raising it once the module received the request. Reports
+ * share of time awake, time host waited for module to take first byte and
+ * time from sleep timer wake-up to first byte.
+ */
+static void Benchmark_runSleep(uint8_t sleepMode, double *dutyCycle, double *hostWait, double *wakeToByte)
+{
+  uint8_t request[UARTAPI_16BITTRANSMIT_DATA + BENCHMARK_SMALL_PAYLOAD] = { UARTAPI_TRAMSMIT_REQUEST_16BIT, 0x01, 0xee, 0xee, 0x00 };
+  uint8_t stream[2 * sizeof(request) + 4];
+  uint16_t n = HostSim_encodeFrame(request, sizeof(request), stream);
+  uint64_t start, sendTime;
+  uint64_t sleepNs = HostSim_sleepNs;
+  uint8_t sending = 0;
+  uint8_t wasAsleep = 0;
+  uint32_t requests = 0;
+  uint32_t wakes = 0;
+  uint64_t waitNs = 0;
+  uint64_t wakeNs = 0;
+  CC2530Bee_Config.SleepMode = sleepMode;
+  CC2530Bee_Config.SleepPeriod = 100;
+  CC2530Bee_Config.TimeBeforeSleep = 10;
+  CC2530BEE_SLEEPRQ_PIN = 1;
+  HostSim_uartTxDrain();
+  start = HostSim_time();
+  sendTime = start + BENCHMARK_SLEEP_INTERVAL_NS;
+  while (HostSim_time() - start < BENCHMARK_SLEEP_DURATION_NS)
+  {
+    if (!sending && (HostSim_time() >= sendTime))
+    {
+      HostSim_uartTxClear();
+      HostSim_setUartSource(stream, n);
+      CC2530BEE_SLEEPRQ_PIN = 0;
+      wasAsleep = CC2530Bee_sleep.asleep;
+      sending = 1;
+    }
+    CC2530Bee_mainFunction();
+    if (sending && (HostSim_uartRxPending() < n))
+    {
+      waitNs += HostSim_uartRxFirstNs - sendTime;
+      requests++;
+      if (wasAsleep)
+      {
+        wakeNs += HostSim_uartRxFirstNs - HostSim_wakeNs;
+        wakes++;
+      }
+      CC2530BEE_SLEEPRQ_PIN = 1;
+      sendTime += BENCHMARK_SLEEP_INTERVAL_NS;
+      sending = 0;
+    }
+    HostSim_advanceTime(BENCHMARK_SLEEP_LOOP_US);
+  }
+  *dutyCycle = 100.0 * (1.0 - (double)(HostSim_sleepNs - sleepNs) / (HostSim_time() - start));
+  *hostWait = (double)waitNs / requests / 1000.0;
+  *wakeToByte = wakes ? (double)wakeNs / wakes / 1000.0 : 0.0;
+  CC2530Bee_Config.SleepMode = CC2530BEE_Default_SleepMode;
+  CC2530Bee_Config.SleepPeriod = CC2530BEE_Default_SleepPeriod;
+  CC2530Bee_Config.TimeBeforeSleep = CC2530BEE_Default_TimeBeforeSleep;
+  CC2530BEE_SLEEPRQ_PIN = 0;
+  Benchmark_runUntilIdle();
+  CC2530Bee_mainFunction();
+}
+
+#ifdef TRACE_ENABLE
+/**
+ * Stages of trace benchmark, time from first trace point to next one
+ */
+static const struct {
+  const char *name;
+  uint8_t from;
+  uint8_t to;
+} traceStages[] = {
+  { "UART header->frame", TRACE_UART_HEADER, TRACE_UART_FRAME },
+  { "UART frame->dispatch", TRACE_UART_FRAME, TRACE_DISPATCH },
+  { "dispatch->radio TX start", TRACE_DISPATCH, TRACE_RADIO_TX_START },
+  { "radio TX start->done", TRACE_RADIO_TX_START, TRACE_RADIO_TX_DONE },
+  { "RX callback entry->exit", TRACE_RX_ENTRY, TRACE_RX_EXIT },
+  { "UART emit start->end", TRACE_UART_EMIT_START, TRACE_UART_EMIT_END },
+};
+
+#define BENCHMARK_TRACE_NUM_STAGES      (sizeof(traceStages) / sizeof(traceStages[0]))
+
+static int Benchmark_compareTicks(const void *a, const void *b)
+{
+  return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+/**
+ * Sends TX requests with loopback and no backoff, decodes trace ring after
+ * each of them as a host would decode trace dump frames and reports median,
+ * 99th percentile and maximum of each stage in Timer 1 ticks.
+ * @param ticks Array of iterations ticks per stage, sorted on return
+ */
+static void Benchmark_runTrace(uint32_t iterations, uint16_t (*ticks)[BENCHMARK_TRACE_NUM_STAGES])
+{
+  uint8_t request[UARTAPI_16BITTRANSMIT_DATA + BENCHMARK_SMALL_PAYLOAD] = { UARTAPI_TRAMSMIT_REQUEST_16BIT, 0x01, 0xee, 0xee, 0x00 };
+  uint8_t stream[2 * sizeof(request) + 4];
+  uint16_t n = HostSim_encodeFrame(request, sizeof(request), stream);
+  CC2530Bee_Config.MinBackoffExponent = 0;
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    Trace_release();
+    HostSim_uartTxClear();
+    HostSim_setUartSource(stream, n);
+    Benchmark_runUntilIdle();
+    CC2530Bee_mainFunction();
+    for (uint8_t st = 0; st < BENCHMARK_TRACE_NUM_STAGES; st++)
+    {
+      const Trace_Entry_t *from = NULL;
+      ticks[i][st] = 0;
+      for (uint8_t e = 0; e < Trace_count; e++)
+      {
+        const Trace_Entry_t *entry = &Trace_entries[(Trace_first + e) % TRACE_NUM_ENTRIES];
+        if ((from == NULL) && (entry->point == traceStages[st].from))
+        {
+          from = entry;
+        }
+        else if ((from != NULL) && (entry->point == traceStages[st].to))
+        {
+          ticks[i][st] = (uint16_t)(((entry->timestamp[0] << 8) | entry->timestamp[1]) -
+                                    ((from->timestamp[0] << 8) | from->timestamp[1]));
+          break;
+        }
+      }
+    }
+  }
+  CC2530Bee_Config.MinBackoffExponent = CC2530BEE_Default_MinBackoffExponent;
+  HostSim_uartTxDrain();
+}
+#endif
+
+/**
+ * Reports frames per second and cycles per frame for each benchmark case
+ * followed by cycles per byte of UART escaping/checksum next to per-byte
+ * reference (see Benchmark_codecReference), effect of
+ * aggregation on small TX requests, duty cycle of sleep modes, latency of
+ * traced stages and cost of configuration boot and WR.
+ *
+ * Usage: cc2530bee_bench [iterations]
+ */
+int main(int argc, char *argv[])
+{
+  uint32_t iterations = BENCHMARK_DEFAULT_ITERATIONS;
+  if (argc > 1)
+  {
+    iterations = strtoul(argv[1], NULL, 0);
+  }
+  HostSim_reset();
+  CC2530Bee_init();
+
+  printf("%-26s %12s %14s %12s\n", "API frame", "frames/s", "cycles/frame", "min cycles");
+  for (uint32_t c = 0; c < sizeof(benchmarkCases) / sizeof(benchmarkCases[0]); c++)
+  {
+    uint64_t minCycles, ns;
+    uint64_t total = Benchmark_runCase(&benchmarkCases[c], iterations, &minCycles, &ns);
+    printf("%-26s %12.0f %14.1f %12llu\n", benchmarkCases[c].name,
+           (double)iterations * 1e9 / (double)ns,
+           (double)total / iterations,
+           (unsigned long long)minCycles);
+  }
+
+  printf("\n%-26s %12s %14s %12s %14s\n", "UART escape/checksum", "TX cyc/byte", "RX cyc/byte", "ref TX", "ref RX");
+  for (uint32_t r = 0; r < sizeof(escapeRatios); r++)
+  {
+    double txCyclesPerByte, rxCyclesPerByte;
+    double txReference, rxReference;
+    char name[32];
+    Benchmark_runEscape(&UARTAPI_codecEscaped, escapeRatios[r], iterations, &txCyclesPerByte, &rxCyclesPerByte);
+    Benchmark_runEscape(&Benchmark_codecReference, escapeRatios[r], iterations, &txReference, &rxReference);
+    snprintf(name, sizeof(name), "%u%% escapable bytes", escapeRatios[r]);
+    printf("%-26s %12.2f %14.2f %12.2f %14.2f\n", name, txCyclesPerByte, rxCyclesPerByte, txReference, rxReference);
+  }
+
+  printf("\n%-26s %12s %14s\n", "Small TX requests", "msg/frame", "air us/msg");
+  for (uint32_t w = 0; w < sizeof(aggregationWindows); w++)
+  {
+    double messagesPerFrame, airtimePerMessage;
+    char name[32];
+    Benchmark_runAggregation(aggregationWindows[w], iterations, &messagesPerFrame, &airtimePerMessage);
+    snprintf(name, sizeof(name), "AG %u ms", aggregationWindows[w]);
+    printf("%-26s %12.2f %14.1f\n", name, messagesPerFrame, airtimePerMessage);
+  }
+
+  printf("\n%-26s %12s %14s %12s\n", "Sleep mode", "awake %", "host wait us", "wake->byte us");
+  for (uint32_t m = 0; m < sizeof(sleepModes) / sizeof(sleepModes[0]); m++)
+  {
+    double dutyCycle, hostWait, wakeToByte;
+    Benchmark_runSleep(sleepModes[m].sleepMode, &dutyCycle, &hostWait, &wakeToByte);
+    printf("%-26s %12.2f %14.1f %12.1f\n", sleepModes[m].name, dutyCycle, hostWait, wakeToByte);
+  }
+
+#ifdef TRACE_ENABLE
+  {
+    uint32_t traceIterations = iterations / 10;
+    uint16_t (*ticks)[BENCHMARK_TRACE_NUM_STAGES] = calloc(traceIterations, sizeof(*ticks));
+    uint16_t *stage = calloc(traceIterations, sizeof(uint16_t));
+    Benchmark_runTrace(traceIterations, ticks);
+    printf("\n%-26s %12s %14s %12s\n", "Trace (Timer 1 ticks)", "median", "99th pct", "max");
+    for (uint32_t st = 0; st < BENCHMARK_TRACE_NUM_STAGES; st++)
+    {
+      for (uint32_t i = 0; i < traceIterations; i++)
+      {
+        stage[i] = ticks[i][st];
+      }
+      qsort(stage, traceIterations, sizeof(uint16_t), Benchmark_compareTicks);
+      printf("%-26s %12u %14u %12u\n", traceStages[st].name, stage[traceIterations / 2],
+             stage[traceIterations * 99 / 100], stage[traceIterations - 1]);
+    }
+    free(stage);
+    free(ticks);
+  }
+#endif
+
+  printf("\n%-26s %12s %14s\n", "Config boot", "min cycles", "flash bytes");
+  for (uint32_t r = 0; r < sizeof(configRecords) / sizeof(configRecords[0]); r++)
+  {
+    uint64_t minCycles;
+    uint32_t bytesRead;
+    char name[32];
+    Benchmark_runConfigLoad(configRecords[r], iterations, &minCycles, &bytesRead);
+    snprintf(name, sizeof(name), "%u records in flash", configRecords[r]);
+    printf("%-26s %12llu %14lu\n", name, (unsigned long long)minCycles, (unsigned long)bytesRead);
+  }
+  HostSim_flashEraseAll();
+  CC2530Bee_loadConfig(&CC2530Bee_Config);
+  for (uint32_t i = 0; i < BENCHMARK_CONFIG_WRITES; i++)
+  {
+    ConfigStore_save(&CC2530Bee_Config);
+  }
+  printf("%-26s %12lu %14s\n", "flash erases per 1000 WR", (unsigned long)HostSim_flashEraseCount, "");
+  return EXIT_SUCCESS;
+}
+
+/** @}*/
@@ -0,0 +1,41 @@
+/** @ingroup HostSim
+ * @{
+ */
+#ifndef CC253X_H_
+#define CC253X_H_
+/*
+ * Host stand-in for CC253x/CC253x.h
+ */
+/*******************| Inclusions |*************************************/
+#include <ioCC2530.h>
+#include <PlatformTypes.h>
+   
+/*******************| Macros |*****************************************/
+#define SLEEPSTA_RST_MASK               (uint8_t)0x18
+#define SLEEPSTA_RST_POWERONRESET       (uint8_t)0x00
+#define SLEEPSTA_RST_EXTERNALRESET      (uint8_t)0x08
+#define SLEEPSTA_RST_WATCHDOGRESET      (uint8_t)0x10
+#define SLEEPSTA_RST_CLOCKLOSSRESET     (uint8_t)0x18
+
+#define SLEEPCMD_MODE_IDLE              (uint8_t)0x00
+#define SLEEPCMD_MODE_PM1               (uint8_t)0x01
+#define SLEEPCMD_MODE_PM2               (uint8_t)0x02
+#define SLEEPCMD_MODE_PM3               (uint8_t)0x03
+
+/*******************| Type definitions |*******************************/
+/**
+ * Sleep timer compare value (24bit on target)
+ */
+typedef union {
+  uint32_t value;
+  uint8_t byte[4];
+} sleepTimer_t;
+
+/*******************| Global variables |*******************************/
+
+/*******************| Function prototypes |****************************/
+void CC253x_IncrementSleepTimer(sleepTimer_t increment);
+void CC253x_ActivatePowerMode(uint8_t mode);
+
+#endif
+/** @}*/
@@ -0,0 +1,41 @@
+/** @ingroup HostSim
+ * @{
+ */
+#ifndef FLASH_H_
+#define FLASH_H_
+/*
+ * Host stand-in for Flash.h, the flash driver of the target. Flash of
+ * CC2530F256 is modelled in HostSim.c including write-once words and erase
+ * counting.
+ */
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+   
+/*******************| Macros |*****************************************/
+/**
+ * Flash page size, smallest erasable unit
+ */
+#define FLASH_PAGE_SIZE                 (uint16_t)2048
+
+/**
+ * Flash word size, smallest writable unit. Each word can only be written
+ * once after page erase.
+ */
+#define FLASH_WORD_SIZE                 (uint8_t)4
+
+/**
+ * Number of flash pages (CC2530F256)
+ */
+#define FLASH_NUM_PAGES                 (uint8_t)128
+
+/*******************| Type definitions |*******************************/
+
+/*******************| Global variables |*******************************/
+
+/*******************| Function prototypes |****************************/
+void Flash_read(uint32_t address, uint8_t *buffer, uint16_t length);
+void Flash_write(uint32_t address, const uint8_t *data, uint16_t length);
+void Flash_erasePage(uint8_t page);
+
+#endif
+/** @}*/
@@ -0,0 +1,1245 @@
+/** @ingroup HostSim
+ * @{
+ */
+#include <ioCC2530.h>
+#include <PlatformTypes.h>
+#include <board.h>
+#include <USART.h>
+#include <WatchdogTimer.h>
+#include <IEEE_802.15.4.h>
+#include <CC253x.h>
+#include <Flash.h>
+#include <DMA.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "CC2530Bee.h"
+#include "HostSim.h"
+
+/**
+ * Registers of ioCC2530.h
+ */
+volatile uint8_t SLEEPSTA = SLEEPSTA_RST_POWERONRESET;
+volatile uint8_t T1CTL;
+volatile uint8_t FREQCTRL;
+volatile uint8_t RFST;
+volatile uint8_t RSSISTAT = 0x01;
+volatile uint8_t FRMFILT0 = 0x0d;
+volatile uint8_t FRMCTRL0 = 0x40;
+volatile uint8_t U0DBUF;
+volatile uint8_t URX0IE;
+volatile uint8_t IEN2;
+volatile uint8_t EA;
+volatile uint8_t P0_0;
+volatile uint8_t P0_1;
+volatile uint8_t P0DIR_0;
+volatile uint8_t P0DIR_1;
+volatile uint8_t P0DIR_2;
+volatile uint8_t P0DIR_3;
+volatile uint8_t P0DIR_4;
+volatile uint8_t P0DIR_5;
+
+/**
+ * Chip's own 64bit address. Left zero, same as on modules used by ModuleTests.
+ */
+uint8_t HostSim_extendedAddress[8];
+
+/**
+ * USART rx ring buffer, filled by HostSim_uartPump in place of rx interrupt
+ */
+static uint8_t uartRxRing[USART_RING_BUFFER_SIZE];
+static uint8_t uartRxHead;
+static uint8_t uartRxCount;
+
+/**
+ * Byte source for USART rx, either a memory block or a file descriptor
+ */
+static const uint8_t *uartSourceData;
+static uint32_t uartSourceLength;
+static int uartRxFd = -1;
+static int uartTxFd = -1;
+
+uint8_t HostSim_uartRxEof;
+
+/**
+ * Host sends via USART only while CTS is asserted if set. Time at which first
+ * byte of memory source was received and number of bytes lost while asleep.
+ */
+uint8_t HostSim_uartFlowControl = 1;
+uint64_t HostSim_uartRxFirstNs;
+uint32_t HostSim_uartRxLost;
+static uint8_t uartRxFirstPending;
+uint8_t HostSim_uartTxCapture[HOSTSIM_UART_CAPTURE_SIZE];
+uint32_t HostSim_uartTxLength;
+uint32_t HostSim_uartTxTotal;
+
+USART_Baudrate_t HostSim_uartBaudrate;
+
+/**
+ * U0BAUD (BAUD_M) as set by USART_setBaudrate for 32MHz system clock
+ */
+static uint8_t uartBaudM;
+static const uint8_t uartBaudMTable[] = { 59, 59, 59, 216, 59, 216, 59, 216, 59, 216, 216 };
+
+/**
+ * API mode of frames encoded/decoded by HostSim_encodeFrame/HostSim_decodeFrame
+ * (1: AP=2 with escaping, 0: AP=1)
+ */
+uint8_t HostSim_uartEscaped = 1;
+
+/**
+ * USART tx timing model. Time at which last byte written has left the shift
+ * register and number of baud rate changes while bytes were still pending.
+ */
+static uint64_t uartTxBusyUntilNs;
+static uint64_t uartCharacterTimeNs;
+uint32_t HostSim_uartBaudrateGlitches;
+
+/**
+ * DMA model, see DMA_trigger. Descriptor, armed state and number of transfers
+ * done of each channel, total transfers and transfer complete interrupts.
+ */
+static DMA_Descriptor_t *dmaDescriptor[DMA_NUM_CHANNELS];
+static uint8_t dmaArmed;
+static uint16_t dmaIndex[DMA_NUM_CHANNELS];
+uint32_t HostSim_dmaTransfers;
+uint32_t HostSim_dmaInterrupts;
+static sint8_t HostSim_dmaChannel(uint8_t trigger);
+static uint8_t HostSim_dmaRxBlocked(uint8_t channel);
+static uint16_t HostSim_dmaRxUnread(void);
+static void HostSim_dmaTransfer(uint8_t channel);
+static void HostSim_dmaRxFromSource(uint8_t channel);
+
+/**
+ * Radio model. If HostSim_radioLoopback is set, each frame sent is received
+ * back as if a peer with the same configuration echoed it, and acknowledged if
+ * an ACK was requested and HostSim_radioAutoAck is set. The next
+ * HostSim_radioAckLoss ACKs are lost and the next HostSim_radioCcaBusy CCAs
+ * find the channel busy.
+ */
+uint8_t HostSim_radioLoopback = 1;
+uint8_t HostSim_radioAutoAck = 1;
+uint32_t HostSim_radioAckLoss;
+uint32_t HostSim_radioCcaBusy;
+uint32_t HostSim_radioCrcErrors;
+uint32_t HostSim_radioCcaCount;
+uint32_t HostSim_radioTxFrames;
+uint32_t HostSim_radioTxBytes;
+uint32_t HostSim_radioInitCount;
+IEEE802154_Config_t HostSim_radioConfig;
+
+/**
+ * Energy in dBm on each channel starting at 11 as seen by RSSI register.
+ * RSSISTAT always reports RSSI as valid.
+ */
+sint8_t HostSim_radioEnergy[HOSTSIM_NUM_CHANNELS] = { [0 ... HOSTSIM_NUM_CHANNELS - 1] = HOSTSIM_NOISE_FLOOR };
+
+/**
+ * Time model for sleep timer. If HostSim_realTime is set, sleep timer follows
+ * host clock, else it only advances via HostSim_advanceTime so that module
+ * tests are deterministic.
+ */
+uint8_t HostSim_realTime;
+static uint64_t virtualTimeNs;
+static uint32_t sleepTimerLatch;
+static uint16_t timer1Latch;
+
+/**
+ * Power mode model. CC253x_ActivatePowerMode sleeps until sleep timer compare
+ * set by CC253x_IncrementSleepTimer, then CPU runs again after wake-up time
+ * of power mode. UART is off meanwhile: if host does not honour CTS
+ * (HostSim_uartFlowControl cleared), bytes it sends are lost.
+ */
+static uint64_t sleepTimerCompareNs;
+uint64_t HostSim_sleepNs;
+uint64_t HostSim_wakeNs;
+uint32_t HostSim_wakeups;
+
+/**
+ * Flash model. Contents survive HostSim_reset (like a power cycle) and are
+ * only cleared by HostSim_flashEraseAll. Writes can only clear bits, so
+ * writing a word twice without erase is counted as error.
+ */
+uint8_t HostSim_flash[FLASH_NUM_PAGES * FLASH_PAGE_SIZE];
+uint32_t HostSim_flashEraseCount;
+uint32_t HostSim_flashBytesRead;
+uint32_t HostSim_flashBytesWritten;
+uint32_t HostSim_flashWriteErrors;
+static uint8_t flashInitialized;
+
+/**
+ * Watchdog model. A watchdog reset jumps to HostSim_resetTarget if set.
+ */
+jmp_buf HostSim_resetTarget;
+uint8_t HostSim_resetTargetValid;
+static uint8_t wdtEnabled;
+static uint64_t wdtTimeoutNs;
+static uint64_t wdtLastTrigger;
+
+/**
+ * Resets all models to power-on state. Pending USART rx source is discarded.
+ */
+void HostSim_reset(void)
+{
+  uartRxHead = 0;
+  uartRxCount = 0;
+  uartSourceData = NULL;
+  uartSourceLength = 0;
+  HostSim_uartRxEof = 0;
+  HostSim_uartTxLength = 0;
+  HostSim_uartTxTotal = 0;
+  HostSim_uartBaudrateGlitches = 0;
+  URX0IE = 0;
+  IEN2 = 0;
+  dmaArmed = 0;
+  HostSim_dmaTransfers = 0;
+  HostSim_dmaInterrupts = 0;
+  uartTxBusyUntilNs = 0;
+  uartCharacterTimeNs = 0;
+  HostSim_radioTxFrames = 0;
+  HostSim_radioTxBytes = 0;
+  HostSim_radioInitCount = 0;
+  HostSim_radioCcaCount = 0;
+  HostSim_uartRxLost = 0;
+  HostSim_sleepNs = 0;
+  HostSim_wakeups = 0;
+  virtualTimeNs = 0;
+  wdtEnabled = 0;
+  SLEEPSTA = SLEEPSTA_RST_POWERONRESET;
+}
+
+/**
+ * Moves as many bytes as possible from source to rx ring buffer. Stands in for
+ * USART rx interrupt. While the interrupt is disabled bytes are moved by DMA
+ * channel triggered by URX0 instead, as long as it does not overwrite a byte
+ * firmware has not read yet (see HostSim_dmaRxBlocked).
+ */
+static void HostSim_uartPump(void)
+{
+  sint8_t channel = -1;
+  if ((uartSourceLength == 0) && (uartRxFd < 0))
+  {
+    return;
+  }
+  if (HostSim_uartFlowControl && (CC2530BEE_CTS_PIN != CC2530BEE_CTS_ASSERTED))
+  {
+    return;
+  }
+  if (!URX0IE)
+  {
+    channel = HostSim_dmaChannel(DMA_TRIG_URX0);
+    if (channel < 0)
+    {
+      return;
+    }
+    HostSim_dmaRxFromSource(channel);
+  }
+  while ((channel < 0) ? (uartRxCount < USART_RING_BUFFER_SIZE) : !HostSim_dmaRxBlocked(channel))
+  {
+    uint8_t c;
+    if (uartSourceLength > 0)
+    {
+      c = *uartSourceData++;
+      uartSourceLength--;
+      if (uartRxFirstPending)
+      {
+        HostSim_uartRxFirstNs = HostSim_time();
+        uartRxFirstPending = 0;
+      }
+    }
+    else if (uartRxFd >= 0)
+    {
+      struct pollfd pfd = { uartRxFd, POLLIN, 0 };
+      if (poll(&pfd, 1, 0) <= 0)
+      {
+        break;
+      }
+      if (read(uartRxFd, &c, 1) != 1)
+      {
+        HostSim_uartRxEof = 1;
+        break;
+      }
+    }
+    else
+    {
+      break;
+    }
+    if (channel >= 0)
+    {
+      U0DBUF = c;
+      HostSim_dmaTransfer(channel);
+      continue;
+    }
+    uartRxRing[(uartRxHead + uartRxCount) % USART_RING_BUFFER_SIZE] = c;
+    uartRxCount++;
+  }
+}
+
+/**
+ * Sets memory block to be received via USART. Block must stay valid until all
+ * bytes were received.
+ */
+void HostSim_setUartSource(const uint8_t *data, uint32_t length)
+{
+  uartSourceData = data;
+  uartSourceLength = length;
+  uartRxFirstPending = (length > 0);
+}
+
+/**
+ * Uses file descriptors (e.g. pty or stdin/stdout) for USART rx and tx. Pass -1
+ * to use memory source and HostSim_uartTxCapture instead.
+ */
+void HostSim_setUartFd(int rxFd, int txFd)
+{
+  uartRxFd = rxFd;
+  uartTxFd = txFd;
+}
+
+/**
+ * @return number of bytes not yet read by firmware (rx ring or DMA rx buffer
+ * plus memory source)
+ */
+uint32_t HostSim_uartRxPending(void)
+{
+  return uartRxCount + HostSim_dmaRxUnread() + uartSourceLength;
+}
+
+/**
+ * Waits for USART rx data on file descriptor.
+ * @return 1 if data is available, 0 on timeout or end of file
+ */
+uint8_t HostSim_uartWait(int timeoutMs)
+{
+  struct pollfd pfd = { uartRxFd, POLLIN, 0 };
+  if (HostSim_uartRxPending() > 0)
+  {
+    return 1;
+  }
+  if ((uartRxFd < 0) || HostSim_uartRxEof)
+  {
+    return 0;
+  }
+  return (poll(&pfd, 1, timeoutMs) > 0) ? 1 : 0;
+}
+
+/**
+ * Discards captured USART tx data
+ */
+void HostSim_uartTxClear(void)
+{
+  HostSim_uartTxLength = 0;
+}
+
+/**
+ * Escapes payload (if HostSim_uartEscaped is set) and adds delimiter, length (same byte order as firmware) and
+ * checksum. Out must provide 2 * length + 4 bytes.
+ * @return number of bytes written to out
+ */
+uint16_t HostSim_encodeFrame(const uint8_t *payload, uint16_t length, uint8_t *out)
+{
+  uint16_t n = 0;
+  uint8_t crc = 0;
+  out[n++] = UARTFrame_Delimiter;
+  memcpy(&out[n], &length, sizeof(length));
+  n += sizeof(length);
+  for (uint16_t i = 0; i < length; i++)
+  {
+    uint8_t c = payload[i];
+    if (HostSim_uartEscaped && ((c == UARTFrame_Delimiter) || (c == UARTFrame_Escape_Character) || (c == UARTFrame_XON) || (c == UARTFrame_XOFF)))
+    {
+      out[n++] = UARTFrame_Escape_Character;
+      out[n++] = c ^ UARTFrame_Escape_Mask;
+    }
+    else
+    {
+      out[n++] = c;
+    }
+    crc += c;
+  }
+  out[n++] = 0xff - crc;
+  return n;
+}
+
+/**
+ * Decodes one frame created by UARTAPI_sentFrame.
+ * @param consumed number of bytes of in belonging to frame
+ * @return payload length or 0 if in contains no complete frame with valid checksum
+ */
+uint16_t HostSim_decodeFrame(const uint8_t *in, uint16_t length, uint8_t *payload, uint16_t *consumed)
+{
+  uint16_t n = 3;
+  uint16_t frameLength;
+  uint8_t crc = 0;
+  if ((length < 4) || (in[0] != UARTFrame_Delimiter))
+  {
+    return 0;
+  }
+  memcpy(&frameLength, &in[1], sizeof(frameLength));
+  for (uint16_t i = 0; i < frameLength; i++)
+  {
+    if (n >= length)
+    {
+      return 0;
+    }
+    payload[i] = in[n++];
+    if (HostSim_uartEscaped && (payload[i] == UARTFrame_Escape_Character))
+    {
+      if (n >= length)
+      {
+        return 0;
+      }
+      payload[i] = in[n++] ^ UARTFrame_Escape_Mask;
+    }
+    crc += payload[i];
+  }
+  if ((n >= length) || ((uint8_t)(crc + in[n]) != 0xff))
+  {
+    return 0;
+  }
+  *consumed = n + 1;
+  return frameLength;
+}
+
+/*******************| USART |******************************************/
+
+/**
+ * Enables USART rx and tx interrupts, rx and tx ring buffers are used until
+ * firmware disables them
+ */
+void UART_init(void)
+{
+  uartRxHead = 0;
+  uartRxCount = 0;
+  URX0IE = 1;
+  IEN2 |= 0x04;
+}
+
+/**
+ * @return current time of time model in nanoseconds
+ */
+static uint64_t HostSim_now(void)
+{
+  return HostSim_realTime ? HostSim_nanoseconds() : virtualTimeNs;
+}
+
+/**
+ * Accounts transmission time of bytes written
+ */
+static void HostSim_uartTxBusy(uint32_t numBytes)
+{
+  uint64_t now = HostSim_now();
+  if (uartTxBusyUntilNs < now)
+  {
+    uartTxBusyUntilNs = now;
+  }
+  uartTxBusyUntilNs += numBytes * uartCharacterTimeNs;
+}
+
+/**
+ * Puts bytes on the wire: file descriptor if set, else capture buffer
+ */
+static void HostSim_uartTransmit(const uint8_t *data, uint32_t length)
+{
+  HostSim_uartTxTotal += length;
+  HostSim_uartTxBusy(length);
+  if (uartTxFd >= 0)
+  {
+    while (length > 0)
+    {
+      ssize_t n = write(uartTxFd, data, length);
+      if (n > 0)
+      {
+        data += n;
+        length -= n;
+      }
+    }
+  }
+  else
+  {
+    if (length > HOSTSIM_UART_CAPTURE_SIZE - HostSim_uartTxLength)
+    {
+      length = HOSTSIM_UART_CAPTURE_SIZE - HostSim_uartTxLength;
+    }
+    memcpy(&HostSim_uartTxCapture[HostSim_uartTxLength], data, length);
+    HostSim_uartTxLength += length;
+  }
+}
+
+/**
+ * Advances virtual time until all bytes written via USART were sent
+ */
+void HostSim_uartTxDrain(void)
+{
+  uint64_t now = HostSim_now();
+  if (uartTxBusyUntilNs > now)
+  {
+    virtualTimeNs += uartTxBusyUntilNs - now;
+  }
+}
+
+void USART_setBaudrate(USART_Baudrate_t baudrate)
+{
+  if (USART_numBytesInTxBuffer() > 0)
+  {
+    /* bytes still being sent would be corrupted on target */
+    HostSim_uartBaudrateGlitches++;
+  }
+  HostSim_uartBaudrate = baudrate;
+  uartBaudM = uartBaudMTable[baudrate];
+  uartCharacterTimeNs = CC2530BEE_UART_BITS_PER_CHARACTER * 1000000000ull / CC2530Bee_getBaudrate(baudrate);
+}
+
+/**
+ * @return number of bytes written but not yet completely sent at current
+ * baud rate, including byte in shift register
+ */
+uint8_t USART_numBytesInTxBuffer(void)
+{
+  uint64_t now = HostSim_now();
+  uint64_t numBytes;
+  if (uartTxBusyUntilNs <= now)
+  {
+    return 0;
+  }
+  numBytes = (uartTxBusyUntilNs - now + uartCharacterTimeNs - 1) / uartCharacterTimeNs;
+  return (numBytes > 0xff) ? 0xff : (uint8_t)numBytes;
+}
+
+void USART_setParity(USART_Parity_t parity)
+{
+  (void)parity;
+}
+
+uint8_t USART_numBytesInRxBuffer(void)
+{
+  HostSim_uartPump();
+  return uartRxCount;
+}
+
+/**
+ * Blocking read of one byte. If no more input can arrive the watchdog will
+ * fire, same as on target.
+ */
+void USART_getc(char *c)
+{
+  HostSim_uartPump();
+  while (uartRxCount == 0)
+  {
+    if ((uartRxFd >= 0) && !HostSim_uartRxEof)
+    {
+      struct pollfd pfd = { uartRxFd, POLLIN, 0 };
+      poll(&pfd, 1, 1);
+    }
+    else if (!HostSim_resetTargetValid)
+    {
+      fprintf(stderr, "HostSim: USART_getc blocked without further input\n");
+      exit(EXIT_FAILURE);
+    }
+    HostSim_watchdogCheck();
+    HostSim_uartPump();
+  }
+  *c = uartRxRing[uartRxHead];
+  uartRxHead = (uartRxHead + 1) % USART_RING_BUFFER_SIZE;
+  uartRxCount--;
+}
+
+void USART_read(char *buffer, uint8_t length)
+{
+  HostSim_uartPump();
+  while ((length > 0) && (uartRxCount > 0))
+  {
+    *buffer++ = uartRxRing[uartRxHead];
+    uartRxHead = (uartRxHead + 1) % USART_RING_BUFFER_SIZE;
+    uartRxCount--;
+    length--;
+  }
+  /* remaining bytes blocking, same as on target */
+  while (length--)
+  {
+    USART_getc(buffer++);
+  }
+}
+
+void USART_putc(char c)
+{
+  HostSim_uartTransmit((const uint8_t *)&c, 1);
+}
+
+void USART_write(char const *buffer, uint8_t length)
+{
+  HostSim_uartTransmit((const uint8_t *)buffer, length);
+}
+
+void USART_writeline(char const *line)
+{
+  while (*line)
+  {
+    USART_putc(*line++);
+  }
+  USART_putc('\r');
+  USART_putc('\n');
+}
+
+/**
+ * Reads U0BAUD. DMA transfers of bytes host has sent since last access to
+ * USART are done first, as they would have happened meanwhile on target.
+ */
+uint8_t HostSim_readU0baud(void)
+{
+  HostSim_uartPump();
+  return uartBaudM;
+}
+
+/**
+ * Reads U0CSR: UART mode, receiver enabled and ACTIVE while bytes are still
+ * being sent (see USART_numBytesInTxBuffer)
+ */
+uint8_t HostSim_readU0csr(void)
+{
+  return 0xc0 | ((USART_numBytesInTxBuffer() > 0) ? 0x01 : 0x00);
+}
+
+/*******************| DMA |********************************************/
+
+/*
+ * Only transfers triggered by USART 0 are modelled. A channel triggered by
+ * URX0 transfers each byte HostSim_uartPump takes from the source while the
+ * USART rx interrupt is disabled. A channel triggered by UTX0 transfers its
+ * whole block once started via DMA_trigger, as bytes written to U0DBUF are
+ * put on the wire immediately and only accounted for in the tx timing model
+ * (see USART.h). Word transfers from U0DBUF read U0BAUD as upper byte, which
+ * follows U0DBUF in xdata on target.
+ */
+
+void DMA_setDescriptor(uint8_t channel, DMA_Descriptor_t *descriptor)
+{
+  dmaDescriptor[channel] = descriptor;
+}
+
+void DMA_arm(uint8_t channel)
+{
+  dmaArmed |= (uint8_t)(1 << channel);
+  dmaIndex[channel] = 0;
+}
+
+void DMA_abort(uint8_t channel)
+{
+  dmaArmed &= (uint8_t)~(1 << channel);
+}
+
+uint8_t DMA_isArmed(uint8_t channel)
+{
+  return (dmaArmed >> channel) & 0x01;
+}
+
+/**
+ * Triggers channel as DMAREQ does: one transfer, rest of block in block
+ * modes. A channel triggered by UTX0 sends the rest of its block, as UTX0 is
+ * set again as soon as U0DBUF was written.
+ */
+void DMA_trigger(uint8_t channel)
+{
+  DMA_Descriptor_t *descriptor = dmaDescriptor[channel];
+  uint16_t n;
+  if (!DMA_isArmed(channel))
+  {
+    return;
+  }
+  n = 1;
+  if (((descriptor->trigger & DMA_TRIG_MASK) == DMA_TRIG_UTX0) || (descriptor->trigger & DMA_TMODE_BLOCK))
+  {
+    n = descriptor->length - dmaIndex[channel];
+  }
+  if ((n > 1) && (descriptor->destination == &U0DBUF) && !(descriptor->trigger & DMA_WORDSIZE_16BIT) &&
+      (descriptor->config & DMA_SRCINC_1))
+  {
+    /* all but last byte in one go, so that model does not add to cycles per byte of benchmark */
+    const uint8_t *source = (const uint8_t *)descriptor->source + dmaIndex[channel];
+    HostSim_uartTransmit(source, n - 1);
+    U0DBUF = source[n - 2];
+    dmaIndex[channel] += n - 1;
+    HostSim_dmaTransfers += n - 1;
+    n = 1;
+  }
+  while (n-- > 0)
+  {
+    HostSim_dmaTransfer(channel);
+  }
+}
+
+/**
+ * @return Address of transfer index of a descriptor address
+ */
+static volatile uint8_t *HostSim_dmaAddress(volatile void *address, uint8_t increment, uint16_t index, uint8_t wordSize)
+{
+  return (volatile uint8_t *)address + (increment ? index * wordSize : 0);
+}
+
+/**
+ * Does next transfer of channel. At end of block channel is disarmed unless
+ * in a repeated mode and transfer complete callback is called as from DMA
+ * interrupt if enabled.
+ */
+static void HostSim_dmaTransfer(uint8_t channel)
+{
+  DMA_Descriptor_t *descriptor = dmaDescriptor[channel];
+  uint8_t wordSize = (descriptor->trigger & DMA_WORDSIZE_16BIT) ? 2 : 1;
+  volatile uint8_t *source = HostSim_dmaAddress(descriptor->source, descriptor->config & DMA_SRCINC_1, dmaIndex[channel], wordSize);
+  volatile uint8_t *destination = HostSim_dmaAddress(descriptor->destination, descriptor->config & DMA_DESTINC_1,
+                                                     dmaIndex[channel], wordSize);
+  uint8_t c = source[0];
+  destination[0] = c;
+  if (wordSize == 2)
+  {
+    destination[1] = (source == &U0DBUF) ? uartBaudM : source[1];
+  }
+  if (destination == &U0DBUF)
+  {
+    HostSim_uartTransmit(&c, 1);
+  }
+  HostSim_dmaTransfers++;
+  if (++dmaIndex[channel] == descriptor->length)
+  {
+    dmaIndex[channel] = 0;
+    if ((descriptor->trigger & DMA_TMODE_MASK) < DMA_TMODE_REPEATED_SINGLE)
+    {
+      DMA_abort(channel);
+    }
+    if (descriptor->config & DMA_IRQMASK_ENABLE)
+    {
+      HostSim_dmaInterrupts++;
+      DMA_UserCbk_TransferComplete(channel);
+    }
+  }
+}
+
+/**
+ * @return Armed channel using trigger, -1 if there is none
+ */
+static sint8_t HostSim_dmaChannel(uint8_t trigger)
+{
+  uint8_t channel;
+  for (channel = 0; channel < DMA_NUM_CHANNELS; channel++)
+  {
+    if (DMA_isArmed(channel) && ((dmaDescriptor[channel]->trigger & DMA_TRIG_MASK) == trigger))
+    {
+      return (sint8_t)channel;
+    }
+  }
+  return -1;
+}
+
+/**
+ * Host honours flow control: it does not send a byte which would overwrite a
+ * word whose upper byte is U0BAUD, that is a byte firmware has not read yet.
+ * @return 1 if channel cannot take a byte from USART
+ */
+static uint8_t HostSim_dmaRxBlocked(uint8_t channel)
+{
+  DMA_Descriptor_t *descriptor = dmaDescriptor[channel];
+  if (!DMA_isArmed(channel))
+  {
+    return 1;
+  }
+  if (!(descriptor->trigger & DMA_WORDSIZE_16BIT))
+  {
+    return 0;
+  }
+  return HostSim_dmaAddress(descriptor->destination, descriptor->config & DMA_DESTINC_1, dmaIndex[channel], 2)[1] == uartBaudM;
+}
+
+/**
+ * Moves bytes of memory source to DMA rx buffer in one go, with the same
+ * result as transferring them one by one. Only done for repeated word
+ * transfers without interrupt, everything else is left to HostSim_dmaTransfer.
+ */
+static void HostSim_dmaRxFromSource(uint8_t channel)
+{
+  DMA_Descriptor_t *descriptor = dmaDescriptor[channel];
+  volatile uint8_t *buffer = (volatile uint8_t *)descriptor->destination;
+  uint16_t i = dmaIndex[channel];
+  if ((uartSourceLength == 0) || (descriptor->trigger != (DMA_WORDSIZE_16BIT | DMA_TMODE_REPEATED_SINGLE | DMA_TRIG_URX0)) ||
+      ((descriptor->config & (DMA_SRCINC_1 | DMA_DESTINC_1 | DMA_IRQMASK_ENABLE)) != DMA_DESTINC_1))
+  {
+    return;
+  }
+  if (uartRxFirstPending)
+  {
+    HostSim_uartRxFirstNs = HostSim_time();
+    uartRxFirstPending = 0;
+  }
+  while ((uartSourceLength > 0) && (buffer[2 * i + 1] != uartBaudM))
+  {
+    U0DBUF = *uartSourceData++;
+    uartSourceLength--;
+    buffer[2 * i] = U0DBUF;
+    buffer[2 * i + 1] = uartBaudM;
+    HostSim_dmaTransfers++;
+    if (++i == descriptor->length)
+    {
+      i = 0;
+    }
+  }
+  dmaIndex[channel] = i;
+}
+
+/**
+ * @return Number of words of DMA rx buffer holding a byte not read yet. These
+ * are the words written last, thus counting stops at first word read.
+ */
+static uint16_t HostSim_dmaRxUnread(void)
+{
+  sint8_t channel = URX0IE ? -1 : HostSim_dmaChannel(DMA_TRIG_URX0);
+  DMA_Descriptor_t *descriptor;
+  volatile uint8_t *buffer;
+  uint16_t n = 0;
+  uint16_t i;
+  if (channel < 0)
+  {
+    return 0;
+  }
+  descriptor = dmaDescriptor[channel];
+  if (!(descriptor->trigger & DMA_WORDSIZE_16BIT) || !(descriptor->config & DMA_DESTINC_1))
+  {
+    return 0;
+  }
+  buffer = (volatile uint8_t *)descriptor->destination;
+  i = dmaIndex[channel];
+  while (n < descriptor->length)
+  {
+    i = (i == 0) ? descriptor->length - 1 : i - 1;
+    if (buffer[2 * i + 1] != uartBaudM)
+    {
+      break;
+    }
+    n++;
+  }
+  return n;
+}
+
+/*******************| Radio |******************************************/
+
+void IEEE802154_radioInit(IEEE802154_Config_t *config)
+{
+  HostSim_radioConfig = *config;
+  HostSim_radioInitCount++;
+  /* driver tunes radio to channel and enables frame filtering and automatic ACKs as on target */
+  FREQCTRL = 11 + 5 * (config->Channel - 11);
+  FRMFILT0 = 0x0d;
+  FRMCTRL0 = 0x60;
+}
+
+/**
+ * Sends frame. With loopback enabled frame is received back immediately
+ * followed by ACK. Both callbacks are called as from radio interrupt. The next
+ * HostSim_radioCrcErrors frames are received with CRC error instead.
+ */
+void IEEE802154_radioSentDataFrame(IEEE802154_DataFrameHeader_t *frame, uint8_t payloadLength)
+{
+  HostSim_radioTxFrames++;
+  HostSim_radioTxBytes += payloadLength;
+  if (!HostSim_radioLoopback)
+  {
+    return;
+  }
+  if (HostSim_radioCrcErrors > 0)
+  {
+    /* corrupted frame is neither received nor acknowledged */
+    HostSim_radioCrcErrors--;
+    IEEE802154_UserCbk_CRCError(payloadLength, HOSTSIM_LOOPBACK_RSSI);
+    return;
+  }
+  HostSim_radioReceive(frame, frame->payload, payloadLength, HOSTSIM_LOOPBACK_RSSI);
+  if (HostSim_radioAutoAck && frame->fcf.ackRequired &&
+      !((frame->fcf.destinationAddressMode == IEEE802154_FCF_ADDRESS_MODE_16BIT) &&
+        (frame->destinationAddress.shortAddress == IEEE802154_BROADCAST_ADDRESS_16BIT)))
+  {
+    if (HostSim_radioAckLoss > 0)
+    {
+      HostSim_radioAckLoss--;
+      return;
+    }
+    memset(&IEEE802154_RxDataFrame.fcf, 0, sizeof(IEEE802154_RxDataFrame.fcf));
+    IEEE802154_RxDataFrame.fcf.frameType = IEEE802154_FCF_FRAME_TYPE_ACK;
+    IEEE802154_RxDataFrame.sequenceNumber = frame->sequenceNumber;
+    IEEE802154_UserCbk_AckFrameReceived(0, HOSTSIM_LOOPBACK_RSSI);
+  }
+}
+
+/**
+ * Reads FSMSTAT1. Only CCA bit is modelled, it is cleared while
+ * HostSim_radioCcaBusy is not zero.
+ */
+uint8_t HostSim_readFsmstat1(void)
+{
+  HostSim_radioCcaCount++;
+  if (HostSim_radioCcaBusy > 0)
+  {
+    HostSim_radioCcaBusy--;
+    return 0x00;
+  }
+  return 0x10;
+}
+
+/**
+ * Reads RSSI register: energy of channel FREQCTRL is tuned to (see
+ * HostSim_radioEnergy) minus RSSI offset of CC2530
+ */
+uint8_t HostSim_readRssi(void)
+{
+  uint8_t index = (uint8_t)(FREQCTRL - 11) / 5;
+  if (index >= HOSTSIM_NUM_CHANNELS)
+  {
+    return (uint8_t)(HOSTSIM_NOISE_FLOOR + HOSTSIM_RSSI_OFFSET);
+  }
+  return (uint8_t)(HostSim_radioEnergy[index] + HOSTSIM_RSSI_OFFSET);
+}
+
+/**
+ * Delivers a data frame to firmware as if received via radio. Payload is
+ * copied to buffer IEEE802154_RxDataFrame.payload points to.
+ */
+void HostSim_radioReceive(const IEEE802154_DataFrameHeader_t *header, const uint8_t *payload, uint8_t length, sint8_t rssi)
+{
+  IEEE802154_Payload *rxPayload = IEEE802154_RxDataFrame.payload;
+  IEEE802154_RxDataFrame = *header;
+  IEEE802154_RxDataFrame.payload = rxPayload;
+  memcpy(rxPayload, payload, length);
+  IEEE802154_UserCbk_DataFrameReceived(length, rssi);
+}
+
+/**
+ * Reads address of mode from PSDU
+ * @return Number of bytes read
+ */
+static uint8_t HostSim_parseAddress(const uint8_t *psdu, uint8_t mode, IEEE802154_Address_t *address)
+{
+  if (mode == IEEE802154_FCF_ADDRESS_MODE_64BIT)
+  {
+    memcpy(address->extendedAdress, psdu, sizeof(IEEE802154_ExtendedAddress_t));
+    return sizeof(IEEE802154_ExtendedAddress_t);
+  }
+  if (mode == IEEE802154_FCF_ADDRESS_MODE_16BIT)
+  {
+    address->shortAddress = psdu[0] | (psdu[1] << 8);
+    return sizeof(IEEE802154_ShortAddress_t);
+  }
+  return 0;
+}
+
+/**
+ * Receives a frame given as PSDU without FCS. It is parsed as by the driver
+ * and passed to the callback of its frame type, or to
+ * IEEE802154_UserCbk_CRCError if crcOk is 0. While FRMFILT0.FRM_FILTER_EN is
+ * set, frames whose destination is neither this node nor broadcast and frames
+ * without destination other than beacons and ACKs are dropped as by CC2530.
+ */
+void HostSim_radioReceiveFrame(const uint8_t *psdu, uint8_t length, sint8_t rssi, uint8_t crcOk)
+{
+  IEEE802154_DataFrameHeader_t *frame = &IEEE802154_RxDataFrame;
+  IEEE802154_Payload *rxPayload = frame->payload;
+  uint8_t offset = 3;
+  memset(frame, 0, sizeof(IEEE802154_DataFrameHeader_t));
+  frame->payload = rxPayload;
+  frame->fcf.frameType = psdu[0] & 0x07;
+  frame->fcf.securityEnabled = (psdu[0] >> 3) & 0x01;
+  frame->fcf.framePending = (psdu[0] >> 4) & 0x01;
+  frame->fcf.ackRequired = (psdu[0] >> 5) & 0x01;
+  frame->fcf.panIdCompression = (psdu[0] >> 6) & 0x01;
+  frame->fcf.reserved = ((psdu[0] >> 7) & 0x01) | ((psdu[1] & 0x03) << 1);
+  frame->fcf.destinationAddressMode = (psdu[1] >> 2) & 0x03;
+  frame->fcf.frameVersion = (psdu[1] >> 4) & 0x03;
+  frame->fcf.sourceAddressMode = (psdu[1] >> 6) & 0x03;
+  frame->sequenceNumber = psdu[2];
+  if (frame->fcf.destinationAddressMode != IEEE802154_FCF_ADDRESS_MODE_NONE)
+  {
+    frame->destinationPANID = psdu[offset] | (psdu[offset + 1] << 8);
+    offset += sizeof(IEEE802154_PANIdentifier_t);
+    offset += HostSim_parseAddress(&psdu[offset], frame->fcf.destinationAddressMode, &frame->destinationAddress);
+  }
+  if (frame->fcf.sourceAddressMode != IEEE802154_FCF_ADDRESS_MODE_NONE)
+  {
+    if (frame->fcf.panIdCompression)
+    {
+      frame->sourcePANID = frame->destinationPANID;
+    }
+    else
+    {
+      frame->sourcePANID = psdu[offset] | (psdu[offset + 1] << 8);
+      offset += sizeof(IEEE802154_PANIdentifier_t);
+    }
+    offset += HostSim_parseAddress(&psdu[offset], frame->fcf.sourceAddressMode, &frame->sourceAddress);
+  }
+  if (offset > length)
+  {
+    return;
+  }
+  memcpy(rxPayload, &psdu[offset], length - offset);
+  if ((FRMFILT0 & 0x01) && (frame->fcf.frameType != IEEE802154_FCF_FRAME_TYPE_ACK))
+  {
+    if ((frame->fcf.destinationAddressMode == IEEE802154_FCF_ADDRESS_MODE_NONE) ?
+        (frame->fcf.frameType != IEEE802154_FCF_FRAME_TYPE_BEACON) :
+        (((frame->destinationPANID != HostSim_radioConfig.PanID) && (frame->destinationPANID != IEEE802154_BROADCAST_PAN_ID)) ||
+         ((frame->fcf.destinationAddressMode == IEEE802154_FCF_ADDRESS_MODE_16BIT) ?
+          ((frame->destinationAddress.shortAddress != HostSim_radioConfig.shortAddress) &&
+           (frame->destinationAddress.shortAddress != IEEE802154_BROADCAST_ADDRESS_16BIT)) :
+          (memcmp(frame->destinationAddress.extendedAdress, HostSim_extendedAddress, sizeof(IEEE802154_ExtendedAddress_t)) != 0))))
+    {
+      return;
+    }
+  }
+  if (!crcOk)
+  {
+    IEEE802154_UserCbk_CRCError(length - offset, rssi);
+    return;
+  }
+  switch (frame->fcf.frameType)
+  {
+  case IEEE802154_FCF_FRAME_TYPE_BEACON:
+    IEEE802154_UserCbk_BeaconFrameReceived(length - offset, rssi);
+    break;
+  case IEEE802154_FCF_FRAME_TYPE_DATA:
+    IEEE802154_UserCbk_DataFrameReceived(length - offset, rssi);
+    break;
+  case IEEE802154_FCF_FRAME_TYPE_ACK:
+    IEEE802154_UserCbk_AckFrameReceived(length - offset, rssi);
+    break;
+  case IEEE802154_FCF_FRAME_TYPE_MACCMD:
+    IEEE802154_UserCbk_MACCommandFrameReceived(length - offset, rssi);
+    break;
+  }
+}
+
+/*******************| Watchdog |***************************************/
+
+void WDT_init(uint8_t interval)
+{
+  static const uint64_t timeoutNs[] = { 1000000000ull, 250000000ull, 15625000ull, 1953125ull };
+  wdtTimeoutNs = timeoutNs[interval & 0x03];
+  wdtLastTrigger = HostSim_nanoseconds();
+  wdtEnabled = 1;
+}
+
+void WDT_trigger(void)
+{
+  wdtLastTrigger = HostSim_nanoseconds();
+}
+
+/**
+ * Resets firmware via HostSim_resetTarget if watchdog was not triggered in time
+ */
+void HostSim_watchdogCheck(void)
+{
+  if (wdtEnabled && HostSim_resetTargetValid && (HostSim_nanoseconds() - wdtLastTrigger > wdtTimeoutNs))
+  {
+    wdtEnabled = 0;
+    SLEEPSTA = SLEEPSTA_RST_WATCHDOGRESET;
+    longjmp(HostSim_resetTarget, 1);
+  }
+}
+
+/*******************| Flash |******************************************/
+
+/**
+ * Erases whole flash and clears flash statistics
+ */
+void HostSim_flashEraseAll(void)
+{
+  memset(HostSim_flash, 0xff, sizeof(HostSim_flash));
+  HostSim_flashEraseCount = 0;
+  HostSim_flashBytesRead = 0;
+  HostSim_flashBytesWritten = 0;
+  HostSim_flashWriteErrors = 0;
+  flashInitialized = 1;
+}
+
+void Flash_read(uint32_t address, uint8_t *buffer, uint16_t length)
+{
+  if (!flashInitialized)
+  {
+    HostSim_flashEraseAll();
+  }
+  if (address + length > sizeof(HostSim_flash))
+  {
+    HostSim_flashWriteErrors++;
+    return;
+  }
+  memcpy(buffer, &HostSim_flash[address], length);
+  HostSim_flashBytesRead += length;
+}
+
+void Flash_write(uint32_t address, const uint8_t *data, uint16_t length)
+{
+  if (!flashInitialized)
+  {
+    HostSim_flashEraseAll();
+  }
+  if ((address % FLASH_WORD_SIZE) || (length % FLASH_WORD_SIZE) || (address + length > sizeof(HostSim_flash)))
+  {
+    HostSim_flashWriteErrors++;
+    return;
+  }
+  for (uint16_t i = 0; i < length; i += FLASH_WORD_SIZE)
+  {
+    /* word already written since last erase */
+    if (memcmp(&HostSim_flash[address + i], "\xff\xff\xff\xff", FLASH_WORD_SIZE) != 0)
+    {
+      HostSim_flashWriteErrors++;
+    }
+    for (uint8_t j = 0; j < FLASH_WORD_SIZE; j++)
+    {
+      HostSim_flash[address + i + j] &= data[i + j];
+    }
+  }
+  HostSim_flashBytesWritten += length;
+}
+
+void Flash_erasePage(uint8_t page)
+{
+  if (!flashInitialized)
+  {
+    HostSim_flashEraseAll();
+  }
+  memset(&HostSim_flash[(uint32_t)page * FLASH_PAGE_SIZE], 0xff, FLASH_PAGE_SIZE);
+  HostSim_flashEraseCount++;
+}
+
+/*******************| Board |******************************************/
+
+void Board_init(void)
+{
+}
+
+void ledInit(void)
+{
+}
+
+void ledOn(void)
+{
+}
+
+void ledOff(void)
+{
+}
+
+void nop(void)
+{
+  HostSim_watchdogCheck();
+}
+
+/**
+ * Sets sleep timer compare to current count plus increment
+ */
+void CC253x_IncrementSleepTimer(sleepTimer_t increment)
+{
+  sleepTimerCompareNs = HostSim_time() + (uint64_t)increment.value * 1000000000ull / HOSTSIM_SLEEPTIMER_FREQUENCY;
+}
+
+void CC253x_ActivatePowerMode(uint8_t mode)
+{
+  uint64_t now = HostSim_time();
+  if (mode == SLEEPCMD_MODE_IDLE)
+  {
+    return;
+  }
+  if (!HostSim_uartFlowControl)
+  {
+    /* bytes arriving while UART is off */
+    HostSim_uartRxLost += uartSourceLength;
+    uartSourceLength = 0;
+  }
+  if (sleepTimerCompareNs > now)
+  {
+    HostSim_sleepNs += sleepTimerCompareNs - now;
+    if (HostSim_realTime)
+    {
+      struct timespec ts = { (sleepTimerCompareNs - now) / 1000000000ull, (sleepTimerCompareNs - now) % 1000000000ull };
+      nanosleep(&ts, NULL);
+    }
+    else
+    {
+      virtualTimeNs = sleepTimerCompareNs;
+    }
+  }
+  HostSim_wakeNs = HostSim_time();
+  HostSim_wakeups++;
+  if (!HostSim_realTime)
+  {
+    virtualTimeNs += (mode == SLEEPCMD_MODE_PM1) ? HOSTSIM_WAKEUP_PM1_NS : HOSTSIM_WAKEUP_PM2_NS;
+  }
+}
+
+/*******************| Time |*******************************************/
+
+/**
+ * Reads byte of 24bit sleep timer count. Reading byte 0 latches the count,
+ * same as ST0 on target.
+ */
+uint8_t HostSim_readSleepTimer(uint8_t index)
+{
+  if (index == 0)
+  {
+    uint64_t ns = HostSim_realTime ? HostSim_nanoseconds() : virtualTimeNs;
+    sleepTimerLatch = (uint32_t)(ns * HOSTSIM_SLEEPTIMER_FREQUENCY / 1000000000ull);
+  }
+  return (uint8_t)(sleepTimerLatch >> (8 * index));
+}
+
+/**
+ * Reads byte of 16bit Timer 1 count. Reading byte 0 latches the count, same
+ * as T1CNTL on target. Timer 1 follows host time even if virtual time is
+ * used, so that traces (see Trace.h) show where host CPU time goes. It only
+ * runs once a mode was set in T1CTL.
+ */
+uint8_t HostSim_readTimer1(uint8_t index)
+{
+  if (index == 0)
+  {
+    timer1Latch = (T1CTL & 0x03) ? (uint16_t)(HostSim_nanoseconds() * (HOSTSIM_TIMER1_FREQUENCY / 1000000ull) / 1000ull) : 0;
+  }
+  return (uint8_t)(timer1Latch >> (8 * index));
+}
+
+/**
+ * Advances virtual time seen by sleep timer
+ */
+void HostSim_advanceTime(uint32_t microseconds)
+{
+  virtualTimeNs += (uint64_t)microseconds * 1000ull;
+}
+
+/**
+ * @return current time of time model in nanoseconds
+ */
+uint64_t HostSim_time(void)
+{
+  return HostSim_now();
+}
+
+/**
+ * @return free running cycle counter (time stamp counter on x86)
+ */
+uint64_t HostSim_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return HostSim_nanoseconds();
+#endif
+}
+
+uint64_t HostSim_nanoseconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/** @}*/
@@ -0,0 +1,121 @@
+/** @ingroup HostSim
+ * @{
+ */
+#ifndef HOSTSIM_H_
+#define HOSTSIM_H_
+/*
+ * Port layer to run the CC2530Bee firmware logic on a Linux host. Stands in
+ * for USART, DMA, radio, flash, watchdog and board functions of CC253x,
+ * CC2530Generic and IEEE_802.15.4 modules. main.c is compiled unchanged with
+ * CC2530BEE_HOSTSIM defined, Simulator.c and Benchmark.c provide main().
+ */
+/*******************| Inclusions |*************************************/
+#include <setjmp.h>
+#include <PlatformTypes.h>
+#include <IEEE_802.15.4.h>
+#include <USART.h>
+#include <Flash.h>
+   
+/*******************| Macros |*****************************************/
+/**
+ * Size of buffer to capture bytes sent via USART if no file descriptor is set
+ */
+#define HOSTSIM_UART_CAPTURE_SIZE       4096
+
+/**
+ * RSSI reported for frames received via radio loopback
+ */
+#define HOSTSIM_LOOPBACK_RSSI           (sint8_t)-40
+
+/**
+ * Energy model: number of channels, energy of a channel nobody uses in dBm
+ * and offset of RSSI register value to dBm (datasheet: 73 dB)
+ */
+#define HOSTSIM_NUM_CHANNELS            16
+#define HOSTSIM_NOISE_FLOOR             (sint8_t)-100
+#define HOSTSIM_RSSI_OFFSET             73
+
+/**
+ * Frequency of sleep timer (32kHz crystal)
+ */
+#define HOSTSIM_SLEEPTIMER_FREQUENCY    32768ull
+
+/**
+ * Frequency of Timer 1 (32MHz tick speed, divided by 1)
+ */
+#define HOSTSIM_TIMER1_FREQUENCY        32000000ull
+
+/**
+ * Time from sleep timer event until CPU runs again (datasheet: PM1 4 us, PM2
+ * 0.1 ms plus 0.3 ms 32MHz crystal start-up)
+ */
+#define HOSTSIM_WAKEUP_PM1_NS           4000ull
+#define HOSTSIM_WAKEUP_PM2_NS           400000ull
+
+/*******************| Type definitions |*******************************/
+
+/*******************| Global variables |*******************************/
+extern uint8_t HostSim_uartRxEof;
+extern uint8_t HostSim_uartTxCapture[HOSTSIM_UART_CAPTURE_SIZE];
+extern uint32_t HostSim_uartTxLength;
+extern uint32_t HostSim_uartTxTotal;
+extern uint8_t HostSim_uartEscaped;
+extern uint32_t HostSim_uartBaudrateGlitches;
+extern USART_Baudrate_t HostSim_uartBaudrate;
+extern uint32_t HostSim_dmaTransfers;
+extern uint32_t HostSim_dmaInterrupts;
+
+extern uint8_t HostSim_radioLoopback;
+extern uint8_t HostSim_radioAutoAck;
+extern uint32_t HostSim_radioAckLoss;
+extern uint32_t HostSim_radioCcaBusy;
+extern uint32_t HostSim_radioCrcErrors;
+extern uint32_t HostSim_radioCcaCount;
+extern uint32_t HostSim_radioTxFrames;
+extern uint32_t HostSim_radioTxBytes;
+extern uint32_t HostSim_radioInitCount;
+extern IEEE802154_Config_t HostSim_radioConfig;
+extern sint8_t HostSim_radioEnergy[HOSTSIM_NUM_CHANNELS];
+
+extern uint8_t HostSim_flash[FLASH_NUM_PAGES * FLASH_PAGE_SIZE];
+extern uint32_t HostSim_flashEraseCount;
+extern uint32_t HostSim_flashBytesRead;
+extern uint32_t HostSim_flashBytesWritten;
+extern uint32_t HostSim_flashWriteErrors;
+
+extern uint8_t HostSim_realTime;
+
+extern uint8_t HostSim_uartFlowControl;
+extern uint64_t HostSim_uartRxFirstNs;
+extern uint32_t HostSim_uartRxLost;
+extern uint64_t HostSim_sleepNs;
+extern uint64_t HostSim_wakeNs;
+extern uint32_t HostSim_wakeups;
+
+extern jmp_buf HostSim_resetTarget;
+extern uint8_t HostSim_resetTargetValid;
+
+/*******************| Function prototypes |****************************/
+void HostSim_reset(void);
+
+void HostSim_setUartSource(const uint8_t *data, uint32_t length);
+void HostSim_setUartFd(int rxFd, int txFd);
+uint32_t HostSim_uartRxPending(void);
+uint8_t HostSim_uartWait(int timeoutMs);
+void HostSim_uartTxClear(void);
+void HostSim_uartTxDrain(void);
+uint16_t HostSim_encodeFrame(const uint8_t *payload, uint16_t length, uint8_t *out);
+uint16_t HostSim_decodeFrame(const uint8_t *in, uint16_t length, uint8_t *payload, uint16_t *consumed);
+
+void HostSim_radioReceive(const IEEE802154_DataFrameHeader_t *header, const uint8_t *payload, uint8_t length, sint8_t rssi);
+void HostSim_radioReceiveFrame(const uint8_t *psdu, uint8_t length, sint8_t rssi, uint8_t crcOk);
+
+void HostSim_watchdogCheck(void);
+void HostSim_flashEraseAll(void);
+uint64_t HostSim_cycles(void);
+uint64_t HostSim_nanoseconds(void);
+void HostSim_advanceTime(uint32_t microseconds);
+uint64_t HostSim_time(void);
+
+#endif
+/** @}*/
@@ -0,0 +1,109 @@
+/** @ingroup HostSim
+ * @{
+ */
+#ifndef IEEE_802_15_4_H_
+#define IEEE_802_15_4_H_
+/*
+ * Host stand-in for IEEE_802.15.4/IEEE_802.15.4.h. The radio is modelled in
+ * HostSim.c, see HostSim_radioLoopback.
+ */
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include "Config.h"
+   
+/*******************| Macros |*****************************************/
+#define IEEE802154_FCF_FRAME_TYPE_BEACON                0x00
+#define IEEE802154_FCF_FRAME_TYPE_DATA                  0x01
+#define IEEE802154_FCF_FRAME_TYPE_ACK                   0x02
+#define IEEE802154_FCF_FRAME_TYPE_MACCMD                0x03
+
+#define IEEE802154_FCF_SECURITY_DISABLED                0x00
+#define IEEE802154_FCF_SECURITY_ENABLED                 0x01
+#define IEEE802154_FCF_ACKNOWLEDGE_REQUIRED             0x01
+#define IEEE802154_FCF_ACKNOWLEDGE_NOT_REQUIRED         0x00
+#define IEEE802154_FCF_PANIDCOMPRESSION_DISABLED        0x00
+#define IEEE802154_FCF_PANIDCOMPRESSION_ENABLED         0x01
+
+#define IEEE802154_FCF_ADDRESS_MODE_NONE                0x00
+#define IEEE802154_FCF_ADDRESS_MODE_16BIT               0x02
+#define IEEE802154_FCF_ADDRESS_MODE_64BIT               0x03
+
+#define IEEE802154_BROADCAST_PAN_ID                     (IEEE802154_PANIdentifier_t)0xffff
+#define IEEE802154_BROADCAST_ADDRESS_16BIT              (IEEE802154_ShortAddress_t)0xffff
+
+/**
+ * Maximum length of PSDU and payload (for maximum header size)
+ */
+#define IEEE802154_aMaxPHYPacketSize                    127
+
+/**
+ * Chip's own 64bit address, read from info page on target
+ */
+#define IEEE_EXTENDED_ADDRESS0                          HostSim_extendedAddress[0]
+#define IEEE_EXTENDED_ADDRESS1                          HostSim_extendedAddress[1]
+#define IEEE_EXTENDED_ADDRESS2                          HostSim_extendedAddress[2]
+#define IEEE_EXTENDED_ADDRESS3                          HostSim_extendedAddress[3]
+#define IEEE_EXTENDED_ADDRESS4                          HostSim_extendedAddress[4]
+#define IEEE_EXTENDED_ADDRESS5                          HostSim_extendedAddress[5]
+#define IEEE_EXTENDED_ADDRESS6                          HostSim_extendedAddress[6]
+#define IEEE_EXTENDED_ADDRESS7                          HostSim_extendedAddress[7]
+
+/*******************| Type definitions |*******************************/
+typedef uint16_t IEEE802154_ShortAddress_t;
+typedef uint16_t IEEE802154_PANIdentifier_t;
+typedef uint8_t IEEE802154_ExtendedAddress_t[8];
+typedef uint8_t IEEE802154_Payload;
+
+typedef struct {
+  uint8_t frameType : 3;
+  uint8_t securityEnabled : 1;
+  uint8_t framePending : 1;
+  uint8_t ackRequired : 1;
+  uint8_t panIdCompression : 1;
+  uint8_t reserved : 3;
+  uint8_t destinationAddressMode : 2;
+  uint8_t frameVersion : 2;
+  uint8_t sourceAddressMode : 2;
+} IEEE802154_FCF_t;
+
+/**
+ * Short and extended address are stored side by side, fcf address mode tells
+ * which one is valid.
+ */
+typedef struct {
+  IEEE802154_ShortAddress_t shortAddress;
+  IEEE802154_ExtendedAddress_t extendedAdress;
+} IEEE802154_Address_t;
+
+typedef struct {
+  IEEE802154_FCF_t fcf;
+  uint8_t sequenceNumber;
+  IEEE802154_PANIdentifier_t destinationPANID;
+  IEEE802154_Address_t destinationAddress;
+  IEEE802154_PANIdentifier_t sourcePANID;
+  IEEE802154_Address_t sourceAddress;
+  IEEE802154_Payload *payload;
+} IEEE802154_DataFrameHeader_t;
+
+typedef struct {
+  uint8_t Channel;
+  IEEE802154_PANIdentifier_t PanID;
+  IEEE802154_ShortAddress_t shortAddress;
+} IEEE802154_Config_t;
+
+/*******************| Global variables |*******************************/
+extern IEEE802154_DataFrameHeader_t IEEE802154_RxDataFrame;
+extern uint8_t HostSim_extendedAddress[8];
+
+/*******************| Function prototypes |****************************/
+void IEEE802154_radioInit(IEEE802154_Config_t *config);
+void IEEE802154_radioSentDataFrame(IEEE802154_DataFrameHeader_t *frame, uint8_t payloadLength);
+
+void IEEE802154_UserCbk_BeaconFrameReceived(uint8_t payloadLength, sint8_t rssi);
+void IEEE802154_UserCbk_DataFrameReceived(uint8_t payloadLength, sint8_t rssi);
+void IEEE802154_UserCbk_AckFrameReceived(uint8_t payloadLength, sint8_t rssi);
+void IEEE802154_UserCbk_MACCommandFrameReceived(uint8_t payloadLength, sint8_t rssi);
+void IEEE802154_UserCbk_CRCError(uint8_t payloadLength, sint8_t rssi);
+
+#endif
+/** @}*/
@@ -0,0 +1,38 @@
+/** @ingroup HostSim
+ * @{
+ */
+#ifndef PLATFORMTYPES_H_
+#define PLATFORMTYPES_H_
+/*
+ * Host stand-in for CC253x/PlatformTypes.h. Only provides what is needed to
+ * build the CC2530Bee firmware logic on a Linux host.
+ */
+/*******************| Inclusions |*************************************/
+#include <stdint.h>
+   
+/*******************| Macros |*****************************************/
+/* Keywords of IAR 8051 compiler which have no meaning on host */
+#define __xdata
+#define __data
+#define __code
+#define __near_func
+#define __no_init
+
+/**
+ * Byte swap of 16bit value. Expression only (no assignment), same as on target.
+ */
+#define SWAP_UINT16(x)  ((uint16_t)((((x) >> 8) & 0xff) | (((x) << 8) & 0xff00)))
+#define HI_UINT16(a)    (((a) >> 8) & 0xff)
+#define LO_UINT16(a)    ((a) & 0xff)
+   
+/*******************| Type definitions |*******************************/
+typedef int8_t sint8_t;
+typedef int16_t sint16_t;
+typedef int32_t sint32_t;
+
+/*******************| Global variables |*******************************/
+
+/*******************| Function prototypes |****************************/
+
+#endif
+/** @}*/
@@ -0,0 +1,95 @@
+/** @ingroup HostSim
+ * @{
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include "CC2530Bee.h"
+#include "HostSim.h"
+
+/**
+ * Runs CC2530Bee firmware on host. USART is connected either to stdin/stdout
+ * or to a newly created pseudo terminal whose name is printed on start-up, so
+ * that ModuleTests/BaseTest.py can be pointed to it.
+ *
+ * Usage: cc2530bee_sim [-p] [-n] [-a]
+ *   -p  use pseudo terminal instead of stdin/stdout
+ *   -n  disable radio loopback
+ *   -a  disable automatic ACK for loopback frames
+ */
+int main(int argc, char *argv[])
+{
+  int opt;
+  int usePty = 0;
+  int rxFd = STDIN_FILENO;
+  int txFd = STDOUT_FILENO;
+  while ((opt = getopt(argc, argv, "pna")) != -1)
+  {
+    switch (opt)
+    {
+    case 'p':
+      usePty = 1;
+      break;
+    case 'n':
+      HostSim_radioLoopback = 0;
+      break;
+    case 'a':
+      HostSim_radioAutoAck = 0;
+      break;
+    default:
+      fprintf(stderr, "Usage: %s [-p] [-n] [-a]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (usePty)
+  {
+    struct termios tio;
+    rxFd = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((rxFd < 0) || (grantpt(rxFd) != 0) || (unlockpt(rxFd) != 0))
+    {
+      perror("posix_openpt");
+      return EXIT_FAILURE;
+    }
+    tcgetattr(rxFd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(rxFd, TCSANOW, &tio);
+    txFd = rxFd;
+    /* keep slave side open so that master does not see hang-up between test runs */
+    if (open(ptsname(rxFd), O_RDWR | O_NOCTTY) < 0)
+    {
+      perror("open");
+      return EXIT_FAILURE;
+    }
+    printf("%s\n", ptsname(rxFd));
+    fflush(stdout);
+  }
+  HostSim_reset();
+  HostSim_realTime = 1;
+  HostSim_setUartFd(rxFd, txFd);
+
+  /* watchdog reset restarts firmware from here */
+  setjmp(HostSim_resetTarget);
+  HostSim_resetTargetValid = 1;
+  CC2530Bee_init();
+  while (1)
+  {
+    CC2530Bee_mainFunction();
+    if (UARTAPI_numBytesInRxBuffer() > 0)
+    {
+      /* further frames already read from USART */
+      continue;
+    }
+    if (!HostSim_uartWait(10) && HostSim_uartRxEof)
+    {
+      /* end of input on stdin and everything processed */
+      break;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/** @}*/
@@ -0,0 +1,273 @@
+/** @ingroup HostSim
+ * @{
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include "Sniffer.h"
+
+/**
+ * Converts capture records written by the firmware in sniffer mode (SN 1,
+ * see Sniffer.h) to pcap with link type IEEE 802.15.4 including FCS. The
+ * radio does not pass the FCS on, it is recalculated: frames received with
+ * CRC error get the complement, so that they show up as bad FCS. Bytes
+ * between records, e.g. AT command responses, are skipped.
+ *
+ * Usage: cc2530bee_pcap [-b baudrate] [input [output]]
+ *   input   serial port or file with records, stdin if missing or "-"
+ *   output  pcap file, stdout if missing or "-", e.g. piped to wireshark -k -i -
+ *   -b      baud rate if input is a serial port (default 230400, BD 8)
+ */
+
+#define PCAP_MAGIC                      0xa1b2c3d4
+#define PCAP_LINKTYPE_IEEE802_15_4      195
+#define PCAP_SNAPLEN                    256
+
+/**
+ * Sleep timer frequency and range of record timestamps
+ */
+#define SNIFFERPCAP_TICKS_PER_SECOND    32768
+#define SNIFFERPCAP_TIMESTAMP_RANGE     0x1000000ull
+
+#define SNIFFERPCAP_READ_SIZE           65536
+
+/**
+ * State of conversion. Timestamps are unwrapped assuming at least one record
+ * every 512 s.
+ */
+typedef struct {
+  FILE *out;
+  struct timeval start;         /* wall clock at first record */
+  uint64_t firstTicks;
+  uint64_t ticks;               /* unwrapped timestamp of last record */
+  uint32_t lastTimestamp;
+  int haveFirst;
+  uint64_t records;
+  uint64_t crcErrors;
+  uint64_t skippedBytes;
+} SnifferPcap_t;
+
+static void put32(uint8_t *out, uint32_t value)
+{
+  out[0] = (uint8_t)value;
+  out[1] = (uint8_t)(value >> 8);
+  out[2] = (uint8_t)(value >> 16);
+  out[3] = (uint8_t)(value >> 24);
+}
+
+static void put16(uint8_t *out, uint16_t value)
+{
+  out[0] = (uint8_t)value;
+  out[1] = (uint8_t)(value >> 8);
+}
+
+/**
+ * FCS of IEEE 802.15.4 (CRC-16 ITU-T, LSB first, initial value 0)
+ */
+static uint16_t fcs(const uint8_t *data, uint8_t length)
+{
+  uint16_t crc = 0;
+  while (length--)
+  {
+    crc ^= *data++;
+    for (int i = 0; i < 8; i++)
+    {
+      crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+    }
+  }
+  return crc;
+}
+
+static void writeHeader(FILE *out)
+{
+  uint8_t header[24];
+  put32(&header[0], PCAP_MAGIC);
+  put16(&header[4], 2);
+  put16(&header[6], 4);
+  put32(&header[8], 0);
+  put32(&header[12], 0);
+  put32(&header[16], PCAP_SNAPLEN);
+  put32(&header[20], PCAP_LINKTYPE_IEEE802_15_4);
+  fwrite(header, sizeof(header), 1, out);
+}
+
+/**
+ * Writes record as pcap packet
+ * @param record Record starting at marker, checksum was verified
+ */
+static void writeRecord(SnifferPcap_t *pcap, const uint8_t *record)
+{
+  uint8_t header[16];
+  uint8_t crcOk = record[SNIFFER_RECORD_LENGTH] & SNIFFER_LENGTH_CRC_OK;
+  uint8_t length = record[SNIFFER_RECORD_LENGTH] & SNIFFER_LENGTH_MASK;
+  uint8_t fcsBytes[2];
+  uint32_t timestamp = record[SNIFFER_RECORD_TIMESTAMP] | (record[SNIFFER_RECORD_TIMESTAMP + 1] << 8) |
+                       ((uint32_t)record[SNIFFER_RECORD_TIMESTAMP + 2] << 16);
+  uint64_t offsetUs;
+  uint64_t us;
+  uint16_t crc = fcs(&record[SNIFFER_RECORD_PSDU], length);
+  if (!pcap->haveFirst)
+  {
+    gettimeofday(&pcap->start, NULL);
+    pcap->firstTicks = timestamp;
+    pcap->ticks = timestamp;
+    pcap->haveFirst = 1;
+  }
+  else
+  {
+    pcap->ticks += (timestamp - pcap->lastTimestamp) & (SNIFFERPCAP_TIMESTAMP_RANGE - 1);
+  }
+  pcap->lastTimestamp = timestamp;
+  offsetUs = (pcap->ticks - pcap->firstTicks) * 1000000ull / SNIFFERPCAP_TICKS_PER_SECOND;
+  us = (uint64_t)pcap->start.tv_sec * 1000000ull + pcap->start.tv_usec + offsetUs;
+  if (!crcOk)
+  {
+    crc = ~crc;
+    pcap->crcErrors++;
+  }
+  put16(fcsBytes, crc);
+  put32(&header[0], (uint32_t)(us / 1000000ull));
+  put32(&header[4], (uint32_t)(us % 1000000ull));
+  put32(&header[8], length + sizeof(fcsBytes));
+  put32(&header[12], length + sizeof(fcsBytes));
+  fwrite(header, sizeof(header), 1, pcap->out);
+  fwrite(&record[SNIFFER_RECORD_PSDU], length, 1, pcap->out);
+  fwrite(fcsBytes, sizeof(fcsBytes), 1, pcap->out);
+  pcap->records++;
+}
+
+/**
+ * Converts all complete records in data
+ * @return Number of bytes consumed, the rest may be the start of a record
+ */
+static size_t convert(SnifferPcap_t *pcap, const uint8_t *data, size_t length)
+{
+  size_t offset = 0;
+  while (offset < length)
+  {
+    const uint8_t *record = &data[offset];
+    size_t recordLength;
+    uint8_t sum = 0;
+    if (record[0] != SNIFFER_RECORD_MARKER)
+    {
+      offset++;
+      pcap->skippedBytes++;
+      continue;
+    }
+    if (length - offset < SNIFFER_RECORD_OVERHEAD)
+    {
+      break;
+    }
+    recordLength = SNIFFER_RECORD_OVERHEAD + (record[SNIFFER_RECORD_LENGTH] & SNIFFER_LENGTH_MASK);
+    if (length - offset < recordLength)
+    {
+      break;
+    }
+    for (size_t i = 1; i < recordLength; i++)
+    {
+      sum += record[i];
+    }
+    if (sum != 0xff)
+    {
+      /* marker value within other bytes, resynchronize */
+      offset++;
+      pcap->skippedBytes++;
+      continue;
+    }
+    writeRecord(pcap, record);
+    offset += recordLength;
+  }
+  return offset;
+}
+
+static speed_t baudrate(long bps)
+{
+  switch (bps)
+  {
+  case 9600: return B9600;
+  case 19200: return B19200;
+  case 38400: return B38400;
+  case 57600: return B57600;
+  case 115200: return B115200;
+  case 230400: return B230400;
+  default: return 0;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  static uint8_t buffer[SNIFFERPCAP_READ_SIZE + SNIFFER_RECORD_OVERHEAD + SNIFFER_LENGTH_MASK];
+  SnifferPcap_t pcap;
+  speed_t speed = B230400;
+  size_t length = 0;
+  int in = STDIN_FILENO;
+  int opt;
+  memset(&pcap, 0, sizeof(pcap));
+  pcap.out = stdout;
+  while ((opt = getopt(argc, argv, "b:")) != -1)
+  {
+    if ((opt != 'b') || ((speed = baudrate(strtol(optarg, NULL, 10))) == 0))
+    {
+      fprintf(stderr, "Usage: %s [-b baudrate] [input [output]]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if ((optind < argc) && (strcmp(argv[optind], "-") != 0))
+  {
+    in = open(argv[optind], O_RDONLY | O_NOCTTY);
+    if (in < 0)
+    {
+      perror(argv[optind]);
+      return EXIT_FAILURE;
+    }
+  }
+  if ((optind + 1 < argc) && (strcmp(argv[optind + 1], "-") != 0))
+  {
+    pcap.out = fopen(argv[optind + 1], "wb");
+    if (pcap.out == NULL)
+    {
+      perror(argv[optind + 1]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (isatty(in))
+  {
+    struct termios tio;
+    tcgetattr(in, &tio);
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tcsetattr(in, TCSANOW, &tio);
+  }
+  writeHeader(pcap.out);
+  fflush(pcap.out);
+  while (1)
+  {
+    ssize_t n = read(in, &buffer[length], SNIFFERPCAP_READ_SIZE);
+    size_t consumed;
+    if (n <= 0)
+    {
+      break;
+    }
+    length += n;
+    consumed = convert(&pcap, buffer, length);
+    memmove(buffer, &buffer[consumed], length - consumed);
+    length -= consumed;
+    /* frames show up in live capture as soon as they were read */
+    fflush(pcap.out);
+  }
+  fprintf(stderr, "%llu frames, %llu with CRC error, %llu bytes skipped\n",
+          (unsigned long long)pcap.records, (unsigned long long)pcap.crcErrors, (unsigned long long)pcap.skippedBytes);
+  if (pcap.out != stdout)
+  {
+    fclose(pcap.out);
+  }
+  return EXIT_SUCCESS;
+}
+
+/** @}*/
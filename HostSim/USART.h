@@ -0,0 +1,55 @@
+/** @ingroup HostSim
+ * @{
+ */
+#ifndef USART_H_
+#define USART_H_
+/*
+ * Host stand-in for CC253x/USART.h. Rx and Tx ring buffers of
+ * USART_RING_BUFFER_SIZE bytes are modelled in HostSim.c, the "interrupt"
+ * filling the rx ring buffer is driven from the byte source configured via
+ * HostSim_setUartSource or HostSim_setUartFd. Bytes written are delivered
+ * immediately but count as in tx buffer until their transmission time at the
+ * current baud rate passed (see USART_numBytesInTxBuffer).
+ */
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include "Config.h"
+   
+/*******************| Macros |*****************************************/
+
+/*******************| Type definitions |*******************************/
+typedef enum {
+  USART_Baudrate_2400,
+  USART_Baudrate_4800,
+  USART_Baudrate_9600,
+  USART_Baudrate_14400,
+  USART_Baudrate_19200,
+  USART_Baudrate_28800,
+  USART_Baudrate_38400,
+  USART_Baudrate_57600,
+  USART_Baudrate_76800,
+  USART_Baudrate_115200,
+  USART_Baudrate_230400,
+} USART_Baudrate_t;
+
+typedef enum {
+  USART_Parity_8BitNoParity,
+  USART_Parity_9BitEvenParity,
+  USART_Parity_9BitOddParity,
+} USART_Parity_t;
+
+/*******************| Global variables |*******************************/
+
+/*******************| Function prototypes |****************************/
+void USART_setBaudrate(USART_Baudrate_t baudrate);
+void USART_setParity(USART_Parity_t parity);
+void USART_getc(char *c);
+void USART_read(char *buffer, uint8_t length);
+void USART_putc(char c);
+void USART_write(char const *buffer, uint8_t length);
+void USART_writeline(char const *line);
+uint8_t USART_numBytesInRxBuffer(void);
+uint8_t USART_numBytesInTxBuffer(void);
+
+#endif
+/** @}*/
@@ -0,0 +1,30 @@
+/** @ingroup HostSim
+ * @{
+ */
+#ifndef WATCHDOGTIMER_H_
+#define WATCHDOGTIMER_H_
+/*
+ * Host stand-in for CC253x/WatchdogTimer.h
+ */
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+   
+/*******************| Macros |*****************************************/
+/**
+ * Watchdog intervals in number of 32kHz clock cycles
+ */
+#define WDT_INT_CLOCKTIMES32768         (uint8_t)0x00
+#define WDT_INT_CLOCKTIMES8192          (uint8_t)0x01
+#define WDT_INT_CLOCKTIMES512           (uint8_t)0x02
+#define WDT_INT_CLOCKTIMES64            (uint8_t)0x03
+
+/*******************| Type definitions |*******************************/
+
+/*******************| Global variables |*******************************/
+
+/*******************| Function prototypes |****************************/
+void WDT_init(uint8_t interval);
+void WDT_trigger(void);
+
+#endif
+/** @}*/
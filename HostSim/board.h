@@ -0,0 +1,34 @@
+/** @ingroup HostSim
+ * @{
+ */
+#ifndef BOARD_H_
+#define BOARD_H_
+/*
+ * Host stand-in for CC2530Generic/board.h
+ */
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include <ioCC2530.h>
+   
+/*******************| Macros |*****************************************/
+#define HAL_PINOUTPUT           1
+#define HAL_PININPUT            0
+
+/* only global interrupt enable is modelled, callbacks run as from interrupt anyway */
+#define enableAllInterrupt()    (EA = 1)
+#define disableAllInterrupt()   (EA = 0)
+
+/*******************| Type definitions |*******************************/
+
+/*******************| Global variables |*******************************/
+
+/*******************| Function prototypes |****************************/
+void Board_init(void);
+void ledInit(void);
+void ledOn(void);
+void ledOff(void);
+void UART_init(void);
+void nop(void);
+
+#endif
+/** @}*/
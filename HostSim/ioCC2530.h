@@ -0,0 +1,65 @@
+/** @ingroup HostSim
+ * @{
+ */
+#ifndef IOCC2530_H_
+#define IOCC2530_H_
+/*
+ * Host stand-in for the IAR ioCC2530.h SFR definitions. Registers are plain
+ * variables defined in HostSim.c.
+ */
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+   
+/*******************| Macros |*****************************************/
+/* Sleep timer count, reading ST0 latches ST1 and ST2 as on target */
+#define ST0     HostSim_readSleepTimer(0)
+#define ST1     HostSim_readSleepTimer(1)
+#define ST2     HostSim_readSleepTimer(2)
+/* Timer 1 count, reading T1CNTL latches T1CNTH as on target */
+#define T1CNTL  HostSim_readTimer1(0)
+#define T1CNTH  HostSim_readTimer1(1)
+/* Radio status, CCA bit follows HostSim_radioCcaBusy */
+#define FSMSTAT1        HostSim_readFsmstat1()
+/* RSSI of channel FREQCTRL is tuned to, follows HostSim_radioEnergy */
+#define RSSI            HostSim_readRssi()
+/* USART 0 baud rate mantissa, set via USART_setBaudrate. Reading lets DMA
+ * model catch up with bytes host has sent meanwhile. */
+#define U0BAUD          HostSim_readU0baud()
+/* USART 0 status, ACTIVE bit follows USART tx timing model */
+#define U0CSR           HostSim_readU0csr()
+/* xdata mapping of U0DBUF as given to DMA, the same variable on host */
+#define X_U0DBUF        U0DBUF
+
+/*******************| Type definitions |*******************************/
+
+/*******************| Global variables |*******************************/
+extern volatile uint8_t SLEEPSTA;
+extern volatile uint8_t T1CTL;
+extern volatile uint8_t FREQCTRL;
+extern volatile uint8_t RFST;
+extern volatile uint8_t RSSISTAT;
+extern volatile uint8_t FRMFILT0;
+extern volatile uint8_t FRMCTRL0;
+extern volatile uint8_t U0DBUF;
+extern volatile uint8_t URX0IE;
+extern volatile uint8_t IEN2;
+extern volatile uint8_t EA;
+extern volatile uint8_t P0_0;
+extern volatile uint8_t P0_1;
+extern volatile uint8_t P0DIR_0;
+extern volatile uint8_t P0DIR_1;
+extern volatile uint8_t P0DIR_2;
+extern volatile uint8_t P0DIR_3;
+extern volatile uint8_t P0DIR_4;
+extern volatile uint8_t P0DIR_5;
+
+/*******************| Function prototypes |****************************/
+uint8_t HostSim_readSleepTimer(uint8_t index);
+uint8_t HostSim_readTimer1(uint8_t index);
+uint8_t HostSim_readFsmstat1(void);
+uint8_t HostSim_readRssi(void);
+uint8_t HostSim_readU0baud(void);
+uint8_t HostSim_readU0csr(void);
+
+#endif
+/** @}*/
@@ -1,10 +1,12 @@
 import serial
 import struct
+import sys
 
 defaultChannel = 0x19
 
+# Serial port can be given on command line, e.g. pty printed by HostSim/cc2530bee_sim -p
 ser = serial.Serial(
-    port=30,
+    port=sys.argv[1] if len(sys.argv) > 1 else 30,
     baudrate=57600,
     # parity=serial.PARITY_ODD,
     # stopbits=serial.STOPBITS_TWO,
@@ -0,0 +1,1859 @@
+/** @ingroup ModuleTests
+ * @{
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ioCC2530.h>
+#include <CC253x.h>
+#include "CC2530Bee.h"
+#include "TxQueue.h"
+#include "RxQueue.h"
+#include "ConfigStore.h"
+#include "Trace.h"
+#include "Neighbour.h"
+#include "Duplicate.h"
+#include "Sniffer.h"
+#include "UartDma.h"
+#include "FramePool.h"
+#include "HostSim.h"
+
+/*
+ * Host counterpart of BaseTest.py. Runs the same kind of frame tests against
+ * the firmware built with HostSim (see HostSim/Makefile, "make check").
+ */
+
+static int failedTests = 0;
+static uint8_t frameId = 0;
+
+/**
+ * If not zero, only this many bytes of received frame are compared
+ */
+static uint16_t prefixLength = 0;
+
+/**
+ * Feeds one frame via USART and runs main function until it was processed
+ */
+static void sendFrame(const uint8_t *message, uint16_t length)
+{
+  static uint8_t frame[512];
+  uint16_t frameLength = HostSim_encodeFrame(message, length, frame);
+  HostSim_uartTxClear();
+  HostSim_setUartSource(frame, frameLength);
+  do {
+    CC2530Bee_mainFunction();
+  } while ((HostSim_uartRxPending() > 0) || (UARTAPI_numBytesInRxBuffer() > 0));
+}
+
+/**
+ * Gets n-th frame sent by firmware since last sendFrame
+ * @return payload length, 0 if no such frame exists
+ */
+static uint16_t receiveFrame(uint8_t n, uint8_t *message)
+{
+  uint16_t offset = 0;
+  uint16_t consumed = 0;
+  uint16_t length = 0;
+  do {
+    offset += consumed;
+    length = HostSim_decodeFrame(&HostSim_uartTxCapture[offset], HostSim_uartTxLength - offset, message, &consumed);
+  } while ((length > 0) && (n-- > 0));
+  return length;
+}
+
+static void checkResult(const char *name, const uint8_t *expected, uint16_t expectedLength, const uint8_t *received, uint16_t receivedLength)
+{
+  printf("%-40s", name);
+  if ((expectedLength <= receivedLength) && (memcmp(expected, received, expectedLength) == 0) &&
+      ((expectedLength == receivedLength) || (expectedLength == prefixLength)))
+  {
+    printf(": OK\n");
+  }
+  else
+  {
+    printf(": NOK\n    Received:");
+    for (uint16_t i = 0; i < receivedLength; i++)
+    {
+      printf(" %02x", received[i]);
+    }
+    printf("\n");
+    failedTests++;
+  }
+}
+
+static void checkValue(const char *name, uint32_t expected, uint32_t value)
+{
+  printf("%-40s", name);
+  if (expected == value)
+  {
+    printf(": OK\n");
+  }
+  else
+  {
+    printf(": NOK\n    Received: %lu\n", (unsigned long)value);
+    failedTests++;
+  }
+}
+
+/**
+ * Sends frame and compares n-th frame sent back by firmware with expected
+ */
+static void checkFrame(const char *name, const uint8_t *message, uint16_t length, uint8_t n, const uint8_t *expected, uint16_t expectedLength)
+{
+  uint8_t received[256];
+  uint16_t receivedLength;
+  sendFrame(message, length);
+  receivedLength = receiveFrame(n, received);
+  checkResult(name, expected, expectedLength, received, receivedLength);
+}
+
+#define CHECK(name, request, n, ...) do { \
+    const uint8_t req[] = request; \
+    const uint8_t exp[] = { __VA_ARGS__ }; \
+    checkFrame(name, req, sizeof(req), n, exp, sizeof(exp)); \
+  } while (0)
+#define CHECK_PREFIX(name, request, n, ...) do { \
+    const uint8_t req[] = request; \
+    const uint8_t exp[] = { __VA_ARGS__ }; \
+    prefixLength = sizeof(exp); \
+    checkFrame(name, req, sizeof(req), n, exp, sizeof(exp)); \
+    prefixLength = 0; \
+  } while (0)
+#define FRAME(...) { __VA_ARGS__ }
+
+static void simpleUARTEchoTests(void)
+{
+  CHECK("Echo 3 bytes", FRAME(0x44, frameId, 0xff), 0, 0x44, frameId, 0xff);
+  CHECK("Echo 6 bytes", FRAME(0x44, frameId, 0xff, 0xff, 0x00, 0xaf), 0, 0x44, frameId, 0xff, 0xff, 0x00, 0xaf);
+  CHECK("Echo bigger than USART buffer",
+        FRAME(0x44, frameId, 0xff, 0xff, 0x00, 0xaf, 0xfe, 0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5,
+              0xf4, 0xf3, 0xf2, 0xf1, 0xf0, 0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5, 0xf4, 0xf3),
+        0, 0x44, frameId, 0xff, 0xff, 0x00, 0xaf, 0xfe, 0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5,
+        0xf4, 0xf3, 0xf2, 0xf1, 0xf0, 0xff, 0xfe, 0xfd, 0xfc, 0xfb, 0xfa, 0xf9, 0xf8, 0xf7, 0xf6, 0xf5, 0xf4, 0xf3);
+  frameId++;
+  CHECK("Echo escaped 0x7e", FRAME(0x44, frameId, 0xff, 0xff, 0x7e, 0xaf, 0xfe), 0, 0x44, frameId, 0xff, 0xff, 0x7e, 0xaf, 0xfe);
+  CHECK("Echo escaped 0x7d", FRAME(0x44, frameId, 0xff, 0xff, 0x7d, 0xaf, 0xfe), 0, 0x44, frameId, 0xff, 0xff, 0x7d, 0xaf, 0xfe);
+  CHECK("Echo escaped 0x11", FRAME(0x44, frameId, 0xff, 0xff, 0x11, 0xaf, 0xfe), 0, 0x44, frameId, 0xff, 0xff, 0x11, 0xaf, 0xfe);
+  CHECK("Echo escaped 0x13", FRAME(0x44, frameId, 0x13, 0xff, 0x13, 0xaf, 0xfe), 0, 0x44, frameId, 0x13, 0xff, 0x13, 0xaf, 0xfe);
+  /* escape character is last byte of first UARTAPI_RX_BUFFER_SIZE block */
+  CHECK("Echo escape across rx blocks", FRAME(0x44, frameId, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0x7e, 0x11, 0x12),
+        0, 0x44, frameId, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0x7e, 0x11, 0x12);
+  frameId++;
+}
+
+/**
+ * Frame receiver must not block on partial frames and re-synchronize after
+ * garbage, truncated and oversized frames
+ */
+static void frameReceiverTests(void)
+{
+  const uint8_t echo[] = { 0x44, 0x55, 0x01, 0x02, 0x03 };
+  uint8_t frame[64];
+  uint8_t stream[128];
+  uint8_t received[256];
+  uint16_t frameLength = HostSim_encodeFrame(echo, sizeof(echo), frame);
+  uint16_t receivedLength;
+  uint16_t n;
+
+  /* frame split in two parts, nothing must be sent before second part arrived */
+  HostSim_uartTxClear();
+  HostSim_setUartSource(frame, 4);
+  CC2530Bee_mainFunction();
+  CC2530Bee_mainFunction();
+  receivedLength = receiveFrame(0, received);
+  checkResult("Partial frame not dispatched", received, 0, received, receivedLength);
+  HostSim_setUartSource(&frame[4], frameLength - 4);
+  CC2530Bee_mainFunction();
+  receivedLength = receiveFrame(0, received);
+  checkResult("Partial frame completed", echo, sizeof(echo), received, receivedLength);
+
+  /* garbage, truncated frame and frame with oversized length before valid frame */
+  n = 0;
+  stream[n++] = 0x00;
+  stream[n++] = 0x13;
+  memcpy(&stream[n], frame, 5);
+  n += 5;
+  stream[n++] = UARTFrame_Delimiter;
+  stream[n++] = 0xff;
+  stream[n++] = 0xff;
+  memcpy(&stream[n], frame, frameLength);
+  n += frameLength;
+  HostSim_uartTxClear();
+  HostSim_setUartSource(stream, n);
+  do {
+    CC2530Bee_mainFunction();
+  } while ((HostSim_uartRxPending() > 0) || (UARTAPI_numBytesInRxBuffer() > 0));
+  receivedLength = receiveFrame(0, received);
+  checkResult("Re-synchronization on delimiter", echo, sizeof(echo), received, receivedLength);
+
+  /* frame with wrong checksum is discarded, following frame is processed */
+  memcpy(stream, frame, frameLength);
+  stream[frameLength - 1] ^= 0x01;
+  memcpy(&stream[frameLength], frame, frameLength);
+  HostSim_uartTxClear();
+  HostSim_setUartSource(stream, 2 * frameLength);
+  do {
+    CC2530Bee_mainFunction();
+  } while ((HostSim_uartRxPending() > 0) || (UARTAPI_numBytesInRxBuffer() > 0));
+  receivedLength = receiveFrame(1, received);
+  checkResult("Checksum error, only one frame", received, 0, received, receivedLength);
+  receivedLength = receiveFrame(0, received);
+  checkResult("Checksum error, next frame", echo, sizeof(echo), received, receivedLength);
+}
+
+static void readParameterTests(void)
+{
+  CHECK("Read CH", FRAME(0x08, frameId, 0x43, 0x48), 0, 0x88, frameId, 0x43, 0x48, 0, CC2530BEE_Default_Channel);
+  frameId++;
+  CHECK("Read ID", FRAME(0x08, frameId, 0x49, 0x44), 0, 0x88, frameId, 0x49, 0x44, 0, 0x32, 0x33);
+  frameId++;
+  CHECK("Read MY", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0xaf, 0xfe);
+  frameId++;
+  CHECK("Read SH", FRAME(0x08, frameId, 0x53, 0x48), 0, 0x88, frameId, 0x53, 0x48, 0, 0x0, 0x0, 0x0, 0x0);
+  frameId++;
+  CHECK("Read SL", FRAME(0x08, frameId, 0x53, 0x4c), 0, 0x88, frameId, 0x53, 0x4c, 0, 0x0, 0x0, 0x0, 0x0);
+  frameId++;
+}
+
+static void setParameterTests(void)
+{
+  CHECK("Write DL", FRAME(0x08, frameId, 0x44, 0x4c, 0xaa, 0x55, 0xaa, 0x55), 0, 0x88, frameId, 0x44, 0x4c, 0);
+  CHECK("Read DL", FRAME(0x08, frameId, 0x44, 0x4c), 0, 0x88, frameId, 0x44, 0x4c, 0, 0xaa, 0x55, 0xaa, 0x55);
+  frameId++;
+  CHECK("Write MY", FRAME(0x08, frameId, 0x4d, 0x59, 0x12, 0x34), 0, 0x88, frameId, 0x4d, 0x59, 0);
+  CHECK("Read MY", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0x12, 0x34);
+  frameId++;
+  /* restore default source address for tx tests */
+  CHECK("Write MY", FRAME(0x08, frameId, 0x4d, 0x59, 0xaf, 0xfe), 0, 0x88, frameId, 0x4d, 0x59, 0);
+  frameId++;
+  /* two byte numbers are sent most significant byte first */
+  CHECK("Write SP 0x1234", FRAME(0x08, frameId, 0x53, 0x50, 0x12, 0x34), 0, 0x88, frameId, 0x53, 0x50, 0);
+  CHECK("Read SP 0x1234", FRAME(0x08, frameId, 0x53, 0x50), 0, 0x88, frameId, 0x53, 0x50, 0, 0x12, 0x34);
+  checkValue("SP 0x1234 value", 0x1234, CC2530Bee_Config.SleepPeriod);
+  CHECK("Write ST 0x1234", FRAME(0x08, frameId, 0x53, 0x54, 0x12, 0x34), 0, 0x88, frameId, 0x53, 0x54, 0);
+  CHECK("Read ST 0x1234", FRAME(0x08, frameId, 0x53, 0x54), 0, 0x88, frameId, 0x53, 0x54, 0, 0x12, 0x34);
+  checkValue("ST 0x1234 value", 0x1234, CC2530Bee_Config.TimeBeforeSleep);
+  CHECK("Write SC 0x1234", FRAME(0x08, frameId, 0x53, 0x43, 0x12, 0x34), 0, 0x88, frameId, 0x53, 0x43, 0);
+  CHECK("Read SC 0x1234", FRAME(0x08, frameId, 0x53, 0x43), 0, 0x88, frameId, 0x53, 0x43, 0, 0x12, 0x34);
+  checkValue("SC 0x1234 value", 0x1234, CC2530Bee_Config.ScanChannels);
+  CHECK("Write DW 0x1234", FRAME(0x08, frameId, 0x44, 0x57, 0x12, 0x34), 0, 0x88, frameId, 0x44, 0x57, 0);
+  CHECK("Read DW 0x1234", FRAME(0x08, frameId, 0x44, 0x57), 0, 0x88, frameId, 0x44, 0x57, 0, 0x12, 0x34);
+  checkValue("DW 0x1234 value", 0x1234, CC2530Bee_Config.DuplicateWindow);
+  CHECK("Write SP", FRAME(0x08, frameId, 0x53, 0x50,
+        HI_UINT16(CC2530BEE_Default_SleepPeriod), LO_UINT16(CC2530BEE_Default_SleepPeriod)), 0, 0x88, frameId, 0x53, 0x50, 0);
+  CHECK("Write ST", FRAME(0x08, frameId, 0x53, 0x54,
+        HI_UINT16(CC2530BEE_Default_TimeBeforeSleep), LO_UINT16(CC2530BEE_Default_TimeBeforeSleep)), 0, 0x88, frameId, 0x53, 0x54, 0);
+  CHECK("Write SC", FRAME(0x08, frameId, 0x53, 0x43,
+        HI_UINT16(CC2530BEE_Default_ScanChannels), LO_UINT16(CC2530BEE_Default_ScanChannels)), 0, 0x88, frameId, 0x53, 0x43, 0);
+  CHECK("Write DW", FRAME(0x08, frameId, 0x44, 0x57,
+        HI_UINT16(CC2530BEE_Default_DuplicateWindow), LO_UINT16(CC2530BEE_Default_DuplicateWindow)), 0, 0x88, frameId, 0x44, 0x57, 0);
+  frameId++;
+}
+
+/**
+ * AP switches between escaped and unescaped API frames. Response to AP is
+ * still sent in previous mode.
+ */
+static void apiModeTests(void)
+{
+  CHECK("Read AP", FRAME(0x08, frameId, 0x41, 0x50), 0, 0x88, frameId, 0x41, 0x50, 0, CC2530BEE_APIMODE_ESCAPED);
+  CHECK("Write AP invalid", FRAME(0x08, frameId, 0x41, 0x50, 0x03), 0, 0x88, frameId, 0x41, 0x50, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  /* frame ID needs escaping, response must be escaped */
+  CHECK("Write AP 1, response escaped", FRAME(0x08, 0x7d, 0x41, 0x50, CC2530BEE_APIMODE_UNESCAPED), 0, 0x88, 0x7d, 0x41, 0x50, 0);
+  HostSim_uartEscaped = 0;
+  CHECK("Echo unescaped", FRAME(0x44, frameId, 0x7e, 0x7d, 0x11, 0x13), 0, 0x44, frameId, 0x7e, 0x7d, 0x11, 0x13);
+  checkValue("Echo unescaped, bytes on wire", 3 + 6 + 1, HostSim_uartTxLength);
+  CHECK("Write AP 2, response unescaped", FRAME(0x08, 0x7d, 0x41, 0x50, CC2530BEE_APIMODE_ESCAPED), 0, 0x88, 0x7d, 0x41, 0x50, 0);
+  HostSim_uartEscaped = 1;
+  CHECK("Read AP escaped", FRAME(0x08, frameId, 0x41, 0x50), 0, 0x88, frameId, 0x41, 0x50, 0, CC2530BEE_APIMODE_ESCAPED);
+  frameId++;
+}
+
+/**
+ * Generic AT command engine: writes only change their own parameter, width,
+ * range and access rights are checked
+ */
+static void atCommandTableTests(void)
+{
+  uint8_t sorted = 1;
+  for (uint8_t i = 1; i < UARTAPI_NUM_ATCOMMANDS; i++)
+  {
+    sorted &= (UARTAPI_atCommands[i - 1].command < UARTAPI_atCommands[i].command);
+  }
+  checkValue("AT command table sorted", 1, sorted);
+  for (uint8_t i = 0; i < UARTAPI_NUM_ATCOMMANDS; i++)
+  {
+    if (UARTAPI_findATCommand(UARTAPI_atCommands[i].command) != &UARTAPI_atCommands[i])
+    {
+      sorted = 0;
+    }
+  }
+  checkValue("AT command lookup", 1, sorted);
+  CHECK("Write CH", FRAME(0x08, frameId, 0x43, 0x48, 0x0f), 0, 0x88, frameId, 0x43, 0x48, 0);
+  CHECK("Read ID not altered by CH", FRAME(0x08, frameId, 0x49, 0x44), 0, 0x88, frameId, 0x49, 0x44, 0, 0x32, 0x33);
+  CHECK("Read DL not altered by CH", FRAME(0x08, frameId, 0x44, 0x4c), 0, 0x88, frameId, 0x44, 0x4c, 0, 0xaa, 0x55, 0xaa, 0x55);
+  CHECK("Read MY not altered by CH", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0xaf, 0xfe);
+  CHECK("Write CH out of range", FRAME(0x08, frameId, 0x43, 0x48, 0x1b), 0, 0x88, frameId, 0x43, 0x48, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  CHECK("Write DL too short", FRAME(0x08, frameId, 0x44, 0x4c, 0x01, 0x02), 0, 0x88, frameId, 0x44, 0x4c, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  CHECK("Write SH read-only", FRAME(0x08, frameId, 0x53, 0x48, 1, 2, 3, 4), 0, 0x88, frameId, 0x53, 0x48, UARTAPI_ATCOMMAND_RESPONSE_STATUS_ERROR);
+  CHECK("WR with parameter", FRAME(0x08, frameId, 0x57, 0x52, 0x01), 0, 0x88, frameId, 0x57, 0x52, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  CHECK("Read unknown command", FRAME(0x08, frameId, 0x5a, 0x5a), 0, 0x88, frameId, 0x5a, 0x5a, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_CMD);
+  CHECK("Write CH", FRAME(0x08, frameId, 0x43, 0x48, CC2530BEE_Default_Channel), 0, 0x88, frameId, 0x43, 0x48, 0);
+  CHECK("Read CH", FRAME(0x08, frameId, 0x43, 0x48), 0, 0x88, frameId, 0x43, 0x48, 0, CC2530BEE_Default_Channel);
+  frameId++;
+}
+
+/**
+ * 0x09 stages parameters without applying them, AC or a 0x08 write applies
+ * all of them with a single radio re-init
+ */
+static void atQueueTests(void)
+{
+  uint32_t radioInits = HostSim_radioInitCount;
+  CHECK("Queue CH", FRAME(0x09, frameId, 0x43, 0x48, 0x0c), 0, 0x88, frameId, 0x43, 0x48, 0);
+  CHECK("Queue ID", FRAME(0x09, frameId, 0x49, 0x44, 0x11, 0x22), 0, 0x88, frameId, 0x49, 0x44, 0);
+  CHECK("Queue DH", FRAME(0x09, frameId, 0x44, 0x48, 0x01, 0x02, 0x03, 0x04), 0, 0x88, frameId, 0x44, 0x48, 0);
+  CHECK("Queue DL", FRAME(0x09, frameId, 0x44, 0x4c, 0x05, 0x06, 0x07, 0x08), 0, 0x88, frameId, 0x44, 0x4c, 0);
+  CHECK("Queue MY", FRAME(0x09, frameId, 0x4d, 0x59, 0x12, 0x34), 0, 0x88, frameId, 0x4d, 0x59, 0);
+  CHECK("Read CH queued not applied", FRAME(0x08, frameId, 0x43, 0x48), 0, 0x88, frameId, 0x43, 0x48, 0, CC2530BEE_Default_Channel);
+  CHECK("Read MY queued not applied", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0xaf, 0xfe);
+  checkValue("Queue no radio init", radioInits, HostSim_radioInitCount);
+  CHECK("AC", FRAME(0x08, frameId, 0x41, 0x43), 0, 0x88, frameId, 0x41, 0x43, 0);
+  checkValue("AC one radio init", radioInits + 1, HostSim_radioInitCount);
+  checkValue("AC channel applied", 0x0c, HostSim_radioConfig.Channel);
+  CHECK("Read CH", FRAME(0x08, frameId, 0x43, 0x48), 0, 0x88, frameId, 0x43, 0x48, 0, 0x0c);
+  CHECK("Read ID", FRAME(0x08, frameId, 0x49, 0x44), 0, 0x88, frameId, 0x49, 0x44, 0, 0x11, 0x22);
+  CHECK("Read DH", FRAME(0x08, frameId, 0x44, 0x48), 0, 0x88, frameId, 0x44, 0x48, 0, 0x01, 0x02, 0x03, 0x04);
+  CHECK("Read DL", FRAME(0x08, frameId, 0x44, 0x4c), 0, 0x88, frameId, 0x44, 0x4c, 0, 0x05, 0x06, 0x07, 0x08);
+  CHECK("Read MY", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0x12, 0x34);
+  CHECK("AC nothing queued", FRAME(0x08, frameId, 0x41, 0x43), 0, 0x88, frameId, 0x41, 0x43, 0);
+  checkValue("AC nothing queued no radio init", radioInits + 1, HostSim_radioInitCount);
+  frameId++;
+  /* a 0x08 write applies queued parameters together with its own, restores previous values for tx tests */
+  CHECK("Queue CH", FRAME(0x09, frameId, 0x43, 0x48, CC2530BEE_Default_Channel), 0, 0x88, frameId, 0x43, 0x48, 0);
+  CHECK("Queue ID", FRAME(0x09, frameId, 0x49, 0x44, 0x32, 0x33), 0, 0x88, frameId, 0x49, 0x44, 0);
+  CHECK("Queue DH", FRAME(0x09, frameId, 0x44, 0x48, 0x00, 0x00, 0x00, 0x00), 0, 0x88, frameId, 0x44, 0x48, 0);
+  CHECK("Queue DL", FRAME(0x09, frameId, 0x44, 0x4c, 0xaa, 0x55, 0xaa, 0x55), 0, 0x88, frameId, 0x44, 0x4c, 0);
+  CHECK("Write MY", FRAME(0x08, frameId, 0x4d, 0x59, 0xaf, 0xfe), 0, 0x88, frameId, 0x4d, 0x59, 0);
+  checkValue("Write applies queue, one radio init", radioInits + 2, HostSim_radioInitCount);
+  CHECK("Read CH", FRAME(0x08, frameId, 0x43, 0x48), 0, 0x88, frameId, 0x43, 0x48, 0, CC2530BEE_Default_Channel);
+  CHECK("Read ID", FRAME(0x08, frameId, 0x49, 0x44), 0, 0x88, frameId, 0x49, 0x44, 0, 0x32, 0x33);
+  CHECK("Read DL", FRAME(0x08, frameId, 0x44, 0x4c), 0, 0x88, frameId, 0x44, 0x4c, 0, 0xaa, 0x55, 0xaa, 0x55);
+  CHECK("Read MY", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0xaf, 0xfe);
+  frameId++;
+}
+
+/**
+ * BD: new baud rate is set only after AT command response left USART
+ */
+static void baudrateTests(void)
+{
+  CHECK("Read BD", FRAME(0x08, frameId, 0x42, 0x44), 0, 0x88, frameId, 0x42, 0x44, 0, 6);
+  CHECK("Write BD invalid", FRAME(0x08, frameId, 0x42, 0x44, 0), 0, 0x88, frameId, 0x42, 0x44, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  CHECK("Write BD 115200", FRAME(0x08, frameId, 0x42, 0x44, 7), 0, 0x88, frameId, 0x42, 0x44, 0);
+  CC2530Bee_mainFunction();
+  checkValue("BD kept while response is sent", USART_Baudrate_57600, HostSim_uartBaudrate);
+  HostSim_uartTxDrain();
+  CC2530Bee_mainFunction();
+  checkValue("BD set after response was sent", USART_Baudrate_115200, HostSim_uartBaudrate);
+  CHECK("Read BD 115200", FRAME(0x08, frameId, 0x42, 0x44), 0, 0x88, frameId, 0x42, 0x44, 0, 7);
+  CHECK("Write BD 57600", FRAME(0x08, frameId, 0x42, 0x44, 6), 0, 0x88, frameId, 0x42, 0x44, 0);
+  HostSim_uartTxDrain();
+  CC2530Bee_mainFunction();
+  checkValue("BD restored", USART_Baudrate_57600, HostSim_uartBaudrate);
+  checkValue("BD not changed while sending", 0, HostSim_uartBaudrateGlitches);
+  frameId++;
+}
+
+static void txTests(void)
+{
+  uint32_t txBytes;
+  /* Loopback: frame is received back and acknowledged. TX status is sent once
+   * ACK was received, RX packet afterwards */
+  CHECK("TX 16bit, RX packet", FRAME(0x01, frameId, 0xee, 0xee, 0x00, 0xaf, 0xfe),
+        1, 0x81, HI_UINT16(CC2530BEE_Default_ShortAddress), LO_UINT16(CC2530BEE_Default_ShortAddress), (uint8_t)HOSTSIM_LOOPBACK_RSSI, 0x00, 0xaf, 0xfe);
+  CHECK_PREFIX("TX 16bit, TX status", FRAME(0x01, frameId, 0xee, 0xee, 0x00, 0xaf, 0xfe),
+        0, 0x89, frameId, UARTAPI_TX_STATUS_SUCCESS);
+  frameId++;
+  CHECK("TX 16bit broadcast, TX status", FRAME(0x01, frameId, 0xff, 0xff, 0x00, 0xaf, 0xfe),
+        0, 0x89, frameId, UARTAPI_TX_STATUS_SUCCESS);
+  frameId++;
+  CHECK("TX 16bit broadcast, RX packet", FRAME(0x01, frameId, 0xff, 0xff, 0x00, 0xaf, 0xfe),
+        1, 0x81, HI_UINT16(CC2530BEE_Default_ShortAddress), LO_UINT16(CC2530BEE_Default_ShortAddress), (uint8_t)HOSTSIM_LOOPBACK_RSSI, UARTAPI_RECEVICE_OPTIONS_ADDRESS_BROADCAST, 0xaf, 0xfe);
+  frameId++;
+  CHECK("TX 16bit broadcast PAN", FRAME(0x01, frameId, 0xee, 0xee, UARTAPI_TRANSMIT_OPTIONS_BROADCASTPANID | UARTAPI_TRANSMIT_OPTIONS_DISABLEACK, 0x12),
+        1, 0x81, HI_UINT16(CC2530BEE_Default_ShortAddress), LO_UINT16(CC2530BEE_Default_ShortAddress), (uint8_t)HOSTSIM_LOOPBACK_RSSI, UARTAPI_RECEVICE_OPTIONS_PAN_BROADCAST, 0x12);
+  frameId++;
+  CHECK_PREFIX("TX 64bit, TX status", FRAME(0x00, frameId, 0, 0, 0, 0, 0, 0, 0xee, 0xee, 0x00, 0xaf, 0xfe),
+        0, 0x89, frameId, UARTAPI_TX_STATUS_SUCCESS);
+  frameId++;
+  /* payload looking like a remote AT command request (FR) is plain data */
+  CHECK("TX remote AT lookalike, RX packet", FRAME(0x01, frameId, 0xee, 0xee, 0x00, CC2530BEE_FRAME_TYPE_REMOTEAT, 0x17, 0x01, 0x00, 0x46, 0x52),
+        1, 0x81, HI_UINT16(CC2530BEE_Default_ShortAddress), LO_UINT16(CC2530BEE_Default_ShortAddress), (uint8_t)HOSTSIM_LOOPBACK_RSSI, 0x00,
+        CC2530BEE_FRAME_TYPE_REMOTEAT, 0x17, 0x01, 0x00, 0x46, 0x52);
+  frameId++;
+  CHECK("TX fragment lookalike, RX packet", FRAME(0x01, frameId, 0xee, 0xee, 0x00, CC2530BEE_FRAME_TYPE_FRAGMENT, 0x01, 0x00, 0x02, 0xaf),
+        1, 0x81, HI_UINT16(CC2530BEE_Default_ShortAddress), LO_UINT16(CC2530BEE_Default_ShortAddress), (uint8_t)HOSTSIM_LOOPBACK_RSSI, 0x00,
+        CC2530BEE_FRAME_TYPE_FRAGMENT, 0x01, 0x00, 0x02, 0xaf);
+  frameId++;
+  CHECK("TX aggregate lookalike, RX packet", FRAME(0x01, frameId, 0xee, 0xee, 0x00, CC2530BEE_FRAME_TYPE_AGGREGATE, 0x01, 0xaf),
+        1, 0x81, HI_UINT16(CC2530BEE_Default_ShortAddress), LO_UINT16(CC2530BEE_Default_ShortAddress), (uint8_t)HOSTSIM_LOOPBACK_RSSI, 0x00,
+        CC2530BEE_FRAME_TYPE_AGGREGATE, 0x01, 0xaf);
+  frameId++;
+  /* data frame carries payload of TX request only, as XBee does */
+  txBytes = HostSim_radioTxBytes;
+  CHECK("TX 16bit, RX packet", FRAME(0x01, frameId, 0xee, 0xee, 0x00, 0x00, 0xaf),
+        1, 0x81, HI_UINT16(CC2530BEE_Default_ShortAddress), LO_UINT16(CC2530BEE_Default_ShortAddress), (uint8_t)HOSTSIM_LOOPBACK_RSSI, 0x00, 0x00, 0xaf);
+  checkValue("TX payload unchanged, radio bytes", 2, HostSim_radioTxBytes - txBytes);
+  frameId++;
+}
+
+/**
+ * Runs main function while time passes, e.g. for backoffs and ACK waits
+ */
+static void runFor(uint16_t milliseconds)
+{
+  for (uint16_t i = 0; i < milliseconds; i++)
+  {
+    HostSim_advanceTime(1000);
+    CC2530Bee_mainFunction();
+  }
+}
+
+/**
+ * Gets last frame with given API identifier sent by firmware since last
+ * sendFrame
+ * @return payload length, 0 if no such frame exists
+ */
+static uint16_t receiveLastFrame(uint8_t apiIdentifier, uint8_t *message)
+{
+  uint8_t frame[256];
+  uint16_t length;
+  uint16_t found = 0;
+  for (uint8_t n = 0; (length = receiveFrame(n, frame)) > 0; n++)
+  {
+    if (frame[0] == apiIdentifier)
+    {
+      memcpy(message, frame, length);
+      found = length;
+    }
+  }
+  return found;
+}
+
+/**
+ * TX status reports outcome of ACK wait, MAC retries (RR) and CSMA-CA
+ */
+static void txStatusTests(void)
+{
+  uint8_t received[64];
+  uint16_t receivedLength;
+  uint32_t txFrames;
+  uint32_t ccas;
+  const uint8_t tx[] = { 0x01, 0x41, 0xee, 0xee, 0x00, 0x12 };
+  const uint8_t txNoStatus[] = { 0x01, 0x00, 0xee, 0xee, 0x00, 0x12 };
+  const uint8_t expectedSuccess[] = { 0x89, 0x41, UARTAPI_TX_STATUS_SUCCESS };
+  const uint8_t expectedNoAck[] = { 0x89, 0x41, UARTAPI_TX_STATUS_NOACK };
+  const uint8_t expectedCcaFailure[] = { 0x89, 0x41, UARTAPI_TX_STATUS_CCAFAILURE };
+  const uint8_t expectedPurged[] = { 0x89, 0x41, UARTAPI_TX_STATUS_PURGED };
+
+  CHECK("Read RR", FRAME(0x08, frameId, 0x52, 0x52), 0, 0x88, frameId, 0x52, 0x52, 0, CC2530BEE_Default_MACRetries);
+  CHECK("Read RN", FRAME(0x08, frameId, 0x52, 0x4e), 0, 0x88, frameId, 0x52, 0x4e, 0, CC2530BEE_Default_MinBackoffExponent);
+  CHECK("Write RR out of range", FRAME(0x08, frameId, 0x52, 0x52, CC2530BEE_MACRETRIES_LAST + 1), 0, 0x88, frameId, 0x52, 0x52, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  CHECK("Write RN out of range", FRAME(0x08, frameId, 0x52, 0x4e, CC2530BEE_MIN_BACKOFF_EXPONENT_LAST + 1), 0, 0x88, frameId, 0x52, 0x4e, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  frameId++;
+
+  /* no peer: frame is sent 1 + RR times, then NOACK */
+  HostSim_radioLoopback = 0;
+  txFrames = HostSim_radioTxFrames;
+  sendFrame(tx, sizeof(tx));
+  checkValue("No ACK, no status while waiting", 0, receiveFrame(0, received));
+  runFor(50);
+  receivedLength = receiveFrame(0, received);
+  checkResult("No ACK, TX status", expectedNoAck, sizeof(expectedNoAck), received, receivedLength);
+  checkValue("No ACK, retries", 1 + CC2530BEE_Default_MACRetries, HostSim_radioTxFrames - txFrames);
+  CHECK("Write RR 0", FRAME(0x08, frameId, 0x52, 0x52, 0), 0, 0x88, frameId, 0x52, 0x52, 0);
+  txFrames = HostSim_radioTxFrames;
+  sendFrame(tx, sizeof(tx));
+  runFor(50);
+  receivedLength = receiveFrame(0, received);
+  checkResult("No ACK RR 0, TX status", expectedNoAck, sizeof(expectedNoAck), received, receivedLength);
+  checkValue("No ACK RR 0, no retry", 1, HostSim_radioTxFrames - txFrames);
+  CHECK("Write RR", FRAME(0x08, frameId, 0x52, 0x52, CC2530BEE_Default_MACRetries), 0, 0x88, frameId, 0x52, 0x52, 0);
+  sendFrame(txNoStatus, sizeof(txNoStatus));
+  runFor(50);
+  checkValue("No ACK, frame ID 0 no status", 0, receiveFrame(0, received));
+
+  /* radio re-init purges frame waiting for ACK */
+  sendFrame(tx, sizeof(tx));
+  CHECK("Write CH while waiting for ACK", FRAME(0x08, frameId, 0x43, 0x48, CC2530BEE_Default_Channel), 0, 0x88, frameId, 0x43, 0x48, 0);
+  receivedLength = receiveFrame(1, received);
+  checkResult("Radio re-init, TX status", expectedPurged, sizeof(expectedPurged), received, receivedLength);
+  frameId++;
+  HostSim_radioLoopback = 1;
+
+  /* lost ACK: retransmission is received twice by peer */
+  HostSim_radioAckLoss = 1;
+  txFrames = HostSim_radioTxFrames;
+  sendFrame(tx, sizeof(tx));
+  runFor(50);
+  receivedLength = receiveLastFrame(0x89, received);
+  checkResult("ACK lost, TX status", expectedSuccess, sizeof(expectedSuccess), received, receivedLength);
+  checkValue("ACK lost, one retry", 2, HostSim_radioTxFrames - txFrames);
+
+  /* busy channel: backoff with growing exponent, CCA failure after all backoffs */
+  HostSim_radioCcaBusy = 2;
+  ccas = HostSim_radioCcaCount;
+  sendFrame(tx, sizeof(tx));
+  runFor(50);
+  receivedLength = receiveFrame(0, received);
+  checkResult("Channel busy twice, TX status", expectedSuccess, sizeof(expectedSuccess), received, receivedLength);
+  checkValue("Channel busy twice, CCAs", 3, HostSim_radioCcaCount - ccas);
+  HostSim_radioCcaBusy = 1 + CC2530BEE_CSMA_MAX_BACKOFFS;
+  ccas = HostSim_radioCcaCount;
+  txFrames = HostSim_radioTxFrames;
+  sendFrame(tx, sizeof(tx));
+  runFor(50);
+  receivedLength = receiveFrame(0, received);
+  checkResult("Channel busy, TX status", expectedCcaFailure, sizeof(expectedCcaFailure), received, receivedLength);
+  checkValue("Channel busy, CCAs", 1 + CC2530BEE_CSMA_MAX_BACKOFFS, HostSim_radioCcaCount - ccas);
+  checkValue("Channel busy, not sent", 0, HostSim_radioTxFrames - txFrames);
+}
+
+/**
+ * Back-to-back TX requests in one USART stream are all sent, per-frame
+ * options do not alter configured header
+ */
+static void txQueueTests(void)
+{
+  const uint8_t tx64[] = { 0x00, 0x00, 1, 2, 3, 4, 5, 6, 7, 8, UARTAPI_TRANSMIT_OPTIONS_DISABLEACK | UARTAPI_TRANSMIT_OPTIONS_BROADCASTPANID, 0xaa };
+  uint8_t stream[6 * 32];
+  uint16_t n = 0;
+  uint32_t txFrames = HostSim_radioTxFrames;
+
+  for (uint8_t i = 0; i < 6; i++)
+  {
+    n += HostSim_encodeFrame(tx64, sizeof(tx64), &stream[n]);
+  }
+  HostSim_setUartSource(stream, n);
+  do {
+    CC2530Bee_mainFunction();
+  } while ((HostSim_uartRxPending() > 0) || (UARTAPI_numBytesInRxBuffer() > 0));
+  /* drain queue */
+  for (uint8_t i = 0; i < TXQUEUE_NUM_SLOTS; i++)
+  {
+    CC2530Bee_mainFunction();
+  }
+  checkValue("Back-to-back TX requests sent", 6, HostSim_radioTxFrames - txFrames);
+
+  CHECK("DL not altered by TX 64bit", FRAME(0x08, frameId, 0x44, 0x4c), 0, 0x88, frameId, 0x44, 0x4c, 0, 0xaa, 0x55, 0xaa, 0x55);
+  frameId++;
+  CHECK("ID not altered by TX options", FRAME(0x08, frameId, 0x49, 0x44), 0, 0x88, frameId, 0x49, 0x44, 0, 0x32, 0x33);
+  frameId++;
+}
+
+/**
+ * Sends several frames in one USART stream
+ */
+static void sendFrames(const uint8_t *const *messages, const uint16_t *lengths, uint8_t numMessages)
+{
+  static uint8_t stream[1024];
+  uint16_t n = 0;
+  for (uint8_t i = 0; i < numMessages; i++)
+  {
+    n += HostSim_encodeFrame(messages[i], lengths[i], &stream[n]);
+  }
+  HostSim_uartTxClear();
+  HostSim_setUartSource(stream, n);
+  do {
+    CC2530Bee_mainFunction();
+  } while ((HostSim_uartRxPending() > 0) || (UARTAPI_numBytesInRxBuffer() > 0));
+}
+
+/**
+ * Aggregation (AG): TX requests to the same destination within the window are
+ * sent as one frame, loopback splits them into separate RX packets again
+ */
+static void aggregationTests(void)
+{
+  uint8_t received[64];
+  uint16_t receivedLength;
+  uint32_t txFrames;
+  const uint8_t tx1[] = { 0x01, 0x51, 0xee, 0xee, 0x00, 0x11, 0x12, 0x13, 0x14 };
+  const uint8_t tx2[] = { 0x01, 0x52, 0xee, 0xee, 0x00, 0x21 };
+  const uint8_t tx3[] = { 0x01, 0x53, 0xee, 0xee, 0x00, 0x31, 0x32 };
+  const uint8_t tx4[] = { 0x01, 0x54, 0xdd, 0xdd, 0x00, 0x41 };
+  const uint8_t *const sameDestination[] = { tx1, tx2, tx3 };
+  const uint16_t sameDestinationLengths[] = { sizeof(tx1), sizeof(tx2), sizeof(tx3) };
+  const uint8_t *const otherDestination[] = { tx1, tx4 };
+  const uint16_t otherDestinationLengths[] = { sizeof(tx1), sizeof(tx4) };
+  const uint8_t *const queueFull[] = { tx1, tx2, tx3, tx1 };
+  const uint16_t queueFullLengths[] = { sizeof(tx1), sizeof(tx2), sizeof(tx3), sizeof(tx1) };
+  const uint8_t expectedStatus1[] = { 0x89, 0x51, UARTAPI_TX_STATUS_SUCCESS };
+  const uint8_t expectedStatus2[] = { 0x89, 0x52, UARTAPI_TX_STATUS_SUCCESS };
+  const uint8_t expectedStatus3[] = { 0x89, 0x53, UARTAPI_TX_STATUS_SUCCESS };
+  const uint8_t expectedRx1[] = { 0x81, 0xfe, 0xaf, (uint8_t)HOSTSIM_LOOPBACK_RSSI, 0x00, 0x11, 0x12, 0x13, 0x14 };
+  const uint8_t expectedRx2[] = { 0x81, 0xfe, 0xaf, (uint8_t)HOSTSIM_LOOPBACK_RSSI, 0x00, 0x21 };
+  const uint8_t expectedRx3[] = { 0x81, 0xfe, 0xaf, (uint8_t)HOSTSIM_LOOPBACK_RSSI, 0x00, 0x31, 0x32 };
+
+  CHECK("Write AG", FRAME(0x08, frameId, 0x41, 0x47, 5), 0, 0x88, frameId, 0x41, 0x47, 0);
+  frameId++;
+  txFrames = HostSim_radioTxFrames;
+  sendFrames(sameDestination, sameDestinationLengths, 3);
+  checkValue("Aggregation waits for window", 0, HostSim_radioTxFrames - txFrames);
+  runFor(10);
+  checkValue("Aggregation one frame", 1, HostSim_radioTxFrames - txFrames);
+  receivedLength = receiveFrame(0, received);
+  checkResult("Aggregation TX status 1", expectedStatus1, sizeof(expectedStatus1), received, receivedLength);
+  receivedLength = receiveFrame(1, received);
+  checkResult("Aggregation TX status 2", expectedStatus2, sizeof(expectedStatus2), received, receivedLength);
+  receivedLength = receiveFrame(2, received);
+  checkResult("Aggregation TX status 3", expectedStatus3, sizeof(expectedStatus3), received, receivedLength);
+  receivedLength = receiveFrame(3, received);
+  checkResult("Aggregation RX packet 1", expectedRx1, sizeof(expectedRx1), received, receivedLength);
+  receivedLength = receiveFrame(4, received);
+  checkResult("Aggregation RX packet 2", expectedRx2, sizeof(expectedRx2), received, receivedLength);
+  receivedLength = receiveFrame(5, received);
+  checkResult("Aggregation RX packet 3", expectedRx3, sizeof(expectedRx3), received, receivedLength);
+
+  txFrames = HostSim_radioTxFrames;
+  sendFrames(otherDestination, otherDestinationLengths, 2);
+  runFor(10);
+  checkValue("Aggregation other destination", 2, HostSim_radioTxFrames - txFrames);
+  txFrames = HostSim_radioTxFrames;
+  sendFrames(queueFull, queueFullLengths, TXQUEUE_NUM_SLOTS);
+  checkValue("Aggregation queue full", 1, HostSim_radioTxFrames - txFrames);
+  runFor(10);
+
+  CHECK("Write AG off", FRAME(0x08, frameId, 0x41, 0x47, CC2530BEE_Default_AggregationWindow), 0, 0x88, frameId, 0x41, 0x47, 0);
+  frameId++;
+  txFrames = HostSim_radioTxFrames;
+  sendFrames(sameDestination, sameDestinationLengths, 3);
+  runFor(10);
+  checkValue("No aggregation", 3, HostSim_radioTxFrames - txFrames);
+}
+
+/**
+ * TX requests with more payload than fits into one radio frame are sent in
+ * fragments and reassembled into one RX packet by the receiver
+ */
+static void fragmentationTests(void)
+{
+  IEEE802154_DataFrameHeader_t header;
+  uint8_t tx[UARTAPI_16BITTRANSMIT_DATA + FRAGMENT_MAX_PAYLOAD_LENGTH + 1] = { 0x01, 0x61, 0xee, 0xee, 0x00 };
+  uint8_t expectedRx[5 + FRAGMENT_MAX_PAYLOAD_LENGTH] = { 0x81, 0xfe, 0xaf, (uint8_t)HOSTSIM_LOOPBACK_RSSI, 0x00 };
+  uint8_t fragment[CC2530BEE_FRAGMENT_DATA + CC2530BEE_FRAGMENT_DATA_LENGTH] = { CC2530BEE_FRAME_TYPE_FRAGMENT, 0x80 };
+  uint8_t received[UARTAPI_MAX_PAYLOAD_LENGTH];
+  const uint8_t expectedSuccess[] = { 0x89, 0x61, UARTAPI_TX_STATUS_SUCCESS };
+  const uint8_t expectedNoAck[] = { 0x89, 0x61, UARTAPI_TX_STATUS_NOACK };
+  uint16_t receivedLength;
+  uint32_t txFrames;
+  uint16_t i;
+
+  for (i = 0; i < FRAGMENT_MAX_PAYLOAD_LENGTH; i++)
+  {
+    tx[UARTAPI_16BITTRANSMIT_DATA + i] = (uint8_t)i;
+    expectedRx[5 + i] = (uint8_t)i;
+  }
+  txFrames = HostSim_radioTxFrames;
+  sendFrame(tx, UARTAPI_16BITTRANSMIT_DATA + 250);
+  runFor(50);
+  checkValue("Fragmented TX, radio frames", 3, HostSim_radioTxFrames - txFrames);
+  receivedLength = receiveLastFrame(0x89, received);
+  checkResult("Fragmented TX, TX status", expectedSuccess, sizeof(expectedSuccess), received, receivedLength);
+  receivedLength = receiveLastFrame(0x81, received);
+  checkResult("Fragmented TX, RX packet", expectedRx, 5 + 250, received, receivedLength);
+  sendFrame(tx, UARTAPI_16BITTRANSMIT_DATA + FRAGMENT_MAX_PAYLOAD_LENGTH);
+  runFor(50);
+  receivedLength = receiveLastFrame(0x81, received);
+  checkResult("Fragmented TX, largest payload", expectedRx, sizeof(expectedRx), received, receivedLength);
+  txFrames = HostSim_radioTxFrames;
+  sendFrame(tx, sizeof(tx));
+  runFor(50);
+  checkValue("Fragmented TX, too large discarded", 0, HostSim_radioTxFrames - txFrames);
+
+  /* no peer: first fragment is retried, remaining ones are not sent */
+  HostSim_radioLoopback = 0;
+  txFrames = HostSim_radioTxFrames;
+  sendFrame(tx, UARTAPI_16BITTRANSMIT_DATA + 250);
+  runFor(50);
+  receivedLength = receiveFrame(0, received);
+  checkResult("Fragmented TX no ACK, TX status", expectedNoAck, sizeof(expectedNoAck), received, receivedLength);
+  checkValue("Fragmented TX no ACK, frames", 1 + CC2530BEE_Default_MACRetries, HostSim_radioTxFrames - txFrames);
+  HostSim_radioLoopback = 1;
+
+  memset(&header, 0, sizeof(header));
+  header.fcf.frameType = IEEE802154_FCF_FRAME_TYPE_DATA;
+  header.fcf.reserved = CC2530BEE_FCF_RESERVED_CONTROL;
+  header.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.destinationPANID = CC2530BEE_Default_PanID;
+  header.destinationAddress.shortAddress = IEEE802154_BROADCAST_ADDRESS_16BIT;
+
+  /* missing last fragment: buffer is freed after timeout */
+  HostSim_uartTxClear();
+  for (i = 0; i < REASSEMBLY_NUM_BUFFERS; i++)
+  {
+    header.sourceAddress.shortAddress = 0x1000 + i;
+    fragment[CC2530BEE_FRAGMENT_COUNT] = 2;
+    HostSim_radioReceive(&header, fragment, sizeof(fragment), (sint8_t)0xd0);
+    CC2530Bee_mainFunction();
+  }
+  header.sourceAddress.shortAddress = 0x2000;
+  HostSim_radioReceive(&header, fragment, sizeof(fragment), (sint8_t)0xd0);
+  fragment[CC2530BEE_FRAGMENT_INDEX] = 1;
+  header.sequenceNumber++;
+  HostSim_radioReceive(&header, fragment, 10, (sint8_t)0xd0);
+  CC2530Bee_mainFunction();
+  CC2530Bee_mainFunction();
+  checkValue("Reassembly, no free buffer", 0, receiveFrame(0, received));
+  HostSim_advanceTime(1000000ull * CC2530BEE_REASSEMBLY_TIMEOUT / HOSTSIM_SLEEPTIMER_FREQUENCY);
+  CC2530Bee_mainFunction();
+  fragment[CC2530BEE_FRAGMENT_INDEX] = 0;
+  header.sequenceNumber++;
+  HostSim_radioReceive(&header, fragment, sizeof(fragment), (sint8_t)0xd0);
+  fragment[CC2530BEE_FRAGMENT_INDEX] = 1;
+  header.sequenceNumber++;
+  HostSim_radioReceive(&header, fragment, 10, (sint8_t)0xd0);
+  CC2530Bee_mainFunction();
+  CC2530Bee_mainFunction();
+  receivedLength = receiveFrame(0, received);
+  checkValue("Reassembly after timeout", 5 + CC2530BEE_FRAGMENT_DATA_LENGTH + 10 - CC2530BEE_FRAGMENT_DATA, receivedLength);
+
+  /* more fragments announced than fit into reassembly buffer */
+  HostSim_uartTxClear();
+  fragment[CC2530BEE_FRAGMENT_INDEX] = 0;
+  fragment[CC2530BEE_FRAGMENT_COUNT] = FRAGMENT_MAX_PAYLOAD_LENGTH / CC2530BEE_FRAGMENT_DATA_LENGTH + 2;
+  HostSim_radioReceive(&header, fragment, sizeof(fragment), (sint8_t)0xd0);
+  CC2530Bee_mainFunction();
+  checkValue("Reassembly, too many fragments", 0, receiveFrame(0, received));
+}
+
+static void rxTests(void)
+{
+  IEEE802154_DataFrameHeader_t header;
+  const uint8_t payload[] = { 0xaa, 0xbb, 0xcc, 0xdd };
+  const uint8_t expected16[] = { 0x81, 0xee, 0xee, 0xd0, 0x02, 0xaa, 0xbb, 0xcc, 0xdd };
+  const uint8_t expected64[] = { 0x80, 1, 2, 3, 4, 5, 6, 7, 8, 0xd0, 0x00, 0xaa, 0xbb, 0xcc, 0xdd };
+  const uint8_t foreign[] = { CC2530BEE_FRAME_TYPE_REMOTEAT, 0x17, 0x01, 0x00, 0x46, 0x52 };
+  const uint8_t expectedForeign[] = { 0x81, 0xee, 0xee, 0xd0, 0x00, CC2530BEE_FRAME_TYPE_REMOTEAT, 0x17, 0x01, 0x00, 0x46, 0x52 };
+  uint8_t received[256];
+  uint16_t receivedLength;
+  uint16_t overflows = RxQueue_overflowCount;
+
+  memset(&header, 0, sizeof(header));
+  header.fcf.frameType = IEEE802154_FCF_FRAME_TYPE_DATA;
+  header.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.destinationPANID = CC2530BEE_Default_PanID;
+  header.destinationAddress.shortAddress = IEEE802154_BROADCAST_ADDRESS_16BIT;
+  header.sourceAddress.shortAddress = 0xeeee;
+  HostSim_uartTxClear();
+  HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  receivedLength = receiveFrame(0, received);
+  checkResult("RX not sent from interrupt", received, 0, received, receivedLength);
+  CC2530Bee_mainFunction();
+  receivedLength = receiveFrame(0, received);
+  checkResult("RX 16bit broadcast", expected16, sizeof(expected16), received, receivedLength);
+
+  /* XBee or SmartRF node sends payload as is, without reserved FCF bit */
+  header.destinationAddress.shortAddress = CC2530BEE_Default_ShortAddress;
+  header.sequenceNumber++;
+  HostSim_uartTxClear();
+  HostSim_radioReceive(&header, foreign, sizeof(foreign), (sint8_t)0xd0);
+  CC2530Bee_mainFunction();
+  receivedLength = receiveFrame(0, received);
+  checkResult("RX foreign node, payload unchanged", expectedForeign, sizeof(expectedForeign), received, receivedLength);
+
+  header.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_64BIT;
+  header.destinationAddress.shortAddress = CC2530BEE_Default_ShortAddress;
+  memcpy(header.sourceAddress.extendedAdress, &expected64[1], sizeof(IEEE802154_ExtendedAddress_t));
+  HostSim_uartTxClear();
+  HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  CC2530Bee_mainFunction();
+  receivedLength = receiveFrame(0, received);
+  checkResult("RX 64bit", expected64, sizeof(expected64), received, receivedLength);
+
+  /* burst of frames while main loop is busy, queue overflows */
+  HostSim_uartTxClear();
+  for (uint8_t i = 0; i < RXQUEUE_NUM_SLOTS + 2; i++)
+  {
+    header.sequenceNumber++;
+    HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  }
+  for (uint8_t i = 0; i < RXQUEUE_NUM_SLOTS + 2; i++)
+  {
+    CC2530Bee_mainFunction();
+  }
+  receivedLength = receiveFrame(RXQUEUE_NUM_SLOTS - 1, received);
+  checkResult("RX burst, last queued frame", expected64, sizeof(expected64), received, receivedLength);
+  receivedLength = receiveFrame(RXQUEUE_NUM_SLOTS, received);
+  checkResult("RX burst, overflow dropped", received, 0, received, receivedLength);
+  checkValue("RX burst, overflow counted", 2, RxQueue_overflowCount - overflows);
+}
+
+/**
+ * Transparent mode: UART bytes are sent to DH/DL when line is idle for RO
+ * character times or frame is full, radio payload is written to UART as is
+ */
+static void transparentTests(void)
+{
+  const uint8_t message[] = "hello world";
+  uint8_t stream[200];
+  uint32_t txFrames = HostSim_radioTxFrames;
+
+  CC2530Bee_Config.APIMode = CC2530BEE_APIMODE_TRANSPARENT;
+  HostSim_uartTxClear();
+  HostSim_setUartSource(message, sizeof(message));
+  CC2530Bee_mainFunction();
+  CC2530Bee_mainFunction();
+  checkValue("Transparent bytes held until idle", 0, HostSim_radioTxFrames - txFrames);
+  HostSim_advanceTime(1000);
+  CC2530Bee_mainFunction();
+  checkValue("Transparent frame sent after RO", 1, HostSim_radioTxFrames - txFrames);
+  checkResult("Transparent RX unframed", message, sizeof(message), HostSim_uartTxCapture, HostSim_uartTxLength);
+
+  /* stream longer than one frame, full frames are sent without waiting */
+  for (uint16_t i = 0; i < sizeof(stream); i++)
+  {
+    stream[i] = (uint8_t)i;
+  }
+  txFrames = HostSim_radioTxFrames;
+  HostSim_uartTxClear();
+  HostSim_setUartSource(stream, sizeof(stream));
+  do {
+    CC2530Bee_mainFunction();
+  } while (HostSim_uartRxPending() > 0);
+  checkValue("Transparent full frames sent", 2, HostSim_radioTxFrames - txFrames);
+  HostSim_advanceTime(1000);
+  CC2530Bee_mainFunction();
+  checkValue("Transparent remainder sent after RO", 3, HostSim_radioTxFrames - txFrames);
+  checkResult("Transparent stream unframed", stream, sizeof(stream), HostSim_uartTxCapture, HostSim_uartTxLength);
+  CC2530Bee_Config.APIMode = CC2530BEE_APIMODE_ESCAPED;
+}
+
+/**
+ * Runs main function until radio loopback of remote AT command request and
+ * response passed
+ */
+static void remoteATRun(void)
+{
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    CC2530Bee_mainFunction();
+  }
+}
+
+/**
+ * Remote AT commands: loopback peer is the node itself, so request is answered
+ * by own AT command handlers and response comes back via radio
+ */
+static void remoteATTests(void)
+{
+  uint8_t received[64];
+  uint16_t receivedLength;
+  uint32_t radioInits;
+  /* 16bit address like TX request, 64bit address if 0xfffe */
+  const uint8_t readCH16[] = { 0x17, 0x31, 0, 0, 0, 0, 0, 0, 0, 0, 0xaf, 0xfe, 0x00, 0x43, 0x48 };
+  const uint8_t readCH64[] = { 0x17, 0x32, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xfe, 0x00, 0x43, 0x48 };
+  const uint8_t writeCH[] = { 0x17, 0x33, 0, 0, 0, 0, 0, 0, 0, 0, 0xaf, 0xfe, 0x00, 0x43, 0x48, 0x14 };
+  const uint8_t applyCH[] = { 0x17, 0x34, 0, 0, 0, 0, 0, 0, 0, 0, 0xaf, 0xfe, UARTAPI_REMOTEAT_OPTIONS_APPLYCHANGES, 0x43, 0x48, CC2530BEE_Default_Channel };
+  const uint8_t readBroadcast[] = { 0x17, 0x35, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 0x00, 0x4d, 0x59 };
+  const uint8_t unknown[] = { 0x17, 0x36, 0, 0, 0, 0, 0, 0, 0, 0, 0xaf, 0xfe, 0x00, 0x5a, 0x5a };
+  const uint8_t scan[] = { 0x17, 0x37, 0, 0, 0, 0, 0, 0, 0, 0, 0xaf, 0xfe, 0x00, 0x45, 0x44 };
+  const uint8_t expectedCH[] = { 0x97, 0x31, 0, 0, 0, 0, 0, 0, 0, 0, 0xfe, 0xaf, 0x43, 0x48, 0, CC2530BEE_Default_Channel };
+  const uint8_t expectedCH64[] = { 0x97, 0x32, 0, 0, 0, 0, 0, 0, 0, 0, 0xfe, 0xaf, 0x43, 0x48, 0, CC2530BEE_Default_Channel };
+  const uint8_t expectedWrite[] = { 0x97, 0x33, 0, 0, 0, 0, 0, 0, 0, 0, 0xfe, 0xaf, 0x43, 0x48, 0 };
+  const uint8_t expectedApply[] = { 0x97, 0x34, 0, 0, 0, 0, 0, 0, 0, 0, 0xfe, 0xaf, 0x43, 0x48, 0 };
+  const uint8_t expectedMY[] = { 0x97, 0x35, 0, 0, 0, 0, 0, 0, 0, 0, 0xfe, 0xaf, 0x4d, 0x59, 0, 0xaf, 0xfe };
+  const uint8_t expectedUnknown[] = { 0x97, 0x36, 0, 0, 0, 0, 0, 0, 0, 0, 0xfe, 0xaf, 0x5a, 0x5a, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_CMD };
+  const uint8_t expectedScan[] = { 0x97, 0x37, 0, 0, 0, 0, 0, 0, 0, 0, 0xfe, 0xaf, 0x45, 0x44, UARTAPI_ATCOMMAND_RESPONSE_STATUS_ERROR };
+  const uint8_t tx[] = { 0x01, 0x00, 0xee, 0xee, 0x00, 0x12 };
+  const uint8_t readMY[] = { CC2530BEE_FRAME_TYPE_REMOTEAT, 0x17, 0x38, 0x00, 0x4d, 0x59 };
+  IEEE802154_DataFrameHeader_t header;
+  uint32_t txFrames;
+
+  sendFrame(readCH16, sizeof(readCH16));
+  remoteATRun();
+  receivedLength = receiveFrame(0, received);
+  checkResult("Remote read CH 16bit", expectedCH, sizeof(expectedCH), received, receivedLength);
+  checkValue("Remote no TX status", 0, receiveFrame(1, received));
+  sendFrame(readCH64, sizeof(readCH64));
+  remoteATRun();
+  receivedLength = receiveFrame(0, received);
+  checkResult("Remote read CH 64bit", expectedCH64, sizeof(expectedCH64), received, receivedLength);
+
+  /* without apply option parameter is only staged */
+  radioInits = HostSim_radioInitCount;
+  sendFrame(writeCH, sizeof(writeCH));
+  remoteATRun();
+  receivedLength = receiveFrame(0, received);
+  checkResult("Remote write CH", expectedWrite, sizeof(expectedWrite), received, receivedLength);
+  checkValue("Remote write CH staged", radioInits, HostSim_radioInitCount);
+  sendFrame(applyCH, sizeof(applyCH));
+  remoteATRun();
+  receivedLength = receiveFrame(0, received);
+  checkResult("Remote write CH apply", expectedApply, sizeof(expectedApply), received, receivedLength);
+  checkValue("Remote apply one radio init", radioInits + 1, HostSim_radioInitCount);
+  checkValue("Remote apply CH", CC2530BEE_Default_Channel, HostSim_radioConfig.Channel);
+
+  /* response to broadcast is sent after jitter */
+  sendFrame(readBroadcast, sizeof(readBroadcast));
+  remoteATRun();
+  checkValue("Remote broadcast jitter", 0, receiveFrame(0, received));
+  HostSim_advanceTime((uint32_t)CC2530BEE_REMOTEAT_JITTER * 1000000 / HOSTSIM_SLEEPTIMER_FREQUENCY + 1);
+  remoteATRun();
+  receivedLength = receiveFrame(0, received);
+  checkResult("Remote broadcast read MY", expectedMY, sizeof(expectedMY), received, receivedLength);
+
+  sendFrame(unknown, sizeof(unknown));
+  remoteATRun();
+  receivedLength = receiveFrame(0, received);
+  checkResult("Remote unknown command", expectedUnknown, sizeof(expectedUnknown), received, receivedLength);
+
+  /* ED only answers via UART */
+  sendFrame(scan, sizeof(scan));
+  remoteATRun();
+  receivedLength = receiveFrame(0, received);
+  checkResult("Remote ED", expectedScan, sizeof(expectedScan), received, receivedLength);
+  checkValue("Remote ED, no scan", CC2530BeeScan_Idle, CC2530Bee_scan.state);
+
+  /* response is queued behind TX request waiting for ACK and is retried
+   * like it, as peer does not acknowledge */
+  HostSim_radioLoopback = 0;
+  txFrames = HostSim_radioTxFrames;
+  sendFrame(tx, sizeof(tx));
+  for (uint8_t i = 0; (i < 10) && (CC2530Bee_radioTx.state != CC2530BeeRadioTx_WaitAck); i++)
+  {
+    CC2530Bee_mainFunction();
+  }
+  memset(&header, 0, sizeof(header));
+  header.fcf.frameType = IEEE802154_FCF_FRAME_TYPE_DATA;
+  header.fcf.reserved = CC2530BEE_FCF_RESERVED_CONTROL;
+  header.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.destinationPANID = CC2530BEE_Default_PanID;
+  header.destinationAddress.shortAddress = CC2530BEE_Default_ShortAddress;
+  header.sourceAddress.shortAddress = 0x4321;
+  header.sequenceNumber = 0x38;
+  HostSim_radioReceive(&header, readMY, sizeof(readMY), (sint8_t)0xd0);
+  CC2530Bee_mainFunction();
+  checkValue("Remote response waits for ACK wait", 1, HostSim_radioTxFrames - txFrames);
+  runFor(100);
+  checkValue("Remote response sent with retries", 2 * (1 + CC2530BEE_Default_MACRetries), HostSim_radioTxFrames - txFrames);
+  HostSim_radioLoopback = 1;
+}
+
+/**
+ * Power cycle: flash keeps its contents
+ */
+/**
+ * Reads runtime statistics via XS
+ */
+static void readStatistics(CC2530Bee_Statistics_t *statistics)
+{
+  const uint8_t request[] = { 0x08, 0x00, 0x58, 0x53 };
+  uint8_t received[256];
+  memset(statistics, 0xff, sizeof(CC2530Bee_Statistics_t));
+  sendFrame(request, sizeof(request));
+  if (receiveFrame(0, received) == UARTAPI_ATCOMMAND_RESPONSE_STATUS + 1 + sizeof(CC2530Bee_Statistics_t))
+  {
+    memcpy(statistics, &received[UARTAPI_ATCOMMAND_RESPONSE_STATUS + 1], sizeof(CC2530Bee_Statistics_t));
+  }
+}
+
+/**
+ * Statistics (XS, EA, EC) count frames per API identifier, errors and queue
+ * high-water marks, survive watchdog resets and are cleared by writing 0
+ */
+static void statisticsTests(void)
+{
+  CC2530Bee_Statistics_t statistics;
+  const uint8_t tx[] = { 0x01, 0x42, 0xee, 0xee, 0x00, 0x12 };
+  const uint8_t echo[] = { 0x44, 0x01 };
+  const uint8_t unknown[] = { 0x33, 0x01 };
+  const uint8_t *const messages[] = { tx, tx, tx };
+  const uint16_t lengths[] = { sizeof(tx), sizeof(tx), sizeof(tx) };
+  uint8_t frame[16];
+  uint8_t stream[32];
+  uint16_t frameLength;
+
+  CHECK("Write XS 1", FRAME(0x08, frameId, 0x58, 0x53, 1), 0, 0x88, frameId, 0x58, 0x53, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  CHECK("Write XS 2 bytes", FRAME(0x08, frameId, 0x58, 0x53, 0, 0), 0, 0x88, frameId, 0x58, 0x53, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  CHECK("Write XS 0", FRAME(0x08, frameId, 0x58, 0x53, 0), 0, 0x88, frameId, 0x58, 0x53, 0);
+  frameId++;
+  readStatistics(&statistics);
+  checkValue("XS after clear, AT commands", 1, statistics.uartRxATCommand);
+  checkValue("XS after clear, AT responses", 1, statistics.uartTxATResponse);
+  checkValue("XS after clear, radio frames", 0, statistics.radioTxFrames);
+
+  /* per API identifier and UART errors */
+  sendFrame(tx, sizeof(tx));
+  runFor(10);
+  sendFrame(echo, sizeof(echo));
+  sendFrame(unknown, sizeof(unknown));
+  frameLength = HostSim_encodeFrame(echo, sizeof(echo), frame);
+  frame[frameLength - 1] ^= 0x01;
+  memcpy(stream, frame, frameLength);
+  stream[frameLength] = UARTFrame_Delimiter;
+  stream[frameLength + 1] = 0x00;
+  stream[frameLength + 2] = 0x00;
+  HostSim_uartTxClear();
+  HostSim_setUartSource(stream, frameLength + 3);
+  runFor(1);
+  readStatistics(&statistics);
+  checkValue("XS, AT commands", 2, statistics.uartRxATCommand);
+  checkValue("XS, TX requests", 1, statistics.uartRxTxRequest);
+  checkValue("XS, echo frames", 1, statistics.uartRxEcho);
+  checkValue("XS, unknown frames", 1, statistics.uartRxUnknown);
+  checkValue("XS, checksum errors", 1, statistics.uartChecksumErrors);
+  checkValue("XS, length errors", 1, statistics.uartLengthErrors);
+  checkValue("XS, TX status", 1, statistics.uartTxStatus);
+  checkValue("XS, RX packets", 1, statistics.uartTxRxPacket);
+  checkValue("XS, radio TX frames", 1, statistics.radioTxFrames);
+  checkValue("XS, radio RX frames", 1, statistics.radioRxFrames);
+  checkValue("XS, TX queue high-water", 1, statistics.txQueueHighWater);
+  checkValue("XS, RX queue high-water", 1, statistics.rxQueueHighWater);
+
+  /* radio errors: no ACK, CRC error, busy channel. Without peer back-to-back
+   * TX requests wait in transmit queue. */
+  HostSim_radioLoopback = 0;
+  sendFrames(messages, lengths, 3);
+  runFor(150);
+  HostSim_radioLoopback = 1;
+  CHECK("Read EA", FRAME(0x08, frameId, 0x45, 0x41), 0, 0x88, frameId, 0x45, 0x41, 0, 0x00, 0x03);
+  HostSim_radioCrcErrors = 1;
+  sendFrame(tx, sizeof(tx));
+  runFor(50);
+  HostSim_radioCcaBusy = 1 + CC2530BEE_CSMA_MAX_BACKOFFS;
+  sendFrame(tx, sizeof(tx));
+  runFor(50);
+  CHECK("Read EC", FRAME(0x08, frameId, 0x45, 0x43), 0, 0x88, frameId, 0x45, 0x43, 0, 0x00, 0x01);
+  readStatistics(&statistics);
+  checkValue("XS, ACK timeouts", 3 * (1 + CC2530BEE_Default_MACRetries) + 1, statistics.ackTimeouts);
+  checkValue("XS, ACK failures", 3, statistics.ackFailures);
+  checkValue("XS, TX queue high-water 3", 3, statistics.txQueueHighWater);
+  checkValue("XS, CCA failures", 1, statistics.ccaFailures);
+  checkValue("XS, CRC errors", 1, statistics.radioCRCErrors);
+  CHECK("Write EA 0", FRAME(0x08, frameId, 0x45, 0x41, 0), 0, 0x88, frameId, 0x45, 0x41, 0);
+  CHECK("Read EA after clear", FRAME(0x08, frameId, 0x45, 0x41), 0, 0x88, frameId, 0x45, 0x41, 0, 0x00, 0x00);
+  CHECK("Read EC after EA clear", FRAME(0x08, frameId, 0x45, 0x43), 0, 0x88, frameId, 0x45, 0x43, 0, 0x00, 0x01);
+  frameId++;
+
+  /* kept across watchdog reset, cleared on power-on */
+  SLEEPSTA = SLEEPSTA_RST_WATCHDOGRESET;
+  CC2530Bee_init();
+  readStatistics(&statistics);
+  checkValue("XS after watchdog reset, resets", 1, statistics.watchdogResets);
+  checkValue("XS after watchdog reset, CCA failures", 1, statistics.ccaFailures);
+  checkValue("XS after watchdog reset, modem status", 1, statistics.uartTxModemStatus);
+  SLEEPSTA = SLEEPSTA_RST_POWERONRESET;
+  CC2530Bee_init();
+  readStatistics(&statistics);
+  checkValue("XS after power-on, resets", 0, statistics.watchdogResets);
+  checkValue("XS after power-on, CCA failures", 0, statistics.ccaFailures);
+}
+
+/**
+ * Sends trace dump request and copies trace points of dump to points
+ * @return number of entries in dump, 0xff if no dump was received
+ */
+static uint8_t traceDump(uint8_t *points, uint8_t *dropped)
+{
+  const uint8_t request[] = { UARTAPI_TRACE_DUMP_REQUEST, 0x01 };
+  uint8_t received[256];
+  uint16_t receivedLength;
+  uint8_t i;
+  sendFrame(request, sizeof(request));
+  receivedLength = receiveFrame(0, received);
+  if ((receivedLength < UARTAPI_TRACE_DUMP_ENTRIES) || (received[0] != UARTAPI_TRACE_DUMP) ||
+      (receivedLength != UARTAPI_TRACE_DUMP_ENTRIES + received[UARTAPI_TRACE_DUMP_COUNT] * sizeof(Trace_Entry_t)))
+  {
+    return 0xff;
+  }
+  for (i=0; i<received[UARTAPI_TRACE_DUMP_COUNT]; i++)
+  {
+    points[i] = received[UARTAPI_TRACE_DUMP_ENTRIES + i * sizeof(Trace_Entry_t)];
+  }
+  *dropped = received[UARTAPI_TRACE_DUMP_DROPPED];
+  return received[UARTAPI_TRACE_DUMP_COUNT];
+}
+
+/**
+ * Trace points of hot path stages are dumped oldest first and emptied by
+ * trace dump request. Without TRACE_ENABLE the dump stays empty.
+ */
+static void traceTests(void)
+{
+#ifdef TRACE_ENABLE
+  const uint8_t echo[] = { 0x44, 0x01 };
+  const uint8_t tx[] = { 0x01, 0x43, 0xee, 0xee, 0x00, 0x12 };
+  const uint8_t expectedEcho[] = { TRACE_UART_HEADER, TRACE_UART_FRAME, TRACE_DISPATCH, TRACE_UART_EMIT_START, TRACE_UART_EMIT_END,
+                                   TRACE_UART_HEADER, TRACE_UART_FRAME, TRACE_DISPATCH };
+  const uint8_t expectedTx[] = { TRACE_UART_HEADER, TRACE_UART_FRAME, TRACE_DISPATCH, TRACE_RADIO_TX_START, TRACE_RX_ENTRY, TRACE_RX_EXIT,
+                                 TRACE_ACK, TRACE_RADIO_TX_DONE, TRACE_UART_EMIT_START, TRACE_UART_EMIT_END };
+  uint8_t points[TRACE_NUM_ENTRIES];
+  uint8_t dropped;
+  uint8_t numEntries;
+  uint8_t i;
+
+  traceDump(points, &dropped);
+  numEntries = traceDump(points, &dropped);
+  checkValue("Trace dump of dump request", 3, numEntries);
+  checkValue("Trace dump, nothing dropped", 0, dropped);
+  sendFrame(echo, sizeof(echo));
+  numEntries = traceDump(points, &dropped);
+  checkResult("Trace echo", expectedEcho, sizeof(expectedEcho), points, (numEntries == 0xff) ? 0 : numEntries);
+  traceDump(points, &dropped);
+  sendFrame(tx, sizeof(tx));
+  runFor(10);
+  numEntries = traceDump(points, &dropped);
+  prefixLength = sizeof(expectedTx);
+  checkResult("Trace TX request, loopback", expectedTx, sizeof(expectedTx), points, (numEntries == 0xff) ? 0 : numEntries);
+  prefixLength = 0;
+
+  /* oldest entries are overwritten once ring is full */
+  traceDump(points, &dropped);
+  for (i=0; i<TRACE_NUM_ENTRIES / 4; i++)
+  {
+    sendFrame(echo, sizeof(echo));
+  }
+  numEntries = traceDump(points, &dropped);
+  checkValue("Trace full, entries", TRACE_NUM_ENTRIES, numEntries);
+  checkValue("Trace full, dropped", 5 * TRACE_NUM_ENTRIES / 4 + 3 - TRACE_NUM_ENTRIES, dropped);
+  checkValue("Trace full, newest last", TRACE_DISPATCH, points[TRACE_NUM_ENTRIES - 1]);
+#else
+  const uint8_t echo[] = { 0x44, 0x01 };
+  uint8_t points[TRACE_NUM_ENTRIES];
+  uint8_t dropped = 0xff;
+
+  sendFrame(echo, sizeof(echo));
+  checkValue("Trace disabled, empty dump", 0, traceDump(points, &dropped));
+  checkValue("Trace disabled, nothing dropped", 0, dropped);
+#endif
+}
+
+/**
+ * Sleep modes: module sleeps once idle, CTS holds back bytes from host until
+ * it is awake again
+ */
+static void sleepTests(void)
+{
+  uint8_t frame[16];
+  uint16_t frameLength;
+  const uint8_t readCH[] = { 0x08, 0x01, 0x43, 0x48 };
+  uint32_t wakeups;
+  uint32_t radioInits;
+  uint64_t sleepStart;
+
+  CHECK("Read SM", FRAME(0x08, frameId, 0x53, 0x4d), 0, 0x88, frameId, 0x53, 0x4d, 0, CC2530BEE_Default_SleepMode);
+  CHECK("Read SP", FRAME(0x08, frameId, 0x53, 0x50), 0, 0x88, frameId, 0x53, 0x50, 0,
+        HI_UINT16(CC2530BEE_Default_SleepPeriod), LO_UINT16(CC2530BEE_Default_SleepPeriod));
+  CHECK("Read ST", FRAME(0x08, frameId, 0x53, 0x54), 0, 0x88, frameId, 0x53, 0x54, 0,
+        HI_UINT16(CC2530BEE_Default_TimeBeforeSleep), LO_UINT16(CC2530BEE_Default_TimeBeforeSleep));
+  CHECK("Write SM out of range", FRAME(0x08, frameId, 0x53, 0x4d, CC2530BEE_SLEEPMODE_CYCLIC_PIN + 1), 0,
+        0x88, frameId, 0x53, 0x4d, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  frameId++;
+
+  /* cyclic sleep: SP 100 ms, ST 10 ms */
+  CHECK("Write SP", FRAME(0x08, frameId, 0x53, 0x50, 0, 10), 0, 0x88, frameId, 0x53, 0x50, 0);
+  CHECK("Write ST", FRAME(0x08, frameId, 0x53, 0x54, 0, 10), 0, 0x88, frameId, 0x53, 0x54, 0);
+  CHECK("Write SM cyclic", FRAME(0x08, frameId, 0x53, 0x4d, CC2530BEE_SLEEPMODE_CYCLIC), 0, 0x88, frameId, 0x53, 0x4d, 0);
+  frameId++;
+  /* bytes of previous tests still count as being sent */
+  HostSim_uartTxDrain();
+  sendFrame(readCH, sizeof(readCH));
+  runFor(5);
+  checkValue("Cyclic sleep, awake during ST", 0, CC2530Bee_sleep.asleep);
+  for (uint8_t i = 0; (i < 10) && !CC2530Bee_sleep.asleep; i++)
+  {
+    runFor(1);
+  }
+  checkValue("Cyclic sleep, asleep after ST", 1, CC2530Bee_sleep.asleep);
+  checkValue("Cyclic sleep, CTS deasserted", CC2530BEE_CTS_DEASSERTED, CC2530BEE_CTS_PIN);
+  sleepStart = HostSim_time();
+  radioInits = HostSim_radioInitCount;
+  frameLength = HostSim_encodeFrame(readCH, sizeof(readCH), frame);
+  HostSim_uartTxClear();
+  HostSim_setUartSource(frame, frameLength);
+  CC2530Bee_mainFunction();
+  checkValue("Cyclic sleep, bytes held back", frameLength, HostSim_uartRxPending());
+  do {
+    CC2530Bee_mainFunction();
+  } while (HostSim_uartRxPending() > 0);
+  checkValue("Cyclic sleep, woken after SP", 1, HostSim_uartRxFirstNs - sleepStart >= 90000000ull);
+  checkValue("Cyclic sleep, UART ready on wake", 1, HostSim_uartRxFirstNs - HostSim_wakeNs <= HOSTSIM_WAKEUP_PM2_NS);
+  checkValue("Cyclic sleep, radio restarted", 1, HostSim_radioInitCount - radioInits);
+  checkValue("Cyclic sleep, CTS asserted", CC2530BEE_CTS_ASSERTED, CC2530BEE_CTS_PIN);
+  checkValue("Cyclic sleep, AT response", 0x88, HostSim_uartTxCapture[3]);
+  checkValue("Cyclic sleep, no bytes lost", 0, HostSim_uartRxLost);
+
+  /* host ignoring CTS loses bytes sent while module sleeps */
+  HostSim_uartTxDrain();
+  for (uint8_t i = 0; (i < 20) && !CC2530Bee_sleep.asleep; i++)
+  {
+    runFor(1);
+  }
+  HostSim_uartFlowControl = 0;
+  HostSim_setUartSource(frame, frameLength);
+  CC2530Bee_mainFunction();
+  checkValue("No flow control, bytes lost", frameLength, HostSim_uartRxLost);
+  HostSim_uartFlowControl = 1;
+  HostSim_uartRxLost = 0;
+
+  /* pin sleep: sleeps while SLEEP_RQ is high, checks pin every poll interval */
+  CHECK("Write SM pin hibernate", FRAME(0x08, frameId, 0x53, 0x4d, CC2530BEE_SLEEPMODE_PIN_HIBERNATE), 0, 0x88, frameId, 0x53, 0x4d, 0);
+  frameId++;
+  CC2530BEE_SLEEPRQ_PIN = 1;
+  runFor(5);
+  checkValue("Pin hibernate, asleep", 1, CC2530Bee_sleep.asleep);
+  checkValue("Pin hibernate, PM2", SLEEPCMD_MODE_PM2, CC2530Bee_sleep.powerMode);
+  wakeups = HostSim_wakeups;
+  sleepStart = HostSim_time();
+  for (uint8_t i = 0; i < 10; i++)
+  {
+    CC2530Bee_mainFunction();
+  }
+  checkValue("Pin hibernate, wake-ups", 10, HostSim_wakeups - wakeups);
+  checkValue("Pin hibernate, poll interval", 1, HostSim_time() - sleepStart <=
+             10 * CC2530BEE_PINSLEEP_POLL_TICKS * 1000000000ull / HOSTSIM_SLEEPTIMER_FREQUENCY);
+  CC2530BEE_SLEEPRQ_PIN = 0;
+  CC2530Bee_mainFunction();
+  checkValue("Pin hibernate, awake", 0, CC2530Bee_sleep.asleep);
+  CHECK("Write SM pin doze", FRAME(0x08, frameId, 0x53, 0x4d, CC2530BEE_SLEEPMODE_PIN_DOZE), 0, 0x88, frameId, 0x53, 0x4d, 0);
+  frameId++;
+  CC2530BEE_SLEEPRQ_PIN = 1;
+  runFor(5);
+  checkValue("Pin doze, PM1", SLEEPCMD_MODE_PM1, CC2530Bee_sleep.powerMode);
+  CC2530BEE_SLEEPRQ_PIN = 0;
+
+  /* wakes on first byte of frame, so no sleep before writing SM 0 */
+  CHECK("Write SM none", FRAME(0x08, frameId, 0x53, 0x4d, CC2530BEE_SLEEPMODE_NONE), 0, 0x88, frameId, 0x53, 0x4d, 0);
+  CHECK("Write SP default", FRAME(0x08, frameId, 0x53, 0x50,
+        HI_UINT16(CC2530BEE_Default_SleepPeriod), LO_UINT16(CC2530BEE_Default_SleepPeriod)), 0, 0x88, frameId, 0x53, 0x50, 0);
+  CHECK("Write ST default", FRAME(0x08, frameId, 0x53, 0x54,
+        HI_UINT16(CC2530BEE_Default_TimeBeforeSleep), LO_UINT16(CC2530BEE_Default_TimeBeforeSleep)), 0, 0x88, frameId, 0x53, 0x54, 0);
+  frameId++;
+  runFor(20);
+  checkValue("No sleep", 0, CC2530Bee_sleep.asleep);
+}
+
+static void reboot(void)
+{
+  HostSim_reset();
+  CC2530Bee_init();
+}
+
+/**
+ * Energy scan (ED) samples each channel of SC for 2^SD * 15.36 ms, UART is
+ * served and radio frames are held back meanwhile. With A2 the quietest
+ * channel is used after boot.
+ */
+static void scanTests(void)
+{
+  uint8_t received[64];
+  uint16_t receivedLength;
+  uint32_t radioTxFrames;
+  const uint8_t scan[] = { 0x08, 0x51, 0x45, 0x44 };
+  const uint8_t tx[] = { 0x01, 0x52, 0xee, 0xee, 0x00, 0x12 };
+  const uint8_t expectedScan[] = { 0x88, 0x51, 0x45, 0x44, 0, 100, 40, 100, 60 };
+  uint8_t i;
+
+  CHECK("Read SC", FRAME(0x08, frameId, 0x53, 0x43), 0, 0x88, frameId, 0x53, 0x43, 0,
+        HI_UINT16(CC2530BEE_Default_ScanChannels), LO_UINT16(CC2530BEE_Default_ScanChannels));
+  CHECK("Read SD", FRAME(0x08, frameId, 0x53, 0x44), 0, 0x88, frameId, 0x53, 0x44, 0, CC2530BEE_Default_ScanDuration);
+  CHECK("Read A2", FRAME(0x08, frameId, 0x41, 0x32), 0, 0x88, frameId, 0x41, 0x32, 0, CC2530BEE_Default_CoordinatorAssociation);
+  CHECK("Write SD out of range", FRAME(0x08, frameId, 0x53, 0x44, CC2530BEE_SCANDURATION_LAST + 1), 0,
+        0x88, frameId, 0x53, 0x44, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  CHECK("ED with parameter", FRAME(0x08, frameId, 0x45, 0x44, 0), 0, 0x88, frameId, 0x45, 0x44, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  /* channels 11 to 14 for 15.36 ms each */
+  CHECK("Write SC", FRAME(0x08, frameId, 0x53, 0x43, 0x00, 0x0f), 0, 0x88, frameId, 0x53, 0x43, 0);
+  CHECK("Write SD", FRAME(0x08, frameId, 0x53, 0x44, 0), 0, 0x88, frameId, 0x53, 0x44, 0);
+  frameId++;
+  HostSim_radioEnergy[12 - CC2530BEE_CHANNEL_FIRST] = -40;
+  HostSim_radioEnergy[14 - CC2530BEE_CHANNEL_FIRST] = -60;
+  sendFrame(scan, sizeof(scan));
+  checkValue("ED, no response yet", 0, receiveFrame(0, received));
+  checkValue("ED, tuned to channel 11", 11, FREQCTRL);
+  runFor(20);
+  checkValue("ED, tuned to channel 12", 16, FREQCTRL);
+  radioTxFrames = HostSim_radioTxFrames;
+  sendFrame(tx, sizeof(tx));
+  CHECK("ED, UART served during scan", FRAME(0x44, frameId, 0xff), 0, 0x44, frameId, 0xff);
+  CHECK("ED while scanning", FRAME(0x08, frameId, 0x45, 0x44), 0, 0x88, frameId, 0x45, 0x44, UARTAPI_ATCOMMAND_RESPONSE_STATUS_ERROR);
+  checkValue("ED, TX held back", radioTxFrames, HostSim_radioTxFrames);
+  checkValue("ED, not idle", 0, CC2530Bee_isIdle());
+  runFor(60);
+  receivedLength = receiveLastFrame(0x88, received);
+  checkResult("ED response", expectedScan, sizeof(expectedScan), received, receivedLength);
+  checkValue("ED, TX sent after scan", radioTxFrames + 1, HostSim_radioTxFrames);
+  checkValue("ED, tuned to CH again", 11 + 5 * (CC2530Bee_Config.IEEE802154_config.Channel - 11), FREQCTRL);
+
+  /* A2: quietest channel of SC is used after boot */
+  for (i=0; i<HOSTSIM_NUM_CHANNELS; i++)
+  {
+    HostSim_radioEnergy[i] = -50;
+  }
+  HostSim_radioEnergy[20 - CC2530BEE_CHANNEL_FIRST] = -95;
+  CHECK("Write SC all", FRAME(0x08, frameId, 0x53, 0x43, 0xff, 0xff), 0, 0x88, frameId, 0x53, 0x43, 0);
+  CHECK("Write A2", FRAME(0x08, frameId, 0x41, 0x32, CC2530BEE_A2_REASSIGN_CHANNEL), 0, 0x88, frameId, 0x41, 0x32, 0);
+  CHECK("WR", FRAME(0x08, frameId, 0x57, 0x52), 0, 0x88, frameId, 0x57, 0x52, 0);
+  frameId++;
+  reboot();
+  runFor(16 * 16 + 10);
+  checkValue("A2, no ED response", 0, receiveLastFrame(0x88, received));
+  CHECK("A2, CH reassigned", FRAME(0x08, frameId, 0x43, 0x48), 0, 0x88, frameId, 0x43, 0x48, 0, 20);
+  checkValue("A2, radio on reassigned channel", 20, HostSim_radioConfig.Channel);
+
+  for (i=0; i<HOSTSIM_NUM_CHANNELS; i++)
+  {
+    HostSim_radioEnergy[i] = HOSTSIM_NOISE_FLOOR;
+  }
+  HostSim_flashEraseAll();
+  reboot();
+}
+
+/**
+ * Neighbour table (LQ, 0x46) keeps smoothed RSSI, sequence gaps and ACK
+ * outcomes per neighbour, the least recently seen one is replaced
+ */
+static void neighbourTests(void)
+{
+  IEEE802154_DataFrameHeader_t header;
+  const uint8_t payload[] = { 0x01, 0x02 };
+  const uint8_t sequence[] = { 1, 2, 3, 6 };
+  const uint8_t tx[] = { 0x01, 0x61, LO_UINT16(0x1234), HI_UINT16(0x1234), 0x00, 0x55 };
+  const uint8_t readEntry[] = { 0x08, 0x62, 0x4c, 0x51, 0 };
+  const uint8_t table[] = { 0x46, 0x63 };
+  const uint8_t expectedEntry[] = { 0x88, 0x62, 0x4c, 0x51, 0, IEEE802154_FCF_ADDRESS_MODE_16BIT, 0, 0, 0, 0, 0, 0, 0x12, 0x34, (uint8_t)-47 };
+  const uint8_t expected64[] = { IEEE802154_FCF_ADDRESS_MODE_64BIT, 1, 2, 3, 4, 5, 6, 7, 8 };
+  const uint8_t *entry = &HostSim_uartTxCapture[0];
+  uint8_t received[256];
+  uint16_t receivedLength;
+  uint16_t age;
+  uint8_t i;
+
+  CHECK("LQ empty", FRAME(0x08, frameId, 0x4c, 0x51), 0, 0x88, frameId, 0x4c, 0x51, 0, 0);
+  CHECK("LQ index out of range", FRAME(0x08, frameId, 0x4c, 0x51, 0), 0, 0x88, frameId, 0x4c, 0x51, UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  frameId++;
+
+  /* frames 4 and 5 are missing, RSSI is smoothed */
+  memset(&header, 0, sizeof(header));
+  header.fcf.frameType = IEEE802154_FCF_FRAME_TYPE_DATA;
+  header.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.destinationPANID = CC2530BEE_Default_PanID;
+  header.destinationAddress.shortAddress = IEEE802154_BROADCAST_ADDRESS_16BIT;
+  header.sourceAddress.shortAddress = 0x1234;
+  for (i=0; i<sizeof(sequence); i++)
+  {
+    header.sequenceNumber = sequence[i];
+    HostSim_radioReceive(&header, payload, sizeof(payload), (i < 3) ? -50 : -30);
+    CC2530Bee_mainFunction();
+  }
+  /* first ACK is lost, frame is sent twice */
+  HostSim_radioAckLoss = 1;
+  sendFrame(tx, sizeof(tx));
+  runFor(50);
+  CHECK("LQ two neighbours", FRAME(0x08, frameId, 0x4c, 0x51), 0, 0x88, frameId, 0x4c, 0x51, 0, 2);
+  sendFrame(readEntry, sizeof(readEntry));
+  receivedLength = receiveFrame(0, received);
+  prefixLength = sizeof(expectedEntry);
+  checkResult("LQ entry", expectedEntry, sizeof(expectedEntry), received, receivedLength);
+  prefixLength = 0;
+  entry = &received[UARTAPI_ATCOMMAND_RESPONSE_DATA];
+  checkValue("LQ length", UARTAPI_ATCOMMAND_RESPONSE_DATA + NEIGHBOUR_ENTRY_LENGTH, receivedLength);
+  checkValue("LQ frames received", 4, entry[NEIGHBOUR_ENTRY_RXFRAMES] << 8 | entry[NEIGHBOUR_ENTRY_RXFRAMES + 1]);
+  checkValue("LQ frames lost", 2, entry[NEIGHBOUR_ENTRY_RXLOST] << 8 | entry[NEIGHBOUR_ENTRY_RXLOST + 1]);
+  checkValue("LQ frames sent", 2, entry[NEIGHBOUR_ENTRY_TXFRAMES] << 8 | entry[NEIGHBOUR_ENTRY_TXFRAMES + 1]);
+  checkValue("LQ ACKs", 1, entry[NEIGHBOUR_ENTRY_TXACKED] << 8 | entry[NEIGHBOUR_ENTRY_TXACKED + 1]);
+  age = entry[NEIGHBOUR_ENTRY_AGE] << 8 | entry[NEIGHBOUR_ENTRY_AGE + 1];
+  runFor(100);
+  sendFrame(readEntry, sizeof(readEntry));
+  receiveFrame(0, received);
+  checkValue("LQ age", 1, ((entry[NEIGHBOUR_ENTRY_AGE] << 8 | entry[NEIGHBOUR_ENTRY_AGE + 1]) - age) >= 100 &&
+                          ((entry[NEIGHBOUR_ENTRY_AGE] << 8 | entry[NEIGHBOUR_ENTRY_AGE + 1]) - age) < 110);
+
+  /* age is clamped once it exceeds 0xffff ms, here 0x500000 ticks (160 s) */
+  HostSim_advanceTime((uint64_t)0x500000 * 1000000 / HOSTSIM_SLEEPTIMER_FREQUENCY);
+  sendFrame(readEntry, sizeof(readEntry));
+  receiveFrame(0, received);
+  checkValue("LQ age clamped", 0xffff, entry[NEIGHBOUR_ENTRY_AGE] << 8 | entry[NEIGHBOUR_ENTRY_AGE + 1]);
+
+  /* age does not wrap around with sleep timer */
+  HostSim_advanceTime(300000000);
+  CC2530Bee_mainFunction();
+  sendFrame(readEntry, sizeof(readEntry));
+  receiveFrame(0, received);
+  checkValue("LQ age stale", 0xffff, entry[NEIGHBOUR_ENTRY_AGE] << 8 | entry[NEIGHBOUR_ENTRY_AGE + 1]);
+
+  /* table full, stale entry is replaced first */
+  header.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_64BIT;
+  for (i=0; i<sizeof(IEEE802154_ExtendedAddress_t); i++)
+  {
+    header.sourceAddress.extendedAdress[i] = i + 1;
+  }
+  HostSim_radioReceive(&header, payload, sizeof(payload), -50);
+  header.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  for (i=0; i<NEIGHBOUR_NUM_ENTRIES - 3; i++)
+  {
+    CC2530Bee_mainFunction();
+    header.sourceAddress.shortAddress = 0x2000 + i;
+    HostSim_radioReceive(&header, payload, sizeof(payload), -50);
+  }
+  CC2530Bee_mainFunction();
+  CHECK("LQ full", FRAME(0x08, frameId, 0x4c, 0x51), 0, 0x88, frameId, 0x4c, 0x51, 0, NEIGHBOUR_NUM_ENTRIES);
+  sendFrame(table, sizeof(table));
+  receivedLength = receiveFrame(0, received);
+  checkValue("Neighbour table length", UARTAPI_NEIGHBOUR_TABLE_ENTRIES + NEIGHBOUR_NUM_ENTRIES * NEIGHBOUR_ENTRY_LENGTH, receivedLength);
+  checkValue("Neighbour table count", NEIGHBOUR_NUM_ENTRIES, received[UARTAPI_NEIGHBOUR_TABLE_COUNT]);
+  checkResult("Neighbour table 64bit entry", expected64, sizeof(expected64),
+              &received[UARTAPI_NEIGHBOUR_TABLE_ENTRIES + 2 * NEIGHBOUR_ENTRY_LENGTH], sizeof(expected64));
+  header.sourceAddress.shortAddress = 0x3000;
+  HostSim_radioReceive(&header, payload, sizeof(payload), -50);
+  CC2530Bee_mainFunction();
+  CHECK_PREFIX("LQ stale entry replaced", FRAME(0x08, frameId, 0x4c, 0x51, 0), 0, 0x88, frameId, 0x4c, 0x51, 0,
+               IEEE802154_FCF_ADDRESS_MODE_16BIT, 0, 0, 0, 0, 0, 0, 0x30, 0x00);
+  frameId++;
+}
+
+/**
+ * Copies of a frame (same source and sequence number) received within DW
+ * are dropped in interrupt context and counted
+ */
+static void duplicateTests(void)
+{
+  IEEE802154_DataFrameHeader_t header;
+  CC2530Bee_Statistics_t statistics;
+  const uint8_t payload[] = { 0xaa };
+  const uint8_t expected16[] = { 0x81, 0x43, 0x21, 0xd0, 0x00, 0xaa };
+  const uint8_t tx[] = { 0x01, 0x62, LO_UINT16(0x1234), HI_UINT16(0x1234), 0x00, 0x55 };
+  const uint8_t expectedStatus[] = { 0x89, 0x62, UARTAPI_TX_STATUS_SUCCESS };
+  uint8_t received[256];
+  uint16_t receivedLength;
+  uint16_t duplicates;
+  uint16_t rxPackets;
+  uint8_t *taken[FRAMEPOOL_NUM_BUFFERS];
+  uint8_t n;
+
+  CHECK("Read DW", FRAME(0x08, frameId, 0x44, 0x57), 0, 0x88, frameId, 0x44, 0x57, 0,
+        HI_UINT16(CC2530BEE_Default_DuplicateWindow), LO_UINT16(CC2530BEE_Default_DuplicateWindow));
+  frameId++;
+  readStatistics(&statistics);
+  duplicates = statistics.radioRxDuplicates;
+
+  memset(&header, 0, sizeof(header));
+  header.fcf.frameType = IEEE802154_FCF_FRAME_TYPE_DATA;
+  header.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.destinationPANID = CC2530BEE_Default_PanID;
+  header.destinationAddress.shortAddress = CC2530BEE_Default_ShortAddress;
+  header.sourceAddress.shortAddress = 0x4321;
+  header.sequenceNumber = 10;
+  HostSim_uartTxClear();
+  HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  runFor(10);
+  receivedLength = receiveFrame(0, received);
+  checkResult("Duplicate, first copy", expected16, sizeof(expected16), received, receivedLength);
+  checkValue("Duplicate, second copy dropped", 0, receiveFrame(1, received));
+  readStatistics(&statistics);
+  checkValue("Duplicate, counted", duplicates + 1, statistics.radioRxDuplicates);
+
+  /* same sequence number from another source, from same source after DW */
+  HostSim_uartTxClear();
+  header.sourceAddress.shortAddress = 0x4322;
+  HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  runFor(10);
+  checkValue("Duplicate, other source", 0x81, receiveLastFrame(0x81, received) ? received[0] : 0);
+  HostSim_uartTxClear();
+  header.sourceAddress.shortAddress = 0x4321;
+  HostSim_advanceTime(1000ull * (CC2530BEE_Default_DuplicateWindow + 1));
+  HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  runFor(10);
+  receivedLength = receiveLastFrame(0x81, received);
+  checkResult("Duplicate, after DW", expected16, sizeof(expected16), received, receivedLength);
+
+  /* retransmission after lost ACK is received once */
+  readStatistics(&statistics);
+  rxPackets = statistics.uartTxRxPacket;
+  HostSim_radioAckLoss = 1;
+  sendFrame(tx, sizeof(tx));
+  runFor(50);
+  receivedLength = receiveLastFrame(0x89, received);
+  checkResult("Duplicate, retransmission TX status", expectedStatus, sizeof(expectedStatus), received, receivedLength);
+  readStatistics(&statistics);
+  checkValue("Duplicate, retransmission dropped", duplicates + 2, statistics.radioRxDuplicates);
+  checkValue("Duplicate, retransmission one RX packet", rxPackets + 1, statistics.uartTxRxPacket);
+
+  /* frame lost as frame pool is exhausted is not recorded, its retransmission is passed on */
+  HostSim_uartTxClear();
+  header.sequenceNumber++;
+  for (n = 0; (taken[n] = FramePool_alloc()) != NULL; n++)
+  {
+  }
+  HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  while (n > 0)
+  {
+    FramePool_release(taken[--n]);
+  }
+  HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  runFor(10);
+  receivedLength = receiveLastFrame(0x81, received);
+  checkResult("Duplicate, retransmission of lost frame", expected16, sizeof(expected16), received, receivedLength);
+
+  /* entry recorded from interrupt after main loop read the sleep timer is kept */
+  Duplicate_record(IEEE802154_FCF_ADDRESS_MODE_16BIT, 0x4321, NULL, 0x77, 1000);
+  Duplicate_poll(990);
+  checkValue("Duplicate, entry newer than poll kept", 1, Duplicate_check(IEEE802154_FCF_ADDRESS_MODE_16BIT, 0x4321, NULL, 0x77, 1001));
+
+  /* DW 0 disables suppression */
+  CHECK("Write DW 0", FRAME(0x08, frameId, 0x44, 0x57, 0, 0), 0, 0x88, frameId, 0x44, 0x57, 0);
+  HostSim_uartTxClear();
+  header.sequenceNumber++;
+  HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  runFor(10);
+  checkValue("Duplicate, DW 0 passes copies", 1, receiveFrame(1, received) > 0);
+  CHECK("Write DW", FRAME(0x08, frameId, 0x44, 0x57, HI_UINT16(CC2530BEE_Default_DuplicateWindow),
+        LO_UINT16(CC2530BEE_Default_DuplicateWindow)), 0, 0x88, frameId, 0x44, 0x57, 0);
+  frameId++;
+}
+
+/**
+ * Gets n-th capture record sent by firmware since last sendFrame or
+ * HostSim_uartTxClear, bytes between records are skipped
+ * @return record length including marker and checksum, 0 if no such record exists
+ */
+static uint16_t receiveRecord(uint8_t n, uint8_t *record)
+{
+  uint32_t offset = 0;
+  uint16_t length;
+  uint8_t sum;
+  while (offset + SNIFFER_RECORD_OVERHEAD <= HostSim_uartTxLength)
+  {
+    length = SNIFFER_RECORD_OVERHEAD + (HostSim_uartTxCapture[offset + SNIFFER_RECORD_LENGTH] & SNIFFER_LENGTH_MASK);
+    sum = 0;
+    for (uint16_t i = 1; (i < length) && (offset + i < HostSim_uartTxLength); i++)
+    {
+      sum += HostSim_uartTxCapture[offset + i];
+    }
+    if ((HostSim_uartTxCapture[offset] != SNIFFER_RECORD_MARKER) || (offset + length > HostSim_uartTxLength) || (sum != 0xff))
+    {
+      offset++;
+      continue;
+    }
+    if (n-- == 0)
+    {
+      memcpy(record, &HostSim_uartTxCapture[offset], length);
+      return length;
+    }
+    offset += length;
+  }
+  return 0;
+}
+
+/**
+ * Sniffer mode (SN) turns off frame filtering and streams every frame as
+ * capture record instead of RX packet
+ */
+static void snifferTests(void)
+{
+  CC2530Bee_Statistics_t statistics;
+  /* data frame from 0x1111 to 0x5555 of PAN 0x3332, PAN ID compression */
+  const uint8_t data[] = { 0x41, 0x88, 0x17, 0x32, 0x33, 0x55, 0x55, 0x11, 0x11, 0xde, 0xad };
+  /* beacon of 0x1111 and MAC command from 64bit address to coordinator */
+  const uint8_t beacon[] = { 0x00, 0x80, 0x18, 0x32, 0x33, 0x11, 0x11, 0xff, 0xcf, 0x00, 0x00 };
+  const uint8_t command[] = { 0x23, 0xc8, 0x19, 0x32, 0x33, 0x00, 0x00, 0xff, 0xff, 1, 2, 3, 4, 5, 6, 7, 8, 0x01, 0x8e };
+  uint8_t record[256];
+  uint16_t recordLength;
+  uint16_t overflows;
+  uint8_t i;
+
+  CHECK("Read SN", FRAME(0x08, frameId, 0x53, 0x4e), 0, 0x88, frameId, 0x53, 0x4e, 0, CC2530BEE_Default_SnifferMode);
+  CHECK("Write SN out of range", FRAME(0x08, frameId, 0x53, 0x4e, 2), 0, 0x88, frameId, 0x53, 0x4e,
+        UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM);
+  frameId++;
+  HostSim_uartTxClear();
+  HostSim_radioReceiveFrame(data, sizeof(data), -60, 1);
+  runFor(10);
+  checkValue("SN 0, frame to other node filtered", 0, HostSim_uartTxLength);
+
+  CHECK("Write SN", FRAME(0x08, frameId, 0x53, 0x4e, CC2530BEE_SNIFFERMODE_ON), 0, 0x88, frameId, 0x53, 0x4e, 0);
+  frameId++;
+  checkValue("SN 1, frame filtering off", 0, FRMFILT0 & CC2530BEE_FRMFILT0_FRM_FILTER_EN);
+  checkValue("SN 1, automatic ACK off", 0, FRMCTRL0 & CC2530BEE_FRMCTRL0_AUTOACK);
+  HostSim_uartTxClear();
+  HostSim_radioReceiveFrame(data, sizeof(data), -60, 1);
+  HostSim_radioReceiveFrame(data, sizeof(data), -90, 0);
+  HostSim_radioReceiveFrame(beacon, sizeof(beacon), -60, 1);
+  HostSim_radioReceiveFrame(command, sizeof(command), -60, 1);
+  runFor(20);
+  checkValue("SN 1, no RX packet", 0, receiveLastFrame(0x81, record));
+  recordLength = receiveRecord(0, record);
+  checkValue("SN 1, record length", SNIFFER_RECORD_OVERHEAD + sizeof(data), recordLength);
+  checkValue("SN 1, record CRC ok", SNIFFER_LENGTH_CRC_OK | sizeof(data), record[SNIFFER_RECORD_LENGTH]);
+  checkValue("SN 1, record RSSI", (uint8_t)-60, record[SNIFFER_RECORD_RSSI]);
+  checkValue("SN 1, record LQI", (-60 - SNIFFER_LQI_FLOOR) * SNIFFER_LQI_SCALE, record[SNIFFER_RECORD_LQI]);
+  checkResult("SN 1, record PSDU", data, sizeof(data), &record[SNIFFER_RECORD_PSDU], recordLength - SNIFFER_RECORD_OVERHEAD);
+  recordLength = receiveRecord(1, record);
+  checkValue("SN 1, CRC error record", sizeof(data), record[SNIFFER_RECORD_LENGTH]);
+  checkValue("SN 1, CRC error LQI", (-90 - SNIFFER_LQI_FLOOR) * SNIFFER_LQI_SCALE, record[SNIFFER_RECORD_LQI]);
+  recordLength = receiveRecord(2, record);
+  checkResult("SN 1, beacon record", beacon, sizeof(beacon), &record[SNIFFER_RECORD_PSDU], recordLength - SNIFFER_RECORD_OVERHEAD);
+  recordLength = receiveRecord(3, record);
+  checkResult("SN 1, MAC command record", command, sizeof(command), &record[SNIFFER_RECORD_PSDU],
+              recordLength - SNIFFER_RECORD_OVERHEAD);
+
+  /* burst while main loop is busy: records which do not fit are dropped whole */
+  readStatistics(&statistics);
+  overflows = statistics.snifferOverflows;
+  HostSim_uartTxClear();
+  for (i=0; i<SNIFFER_BUFFER_SIZE / (SNIFFER_RECORD_OVERHEAD + sizeof(data)) + 2; i++)
+  {
+    HostSim_radioReceiveFrame(data, sizeof(data), -60, 1);
+  }
+  runFor(100);
+  for (i=0; receiveRecord(i, record) > 0; i++)
+  {
+  }
+  checkValue("SN 1, burst records", SNIFFER_BUFFER_SIZE / (SNIFFER_RECORD_OVERHEAD + sizeof(data)), i);
+  readStatistics(&statistics);
+  checkValue("SN 1, burst overflow counted", overflows + 2, statistics.snifferOverflows);
+
+  CHECK("Write SN 0", FRAME(0x08, frameId, 0x53, 0x4e, CC2530BEE_SNIFFERMODE_OFF), 0, 0x88, frameId, 0x53, 0x4e, 0);
+  frameId++;
+  checkValue("SN 0, frame filtering on", CC2530BEE_FRMFILT0_FRM_FILTER_EN, FRMFILT0 & CC2530BEE_FRMFILT0_FRM_FILTER_EN);
+}
+
+/**
+ * WR stores configuration in flash, RE only restores defaults in RAM
+ */
+/**
+ * USART via DMA: frames larger than DMA rx buffer and tx ring pass, tx ring is
+ * sent in several blocks, rx words are marked read and rx still works after
+ * U0BAUD changed with BD
+ */
+static void dmaTests(void)
+{
+  uint8_t echo[3 + 250];
+  uint8_t received[512];
+  uint8_t bd[] = { 0x08, 0x00, 0x42, 0x44, 0x00 };
+  uint8_t pending[] = { 0x44, 0x00, 0x15, 0x7e };
+  const uint8_t baudrates[] = { 3, 6 };
+  const uint8_t baudMarks[] = { 59, 216 };
+  uint8_t stream[64];
+  uint16_t streamLength;
+  uint8_t n;
+  uint8_t i;
+  uint16_t receivedLength;
+  uint32_t interrupts;
+
+  checkValue("DMA, USART rx interrupt off", 0, URX0IE);
+  checkValue("DMA, USART tx interrupt off", 0, IEN2 & UARTDMA_IEN2_UTX0IE);
+  checkValue("DMA, rx channel armed", 1, DMA_isArmed(UARTDMA_CHANNEL_RX));
+
+  /* every payload byte is escaped, thus frame takes twice the payload length on wire */
+  echo[0] = 0x44;
+  echo[1] = frameId;
+  memset(&echo[2], UARTFrame_Delimiter, sizeof(echo) - 2);
+  interrupts = HostSim_dmaInterrupts;
+  sendFrame(echo, sizeof(echo));
+  receivedLength = receiveFrame(0, received);
+  checkResult("DMA, echo larger than buffers", echo, sizeof(echo), received, receivedLength);
+  checkValue("DMA, tx ring sent in blocks", 1, (HostSim_dmaInterrupts - interrupts) >= 2);
+  checkValue("DMA, tx channel idle", 0, DMA_isArmed(UARTDMA_CHANNEL_TX));
+  checkValue("DMA, rx buffer read", 0, HostSim_uartRxPending());
+  HostSim_uartTxDrain();
+  checkValue("DMA, tx ring empty", 0, UartDma_numBytesInTxBuffer());
+  frameId++;
+
+  CHECK("DMA, write BD 9600", FRAME(0x08, frameId, 0x42, 0x44, 3), 0, 0x88, frameId, 0x42, 0x44, 0);
+  HostSim_uartTxDrain();
+  CC2530Bee_mainFunction();
+  checkValue("DMA, BD 9600 U0BAUD", 59, U0BAUD);
+  CHECK("DMA, BD 9600 echo", FRAME(0x44, frameId, 0x11, 0x7e, 0x42), 0, 0x44, frameId, 0x11, 0x7e, 0x42);
+  CHECK("DMA, write BD 57600", FRAME(0x08, frameId, 0x42, 0x44, 6), 0, 0x88, frameId, 0x42, 0x44, 0);
+  HostSim_uartTxDrain();
+  CC2530Bee_mainFunction();
+  checkValue("DMA, BD 57600 U0BAUD", 216, U0BAUD);
+  CHECK("DMA, BD 57600 echo", FRAME(0x44, frameId, 0x13, 0x7d), 0, 0x44, frameId, 0x13, 0x7d);
+  frameId++;
+
+  /* frame following BD in the same stream waits in rx buffer while baud
+   * rate is changed, its words are marked with new U0BAUD */
+  for (n = 0; n < sizeof(baudrates); n++)
+  {
+    bd[1] = frameId;
+    bd[4] = baudrates[n];
+    pending[1] = frameId;
+    streamLength = HostSim_encodeFrame(bd, sizeof(bd), stream);
+    streamLength += HostSim_encodeFrame(pending, sizeof(pending), &stream[streamLength]);
+    HostSim_uartTxClear();
+    HostSim_setUartSource(stream, streamLength);
+    CC2530Bee_mainFunction();
+    checkValue("DMA, BD, bytes left in rx buffer", 1, HostSim_uartRxPending() > 0);
+    HostSim_uartTxDrain();
+    /* bounded, rx stalls for good if pending words keep old U0BAUD */
+    for (i = 0; (i < 100) && (HostSim_uartRxPending() > 0); i++)
+    {
+      CC2530Bee_mainFunction();
+    }
+    checkValue("DMA, BD with bytes pending U0BAUD", baudMarks[n], U0BAUD);
+    receivedLength = receiveLastFrame(0x44, received);
+    checkResult("DMA, bytes pending during BD passed on", pending, sizeof(pending), received, receivedLength);
+    frameId++;
+  }
+}
+
+/**
+ * Frame pool: transmit and receive queue share its buffers, one buffer is
+ * reserved for responses, buffers released are handed out again and
+ * high-water mark is reported via XS
+ */
+static void framePoolTests(void)
+{
+  IEEE802154_DataFrameHeader_t header;
+  CC2530Bee_Statistics_t statistics;
+  const uint8_t tx[] = { 0x01, 0x00, 0xee, 0xee, 0x00, 0x12 };
+  const uint8_t *const messages[] = { tx, tx };
+  const uint16_t lengths[] = { sizeof(tx), sizeof(tx) };
+  const uint8_t payload[] = { 0xaa, 0xbb };
+  uint8_t *buffers[FRAMEPOOL_NUM_BUFFERS];
+  uint16_t overflows;
+  uint8_t n;
+
+  checkValue("Frame pool, idle only radio buffer used", 1, FramePool_numUsed());
+  for (n = 0; (buffers[n] = FramePool_alloc()) != NULL; n++)
+  {
+  }
+  checkValue("Frame pool, buffers for queues", FRAMEPOOL_NUM_BUFFERS - FRAMEPOOL_NUM_RESERVED - 1, n);
+  buffers[n] = FramePool_allocReserved();
+  checkValue("Frame pool, reserved buffer", 1, buffers[n] != NULL);
+  checkValue("Frame pool, all buffers used", FRAMEPOOL_NUM_BUFFERS, FramePool_numUsed());
+  FramePool_release(buffers[0]);
+  checkValue("Frame pool, buffer released", FRAMEPOOL_NUM_BUFFERS - 1, FramePool_numUsed());
+  checkValue("Frame pool, released buffer taken again", 1, FramePool_allocReserved() == buffers[0]);
+  FramePool_release(buffers[n]);
+  while (n > 0)
+  {
+    FramePool_release(buffers[--n]);
+  }
+
+  /* called from radio interrupt, interrupts stay disabled */
+  EA = 0;
+  buffers[0] = FramePool_alloc();
+  checkValue("Frame pool, alloc keeps EA cleared", 0, EA);
+  FramePool_release(buffers[0]);
+  checkValue("Frame pool, release keeps EA cleared", 0, EA);
+  EA = 1;
+  buffers[0] = FramePool_alloc();
+  FramePool_release(buffers[0]);
+  checkValue("Frame pool, EA set kept", 1, EA);
+
+  /* TX requests waiting for ACK hold buffers, fewer radio frames can be queued */
+  CHECK("Write XS 0 for frame pool", FRAME(0x08, frameId, 0x58, 0x53, 0), 0, 0x88, frameId, 0x58, 0x53, 0);
+  frameId++;
+  HostSim_radioLoopback = 0;
+  sendFrames(messages, lengths, 2);
+  checkValue("Frame pool, TX requests queued", 2, TxQueue_numSlotsUsed());
+  memset(&header, 0, sizeof(header));
+  header.fcf.frameType = IEEE802154_FCF_FRAME_TYPE_DATA;
+  header.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  header.destinationPANID = CC2530BEE_Default_PanID;
+  header.destinationAddress.shortAddress = CC2530BEE_Default_ShortAddress;
+  header.sourceAddress.shortAddress = 0xeeef;
+  overflows = RxQueue_overflowCount;
+  for (n = 0; n < RXQUEUE_NUM_SLOTS; n++)
+  {
+    header.sequenceNumber++;
+    HostSim_radioReceive(&header, payload, sizeof(payload), (sint8_t)0xd0);
+  }
+  checkValue("Frame pool, RX frames lost", RXQUEUE_NUM_SLOTS - (FRAMEPOOL_NUM_BUFFERS - FRAMEPOOL_NUM_RESERVED - 3),
+             RxQueue_overflowCount - overflows);
+  checkValue("Frame pool, exhausted", 0, FramePool_numAvailable());
+  runFor(150);
+  HostSim_radioLoopback = 1;
+  checkValue("Frame pool, all released", 1, FramePool_numUsed());
+  readStatistics(&statistics);
+  checkValue("XS, frame pool high-water", FRAMEPOOL_NUM_BUFFERS - FRAMEPOOL_NUM_RESERVED, statistics.framePoolHighWater);
+  HostSim_uartTxClear();
+}
+
+static void configStoreTests(void)
+{
+  uint32_t eraseCount;
+  HostSim_flashEraseAll();
+  CHECK("Write MY", FRAME(0x08, frameId, 0x4d, 0x59, 0x12, 0x34), 0, 0x88, frameId, 0x4d, 0x59, 0);
+  CHECK("WR", FRAME(0x08, frameId, 0x57, 0x52), 0, 0x88, frameId, 0x57, 0x52, 0);
+  reboot();
+  CHECK("Read MY after reboot", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0x12, 0x34);
+  CHECK("Write MY", FRAME(0x08, frameId, 0x4d, 0x59, 0x56, 0x78), 0, 0x88, frameId, 0x4d, 0x59, 0);
+  CHECK("WR", FRAME(0x08, frameId, 0x57, 0x52), 0, 0x88, frameId, 0x57, 0x52, 0);
+  /* corrupt newest record, previous one must be used */
+  HostSim_flash[CONFIGSTORE_FIRST_PAGE * FLASH_PAGE_SIZE + CONFIGSTORE_RECORD_SIZE + sizeof(ConfigStore_Record_t) - 2] ^= 0x01;
+  reboot();
+  CHECK("Read MY corrupted record skipped", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0x12, 0x34);
+  frameId++;
+  CHECK("RE", FRAME(0x08, frameId, 0x52, 0x45), 0, 0x88, frameId, 0x52, 0x45, 0);
+  CHECK("Read MY after RE", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0xaf, 0xfe);
+  reboot();
+  CHECK("Read MY RE not stored", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0x12, 0x34);
+  CHECK("RE", FRAME(0x08, frameId, 0x52, 0x45), 0, 0x88, frameId, 0x52, 0x45, 0);
+  frameId++;
+  eraseCount = HostSim_flashEraseCount;
+  for (uint16_t i = 0; i < 200; i++)
+  {
+    const uint8_t wr[] = { 0x08, frameId, 0x57, 0x52 };
+    sendFrame(wr, sizeof(wr));
+  }
+  /* two records already written, each further full page costs one erase */
+  checkValue("WR erases once per full page", (2 + 200 - 1) / CONFIGSTORE_RECORDS_PER_PAGE, HostSim_flashEraseCount - eraseCount);
+  checkValue("WR never writes flash word twice", 0, HostSim_flashWriteErrors);
+  reboot();
+  CHECK("Read MY after page wrap", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0xaf, 0xfe);
+  HostSim_flashEraseAll();
+  CHECK("Write MY", FRAME(0x08, frameId, 0x4d, 0x59, 0x12, 0x34), 0, 0x88, frameId, 0x4d, 0x59, 0);
+  reboot();
+  CHECK("Read MY erased flash", FRAME(0x08, frameId, 0x4d, 0x59), 0, 0x88, frameId, 0x4d, 0x59, 0, 0xaf, 0xfe);
+  frameId++;
+}
+
+int main(void)
+{
+  HostSim_reset();
+  CC2530Bee_init();
+
+  simpleUARTEchoTests();
+  frameReceiverTests();
+  readParameterTests();
+  setParameterTests();
+  atQueueTests();
+  atCommandTableTests();
+  apiModeTests();
+  baudrateTests();
+  txTests();
+  txStatusTests();
+  txQueueTests();
+  aggregationTests();
+  fragmentationTests();
+  rxTests();
+  transparentTests();
+  remoteATTests();
+  sleepTests();
+  statisticsTests();
+  traceTests();
+  scanTests();
+  neighbourTests();
+  duplicateTests();
+  snifferTests();
+  dmaTests();
+  framePoolTests();
+  configStoreTests();
+
+  printf("%d test(s) failed\n", failedTests);
+  return (failedTests == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/** @}*/
@@ -0,0 +1,194 @@
+/** @ingroup Neighbour
+ * @{
+ */
+#include <PlatformTypes.h>
+#include <string.h>
+#include "Neighbour.h"
+
+/*
+ * Link quality of the last #NEIGHBOUR_NUM_ENTRIES nodes heard of, so that
+ * host does not need to evaluate RSSI of each RX packet. Frames are recorded
+ * once they are taken from receive queue, thus the table is only accessed
+ * from main loop. Entries are only added, once the table is full the least
+ * recently seen one is replaced.
+ */
+
+/**
+ * Neighbour table, entries 0 to Neighbour_count - 1 are used
+ */
+Neighbour_Entry_t Neighbour_entries[NEIGHBOUR_NUM_ENTRIES];
+
+/**
+ * Number of entries used
+ */
+uint8_t Neighbour_count;
+
+/**
+ * Empties the table
+ */
+void Neighbour_init(void)
+{
+  Neighbour_count = 0;
+}
+
+/**
+ * Gets entry of neighbour. If it is not in table yet, a new entry is used or
+ * the least recently seen one is replaced.
+ * @param addressMode IEEE802154_FCF_ADDRESS_MODE_16BIT or _64BIT
+ * @param shortAddress Address if addressMode is 16bit
+ * @param extendedAddress Address if addressMode is 64bit
+ * @param now Sleep timer count
+ * @return Entry of neighbour
+ */
+Neighbour_Entry_t *Neighbour_find(uint8_t addressMode, IEEE802154_ShortAddress_t shortAddress, const uint8_t *extendedAddress, uint32_t now)
+{
+  Neighbour_Entry_t *entry;
+  Neighbour_Entry_t *oldest = NULL;
+  uint32_t age;
+  uint32_t oldestAge = 0;
+  uint8_t i;
+  for (i=0; i<Neighbour_count; i++)
+  {
+    entry = &Neighbour_entries[i];
+    if ((entry->addressMode == addressMode) &&
+        ((addressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT) ?
+         (memcmp(entry->extendedAddress, extendedAddress, sizeof(IEEE802154_ExtendedAddress_t)) == 0) :
+         (entry->shortAddress == shortAddress)))
+    {
+      return entry;
+    }
+    age = entry->stale ? NEIGHBOUR_SLEEPTIMER_MASK : ((now - entry->lastSeen) & NEIGHBOUR_SLEEPTIMER_MASK);
+    if ((oldest == NULL) || (age > oldestAge))
+    {
+      oldest = entry;
+      oldestAge = age;
+    }
+  }
+  entry = (Neighbour_count < NEIGHBOUR_NUM_ENTRIES) ? &Neighbour_entries[Neighbour_count++] : oldest;
+  memset(entry, 0, sizeof(Neighbour_Entry_t));
+  entry->addressMode = addressMode;
+  if (addressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT)
+  {
+    memcpy(entry->extendedAddress, extendedAddress, sizeof(IEEE802154_ExtendedAddress_t));
+  }
+  else
+  {
+    entry->shortAddress = shortAddress;
+  }
+  entry->lastSeen = now;
+  return entry;
+}
+
+/**
+ * Records data frame received from neighbour
+ * @param addressMode Source address mode of frame
+ * @param shortAddress Source address if addressMode is 16bit
+ * @param extendedAddress Source address if addressMode is 64bit
+ * @param sequenceNumber Sequence number of frame
+ * @param rssi RSSI of frame in dBm
+ * @param now Sleep timer count
+ */
+void Neighbour_received(uint8_t addressMode, IEEE802154_ShortAddress_t shortAddress, const uint8_t *extendedAddress,
+                        uint8_t sequenceNumber, sint8_t rssi, uint32_t now)
+{
+  Neighbour_Entry_t *entry = Neighbour_find(addressMode, shortAddress, extendedAddress, now);
+  uint8_t gap;
+  if (entry->rxFrames == 0)
+  {
+    entry->rssi = (sint16_t)rssi * 16;
+  }
+  else
+  {
+    entry->rssi += ((sint16_t)rssi * 16 - entry->rssi) / (1 << NEIGHBOUR_RSSI_SHIFT);
+    /* frames sent by neighbour to other nodes count as lost as well */
+    gap = (uint8_t)(sequenceNumber - entry->lastSequence - 1);
+    if (gap <= NEIGHBOUR_MAX_GAP)
+    {
+      entry->rxLost += gap;
+    }
+  }
+  entry->rxFrames++;
+  entry->lastSequence = sequenceNumber;
+  entry->lastSeen = now;
+  entry->stale = 0;
+}
+
+/**
+ * Records outcome of a frame sent to neighbour with ACK requested
+ * @param addressMode Destination address mode of frame
+ * @param shortAddress Destination address if addressMode is 16bit
+ * @param extendedAddress Destination address if addressMode is 64bit
+ * @param acked 1 if ACK was received
+ * @param now Sleep timer count
+ */
+void Neighbour_transmitted(uint8_t addressMode, IEEE802154_ShortAddress_t shortAddress, const uint8_t *extendedAddress,
+                           uint8_t acked, uint32_t now)
+{
+  Neighbour_Entry_t *entry = Neighbour_find(addressMode, shortAddress, extendedAddress, now);
+  entry->txFrames++;
+  if (acked)
+  {
+    entry->txAcked++;
+    entry->lastSeen = now;
+    entry->stale = 0;
+  }
+}
+
+/**
+ * Marks entries not heard of for #NEIGHBOUR_STALE_TICKS as stale. Must be
+ * called more often than sleep timer wraps around.
+ * @param now Sleep timer count
+ */
+void Neighbour_poll(uint32_t now)
+{
+  uint8_t i;
+  for (i=0; i<Neighbour_count; i++)
+  {
+    if (((now - Neighbour_entries[i].lastSeen) & NEIGHBOUR_SLEEPTIMER_MASK) >= NEIGHBOUR_STALE_TICKS)
+    {
+      Neighbour_entries[i].stale = 1;
+    }
+  }
+}
+
+/**
+ * Writes entry in format of LQ response (see NEIGHBOUR_ENTRY_*)
+ * @param index Index of entry, must be less than Neighbour_count
+ * @param value Buffer for #NEIGHBOUR_ENTRY_LENGTH bytes
+ * @param now Sleep timer count
+ */
+void Neighbour_read(uint8_t index, uint8_t *value, uint32_t now)
+{
+  const Neighbour_Entry_t *entry = &Neighbour_entries[index];
+  uint32_t ticks = (now - entry->lastSeen) & NEIGHBOUR_SLEEPTIMER_MASK;
+  uint16_t age = 0xffff;
+  /* clamped before scaling, ticks * 1000 overflows after about 131 s */
+  if (!entry->stale && (ticks <= (uint32_t)0xffff * NEIGHBOUR_SLEEPTIMER_FREQUENCY / 1000))
+  {
+    age = (uint16_t)(ticks * 1000 / NEIGHBOUR_SLEEPTIMER_FREQUENCY);
+  }
+  value[NEIGHBOUR_ENTRY_ADDRESSMODE] = entry->addressMode;
+  if (entry->addressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT)
+  {
+    memcpy(&value[NEIGHBOUR_ENTRY_ADDRESS], entry->extendedAddress, sizeof(IEEE802154_ExtendedAddress_t));
+  }
+  else
+  {
+    memset(&value[NEIGHBOUR_ENTRY_ADDRESS], 0, sizeof(IEEE802154_ExtendedAddress_t) - sizeof(IEEE802154_ShortAddress_t));
+    value[NEIGHBOUR_ENTRY_ADDRESS + 6] = HI_UINT16(entry->shortAddress);
+    value[NEIGHBOUR_ENTRY_ADDRESS + 7] = LO_UINT16(entry->shortAddress);
+  }
+  value[NEIGHBOUR_ENTRY_RSSI] = (uint8_t)(entry->rssi / 16);
+  value[NEIGHBOUR_ENTRY_AGE] = HI_UINT16(age);
+  value[NEIGHBOUR_ENTRY_AGE + 1] = LO_UINT16(age);
+  value[NEIGHBOUR_ENTRY_RXFRAMES] = HI_UINT16(entry->rxFrames);
+  value[NEIGHBOUR_ENTRY_RXFRAMES + 1] = LO_UINT16(entry->rxFrames);
+  value[NEIGHBOUR_ENTRY_RXLOST] = HI_UINT16(entry->rxLost);
+  value[NEIGHBOUR_ENTRY_RXLOST + 1] = LO_UINT16(entry->rxLost);
+  value[NEIGHBOUR_ENTRY_TXFRAMES] = HI_UINT16(entry->txFrames);
+  value[NEIGHBOUR_ENTRY_TXFRAMES + 1] = LO_UINT16(entry->txFrames);
+  value[NEIGHBOUR_ENTRY_TXACKED] = HI_UINT16(entry->txAcked);
+  value[NEIGHBOUR_ENTRY_TXACKED + 1] = LO_UINT16(entry->txAcked);
+}
+
+/** @}*/
@@ -0,0 +1,85 @@
+/** @ingroup Neighbour
+ * @{
+ */
+#ifndef NEIGHBOUR_H_
+#define NEIGHBOUR_H_
+
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include <IEEE_802.15.4.h>
+#include "Config.h"
+
+/*******************| Macros |*****************************************/
+
+/**
+ * Entry as read via LQ or neighbour table API frame, values big-endian:
+ * address mode, 64bit address (as in RX packet) or 16bit address in last two
+ * bytes, smoothed RSSI in dBm, ms since last frame (0xffff: longer than
+ * 65 s), frames received, frames lost, frames sent expecting ACK, ACKs
+ * received
+ */
+#define NEIGHBOUR_ENTRY_ADDRESSMODE     (uint8_t)0
+#define NEIGHBOUR_ENTRY_ADDRESS         (uint8_t)1
+#define NEIGHBOUR_ENTRY_RSSI            (uint8_t)9
+#define NEIGHBOUR_ENTRY_AGE             (uint8_t)10
+#define NEIGHBOUR_ENTRY_RXFRAMES        (uint8_t)12
+#define NEIGHBOUR_ENTRY_RXLOST          (uint8_t)14
+#define NEIGHBOUR_ENTRY_TXFRAMES        (uint8_t)16
+#define NEIGHBOUR_ENTRY_TXACKED         (uint8_t)18
+#define NEIGHBOUR_ENTRY_LENGTH          (uint8_t)20
+
+/**
+ * Weight of a new RSSI sample in smoothed RSSI is 1/2^NEIGHBOUR_RSSI_SHIFT
+ */
+#define NEIGHBOUR_RSSI_SHIFT            3
+
+/**
+ * Sequence number gaps up to this are counted as lost frames, larger ones
+ * (including repeated frames) are taken as restart of neighbour. Frames
+ * dropped as receive queue was full count as lost as well.
+ */
+#define NEIGHBOUR_MAX_GAP               (uint8_t)16
+
+/**
+ * Sleep timer: 24bit count at 32768 Hz. An entry not heard of for half its
+ * range is marked stale, so that its age does not wrap around.
+ */
+#define NEIGHBOUR_SLEEPTIMER_MASK       (uint32_t)0x00ffffff
+#define NEIGHBOUR_SLEEPTIMER_FREQUENCY  (uint32_t)32768
+#define NEIGHBOUR_STALE_TICKS           (uint32_t)0x00800000
+
+/*******************| Type definitions |*******************************/
+
+/**
+ * \brief Link quality of one neighbour
+ */
+typedef struct {
+  uint8_t addressMode;                                  /*!< IEEE802154_FCF_ADDRESS_MODE_xxx of neighbour */
+  IEEE802154_ShortAddress_t shortAddress;               /*!< Valid if addressMode is 16bit */
+  IEEE802154_ExtendedAddress_t extendedAddress;         /*!< Valid if addressMode is 64bit */
+  sint16_t rssi;                                        /*!< Smoothed RSSI in 1/16 dBm */
+  uint8_t lastSequence;                                 /*!< Sequence number of last frame received */
+  uint8_t stale;                                        /*!< lastSeen is more than NEIGHBOUR_STALE_TICKS ago */
+  uint32_t lastSeen;                                    /*!< Sleep timer at last frame or ACK received */
+  uint16_t rxFrames;
+  uint16_t rxLost;                                      /*!< Sum of sequence number gaps */
+  uint16_t txFrames;                                    /*!< Unicast frames sent expecting ACK, including retries */
+  uint16_t txAcked;
+} Neighbour_Entry_t;
+
+/*******************| Global variables |*******************************/
+extern Neighbour_Entry_t Neighbour_entries[NEIGHBOUR_NUM_ENTRIES];
+extern uint8_t Neighbour_count;
+
+/*******************| Function prototypes |****************************/
+void Neighbour_init(void);
+Neighbour_Entry_t *Neighbour_find(uint8_t addressMode, IEEE802154_ShortAddress_t shortAddress, const uint8_t *extendedAddress, uint32_t now);
+void Neighbour_received(uint8_t addressMode, IEEE802154_ShortAddress_t shortAddress, const uint8_t *extendedAddress,
+                        uint8_t sequenceNumber, sint8_t rssi, uint32_t now);
+void Neighbour_transmitted(uint8_t addressMode, IEEE802154_ShortAddress_t shortAddress, const uint8_t *extendedAddress,
+                           uint8_t acked, uint32_t now);
+void Neighbour_poll(uint32_t now);
+void Neighbour_read(uint8_t index, uint8_t *value, uint32_t now);
+
+#endif
+/** @}*/
@@ -0,0 +1,108 @@
+/** @ingroup RxQueue
+ * @{
+ */
+#include <PlatformTypes.h>
+#include <string.h>
+#include "RxQueue.h"
+#include "FramePool.h"
+
+/*
+ * Receive queue with fixed number of slots (#RXQUEUE_NUM_SLOTS). Slots are
+ * filled by radio callbacks in interrupt context and drained to UART by main
+ * loop. As there is exactly one producer and one consumer, head is only
+ * written by producer and tail only by consumer. Both are free running 8bit
+ * counters, thus #RXQUEUE_NUM_SLOTS must be a power of two. Payloads are
+ * not copied, slots refer to the frame pool buffer they were received into.
+ */
+#if (RXQUEUE_NUM_SLOTS & (RXQUEUE_NUM_SLOTS - 1)) != 0
+#error "RXQUEUE_NUM_SLOTS must be a power of two"
+#endif
+
+/**
+ * Slots of receive queue
+ */
+static RxQueue_Slot_t RxQueue_slots[RXQUEUE_NUM_SLOTS];
+
+/**
+ * Number of slots committed so far (written in interrupt context only)
+ */
+static volatile uint8_t RxQueue_head;
+
+/**
+ * Number of slots released so far (written by main loop only)
+ */
+static volatile uint8_t RxQueue_tail;
+
+/**
+ * Number of received frames dropped because queue was full
+ */
+uint16_t RxQueue_overflowCount;
+
+/**
+ * Most slots filled at once since init
+ */
+uint8_t RxQueue_highWater;
+
+/**
+ * Empties the queue and resets overflow counter and high-water mark
+ */
+void RxQueue_init(void)
+{
+  RxQueue_head = 0;
+  RxQueue_tail = 0;
+  RxQueue_overflowCount = 0;
+  RxQueue_highWater = 0;
+}
+
+/**
+ * Returns next free slot to be filled. If queue is full the overflow counter
+ * is incremented.
+ * @return free slot, NULL if queue is full
+ * @note To be called from interrupt context only
+ */
+RxQueue_Slot_t *RxQueue_getFreeSlot(void)
+{
+  if ((uint8_t)(RxQueue_head - RxQueue_tail) == RXQUEUE_NUM_SLOTS)
+  {
+    RxQueue_overflowCount++;
+    return NULL;
+  }
+  return &(RxQueue_slots[RxQueue_head % RXQUEUE_NUM_SLOTS]);
+}
+
+/**
+ * Appends slot previously returned by RxQueue_getFreeSlot to queue
+ * @note To be called from interrupt context only
+ */
+void RxQueue_commit(void)
+{
+  RxQueue_head++;
+  if ((uint8_t)(RxQueue_head - RxQueue_tail) > RxQueue_highWater)
+  {
+    RxQueue_highWater = (uint8_t)(RxQueue_head - RxQueue_tail);
+  }
+}
+
+/**
+ * @return oldest slot in queue, NULL if queue is empty
+ */
+RxQueue_Slot_t *RxQueue_peek(void)
+{
+  if (RxQueue_head == RxQueue_tail)
+  {
+    return NULL;
+  }
+  return &(RxQueue_slots[RxQueue_tail % RXQUEUE_NUM_SLOTS]);
+}
+
+/**
+ * Removes oldest slot from queue after it was sent via UART and releases its
+ * payload buffer
+ */
+void RxQueue_release(void)
+{
+  FramePool_release(RxQueue_slots[RxQueue_tail % RXQUEUE_NUM_SLOTS].payload);
+  RxQueue_tail++;
+}
+
+/** @}*/
@@ -0,0 +1,59 @@
+/** @ingroup RxQueue
+ * @{
+ */
+#ifndef RXQUEUE_H_
+#define RXQUEUE_H_
+
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include <IEEE_802.15.4.h>
+#include "Config.h"
+   
+/*******************| Macros |*****************************************/
+
+/**
+ * Maximum payload of a received radio frame which is passed on, the rest is
+ * cut off
+ */
+#define RXQUEUE_MAX_PAYLOAD_LENGTH      100
+
+/*******************| Type definitions |*******************************/
+
+/**
+ * \brief Sender of a received radio frame and how it was received.
+ * Everything of RX packet API frame except payload.
+ */
+typedef struct {
+  uint8_t sourceAddressMode;                            /*!< IEEE802154_FCF_ADDRESS_MODE_xxx of sender */
+  IEEE802154_ShortAddress_t shortAddress;               /*!< Valid if sourceAddressMode is 16bit */
+  IEEE802154_ExtendedAddress_t extendedAddress;         /*!< Valid if sourceAddressMode is 64bit */
+  sint8_t rssi;
+  uint8_t sequenceNumber;                               /*!< Of frame, for loss estimate of neighbour table */
+  uint8_t options;                                      /*!< UARTAPI_RECEVICE_OPTIONS_xxx */
+} RxQueue_Source_t;
+
+/**
+ * \brief Slot of receive queue.
+ * Holds everything needed to build RX packet API frame of a received radio
+ * frame. Payload stays in the frame pool buffer radio received it into.
+ */
+typedef struct {
+  RxQueue_Source_t source;
+  uint8_t control;                                      /*!< Frame was sent with reserved FCF bit set */
+  uint8_t length;                                       /*!< Number of bytes in payload */
+  IEEE802154_Payload *payload;                          /*!< Frame pool buffer */
+} RxQueue_Slot_t;
+
+/*******************| Global variables |*******************************/
+extern uint16_t RxQueue_overflowCount;
+extern uint8_t RxQueue_highWater;
+
+/*******************| Function prototypes |****************************/
+void RxQueue_init(void);
+RxQueue_Slot_t *RxQueue_getFreeSlot(void);
+void RxQueue_commit(void);
+RxQueue_Slot_t *RxQueue_peek(void);
+void RxQueue_release(void);
+
+#endif
+/** @}*/
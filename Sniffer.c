@@ -0,0 +1,207 @@
+/** @ingroup Sniffer
+ * @{
+ */
+#include <PlatformTypes.h>
+#include <board.h>
+#include "Sniffer.h"
+#include "UartDma.h"
+
+/*
+ * Capture of all frames received in sniffer mode. Radio callbacks rebuild
+ * the PSDU from the header parsed by the driver and append one record per
+ * frame to a ring. The main loop copies runs of the ring to UART tx ring as
+ * they fit, so that records are written in batches with no per byte work.
+ * Records which do not fit into the ring are dropped as a whole.
+ */
+
+/**
+ * Ring of records, bytes Sniffer_tail up to Sniffer_head are not sent yet.
+ * Indexes run freely and are masked with SNIFFER_BUFFER_SIZE - 1.
+ */
+uint8_t Sniffer_buffer[SNIFFER_BUFFER_SIZE];
+
+/**
+ * Written from interrupt context only
+ */
+uint16_t Sniffer_head;
+
+/**
+ * Written from main loop only
+ */
+uint16_t Sniffer_tail;
+
+/**
+ * Records dropped as ring was full
+ */
+uint16_t Sniffer_overflowCount;
+
+/**
+ * Empties the ring
+ */
+void Sniffer_init(void)
+{
+  Sniffer_head = 0;
+  Sniffer_tail = 0;
+}
+
+/**
+ * @return Number of bytes of MAC header of frame
+ */
+static uint8_t Sniffer_headerLength(const IEEE802154_DataFrameHeader_t *frame)
+{
+  uint8_t length = 3;
+  if (frame->fcf.destinationAddressMode != IEEE802154_FCF_ADDRESS_MODE_NONE)
+  {
+    length += sizeof(IEEE802154_PANIdentifier_t) +
+              ((frame->fcf.destinationAddressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT) ?
+               sizeof(IEEE802154_ExtendedAddress_t) : sizeof(IEEE802154_ShortAddress_t));
+  }
+  if (frame->fcf.sourceAddressMode != IEEE802154_FCF_ADDRESS_MODE_NONE)
+  {
+    if (!frame->fcf.panIdCompression)
+    {
+      length += sizeof(IEEE802154_PANIdentifier_t);
+    }
+    length += (frame->fcf.sourceAddressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT) ?
+              sizeof(IEEE802154_ExtendedAddress_t) : sizeof(IEEE802154_ShortAddress_t);
+  }
+  return length;
+}
+
+/**
+ * Writes bytes to ring and adds them to checksum
+ * @return Index after last byte written
+ */
+static uint16_t Sniffer_put(uint16_t index, const uint8_t *data, uint8_t length, uint8_t *checksum)
+{
+  while (length--)
+  {
+    *checksum += *data;
+    Sniffer_buffer[index++ & (SNIFFER_BUFFER_SIZE - 1)] = *data++;
+  }
+  return index;
+}
+
+/**
+ * Writes address (PAN ID if panId is set) in over the air order to ring
+ * @return Index after last byte written
+ */
+static uint16_t Sniffer_putAddress(uint16_t index, uint8_t addressMode, IEEE802154_PANIdentifier_t panId, uint8_t withPanId,
+                                   const IEEE802154_Address_t *address, uint8_t *checksum)
+{
+  uint8_t bytes[2];
+  if (withPanId)
+  {
+    bytes[0] = LO_UINT16(panId);
+    bytes[1] = HI_UINT16(panId);
+    index = Sniffer_put(index, bytes, sizeof(bytes), checksum);
+  }
+  if (addressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT)
+  {
+    return Sniffer_put(index, address->extendedAdress, sizeof(IEEE802154_ExtendedAddress_t), checksum);
+  }
+  bytes[0] = LO_UINT16(address->shortAddress);
+  bytes[1] = HI_UINT16(address->shortAddress);
+  return Sniffer_put(index, bytes, sizeof(bytes), checksum);
+}
+
+/**
+ * Appends record of a received frame to ring
+ * @param frame Header as parsed by driver, payload of payloadLength bytes
+ * @param payloadLength Length of MAC payload
+ * @param rssi RSSI in dBm
+ * @param crcOk 0 if frame was received with CRC error
+ * @param now Sleep timer count
+ * @return 0 if record was dropped as ring is full
+ * @note To be called from interrupt context only
+ */
+uint8_t Sniffer_record(const IEEE802154_DataFrameHeader_t *frame, uint8_t payloadLength, sint8_t rssi, uint8_t crcOk,
+                       uint32_t now)
+{
+  uint8_t header[SNIFFER_RECORD_PSDU + 3];
+  uint8_t checksum = 0;
+  uint8_t psduLength = Sniffer_headerLength(frame);
+  uint16_t index = Sniffer_head;
+  sint16_t lqi;
+  if (psduLength + payloadLength > IEEE802154_aMaxPHYPacketSize)
+  {
+    payloadLength = IEEE802154_aMaxPHYPacketSize - psduLength;
+  }
+  psduLength += payloadLength;
+  if ((uint16_t)(Sniffer_head - Sniffer_tail) + SNIFFER_RECORD_OVERHEAD + psduLength > SNIFFER_BUFFER_SIZE)
+  {
+    Sniffer_overflowCount++;
+    return 0;
+  }
+  lqi = ((sint16_t)rssi - SNIFFER_LQI_FLOOR) * SNIFFER_LQI_SCALE;
+  header[SNIFFER_RECORD_LENGTH] = psduLength | (crcOk ? SNIFFER_LENGTH_CRC_OK : 0);
+  header[SNIFFER_RECORD_TIMESTAMP] = (uint8_t)now;
+  header[SNIFFER_RECORD_TIMESTAMP + 1] = (uint8_t)(now >> 8);
+  header[SNIFFER_RECORD_TIMESTAMP + 2] = (uint8_t)(now >> 16);
+  header[SNIFFER_RECORD_RSSI] = (uint8_t)rssi;
+  header[SNIFFER_RECORD_LQI] = (lqi < 0) ? 0 : ((lqi > 0xff) ? 0xff : (uint8_t)lqi);
+  /* frame control field and sequence number */
+  header[SNIFFER_RECORD_PSDU] = frame->fcf.frameType | (frame->fcf.securityEnabled << 3) | (frame->fcf.framePending << 4) |
+                                (frame->fcf.ackRequired << 5) | (frame->fcf.panIdCompression << 6) | ((frame->fcf.reserved & 0x01) << 7);
+  header[SNIFFER_RECORD_PSDU + 1] = (frame->fcf.reserved >> 1) | (frame->fcf.destinationAddressMode << 2) | (frame->fcf.frameVersion << 4) |
+                                    (frame->fcf.sourceAddressMode << 6);
+  header[SNIFFER_RECORD_PSDU + 2] = frame->sequenceNumber;
+  Sniffer_buffer[index++ & (SNIFFER_BUFFER_SIZE - 1)] = SNIFFER_RECORD_MARKER;
+  index = Sniffer_put(index, &header[SNIFFER_RECORD_LENGTH], sizeof(header) - 1, &checksum);
+  if (frame->fcf.destinationAddressMode != IEEE802154_FCF_ADDRESS_MODE_NONE)
+  {
+    index = Sniffer_putAddress(index, frame->fcf.destinationAddressMode, frame->destinationPANID, 1,
+                               &frame->destinationAddress, &checksum);
+  }
+  if (frame->fcf.sourceAddressMode != IEEE802154_FCF_ADDRESS_MODE_NONE)
+  {
+    index = Sniffer_putAddress(index, frame->fcf.sourceAddressMode, frame->sourcePANID, !frame->fcf.panIdCompression,
+                               &frame->sourceAddress, &checksum);
+  }
+  index = Sniffer_put(index, frame->payload, payloadLength, &checksum);
+  Sniffer_buffer[index++ & (SNIFFER_BUFFER_SIZE - 1)] = 0xff - checksum;
+  Sniffer_head = index;
+  return 1;
+}
+
+/**
+ * @return Number of bytes in ring not sent yet
+ */
+uint16_t Sniffer_pending(void)
+{
+  uint16_t head;
+  disableAllInterrupt();
+  head = Sniffer_head;
+  enableAllInterrupt();
+  return head - Sniffer_tail;
+}
+
+/**
+ * Writes as many bytes of ring as fit into UART tx ring, so that main loop
+ * never waits for UART
+ */
+void Sniffer_poll(void)
+{
+  uint16_t length = Sniffer_pending();
+  uint16_t offset = Sniffer_tail & (SNIFFER_BUFFER_SIZE - 1);
+  uint16_t space = UartDma_txSpace();
+  if (length > SNIFFER_BUFFER_SIZE - offset)
+  {
+    length = SNIFFER_BUFFER_SIZE - offset;
+  }
+  if (length > space)
+  {
+    length = space;
+  }
+  if (length == 0)
+  {
+    return;
+  }
+  UartDma_write(&Sniffer_buffer[offset], length);
+  UartDma_flush();
+  disableAllInterrupt();
+  Sniffer_tail += length;
+  enableAllInterrupt();
+}
+
+/** @}*/
@@ -0,0 +1,55 @@
+/** @ingroup Sniffer
+ * @{
+ */
+#ifndef SNIFFER_H_
+#define SNIFFER_H_
+
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include <IEEE_802.15.4.h>
+#include "Config.h"
+
+/*******************| Macros |*****************************************/
+
+/**
+ * Capture record as written to UART in sniffer mode (SN), without escaping:
+ * marker, PSDU length without FCS (bit 7 set if CRC was ok), sleep timer at
+ * reception (24bit, little-endian, 32768 Hz), RSSI in dBm, LQI, PSDU and
+ * checksum. Checksum is 0xff minus sum of all bytes after the marker, so
+ * that a reader can find the next record again after bytes were lost.
+ */
+#define SNIFFER_RECORD_MARKER           (uint8_t)0xa5
+#define SNIFFER_RECORD_LENGTH           (uint8_t)1
+#define SNIFFER_RECORD_TIMESTAMP        (uint8_t)2
+#define SNIFFER_RECORD_RSSI             (uint8_t)5
+#define SNIFFER_RECORD_LQI              (uint8_t)6
+#define SNIFFER_RECORD_PSDU             (uint8_t)7
+#define SNIFFER_RECORD_OVERHEAD         (uint8_t)8
+#define SNIFFER_LENGTH_CRC_OK           (uint8_t)0x80
+#define SNIFFER_LENGTH_MASK             (uint8_t)0x7f
+
+/**
+ * Driver passes RSSI only, LQI is derived from it (IEEE 802.15.4 allows an
+ * ED based LQI): 0 at SNIFFER_LQI_FLOOR dBm, SNIFFER_LQI_SCALE per dB above,
+ * saturating at 255.
+ */
+#define SNIFFER_LQI_FLOOR               (sint8_t)(-100)
+#define SNIFFER_LQI_SCALE               3
+
+/*******************| Type definitions |*******************************/
+
+/*******************| Global variables |*******************************/
+extern uint8_t Sniffer_buffer[SNIFFER_BUFFER_SIZE];
+extern uint16_t Sniffer_head;
+extern uint16_t Sniffer_tail;
+extern uint16_t Sniffer_overflowCount;
+
+/*******************| Function prototypes |****************************/
+void Sniffer_init(void);
+uint8_t Sniffer_record(const IEEE802154_DataFrameHeader_t *frame, uint8_t payloadLength, sint8_t rssi, uint8_t crcOk,
+                       uint32_t now);
+uint16_t Sniffer_pending(void);
+void Sniffer_poll(void);
+
+#endif
+/** @}*/
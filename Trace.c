@@ -0,0 +1,114 @@
+/** @ingroup Trace
+ * @{
+ */
+#include <ioCC2530.h>
+#include <PlatformTypes.h>
+#include <board.h>
+#include "Trace.h"
+
+/*
+ * Trace of hot path stages. Each trace point stores its number, an 8bit
+ * argument and the count of Timer 1, which runs freely at tick speed, in a
+ * ring of #TRACE_NUM_ENTRIES entries. Once the ring is full the oldest entry
+ * is overwritten. The ring is stored in the byte order of the trace dump API
+ * frame, thus it is sent without copying (see UARTAPI_traceDump). Trace points
+ * are recorded from main loop and radio interrupt.
+ */
+#if (TRACE_NUM_ENTRIES & (TRACE_NUM_ENTRIES - 1)) != 0
+#error "TRACE_NUM_ENTRIES must be a power of two"
+#endif
+
+/**
+ * Timer 1 control: tick frequency divided by 1, free-running mode
+ */
+#define TRACE_T1CTL_FREERUNNING         (uint8_t)0x01
+
+/**
+ * Ring of trace entries
+ */
+Trace_Entry_t Trace_entries[TRACE_NUM_ENTRIES];
+
+/**
+ * Index of oldest entry
+ */
+uint8_t Trace_first;
+
+/**
+ * Number of entries recorded since last dump
+ */
+uint8_t Trace_count;
+
+/**
+ * Number of entries overwritten or not recorded since last dump, saturates
+ * at 255
+ */
+uint8_t Trace_dropped;
+
+/**
+ * Set while ring is being dumped. Trace points are skipped meanwhile without
+ * being counted, e.g. those of the dump frame itself.
+ */
+uint8_t Trace_paused;
+
+/**
+ * Starts Timer 1 and empties the ring
+ */
+void Trace_init(void)
+{
+  T1CTL = TRACE_T1CTL_FREERUNNING;
+  Trace_first = 0;
+  Trace_count = 0;
+  Trace_dropped = 0;
+  Trace_paused = 0;
+}
+
+/**
+ * Records trace point with current Timer 1 count. Use TRACE macro instead,
+ * so that trace points can be compiled out.
+ * @param point TRACE_*
+ * @param arg Argument of trace point
+ */
+void Trace_record(uint8_t point, uint8_t arg)
+{
+  Trace_Entry_t *entry;
+  /* reading T1CNTL latches T1CNTH */
+  uint8_t low = T1CNTL;
+  uint8_t high = T1CNTH;
+  disableAllInterrupt();
+  if (!Trace_paused)
+  {
+    entry = &Trace_entries[(Trace_first + Trace_count) & (TRACE_NUM_ENTRIES - 1)];
+    if (Trace_count < TRACE_NUM_ENTRIES)
+    {
+      Trace_count++;
+    }
+    else
+    {
+      Trace_first = (Trace_first + 1) & (TRACE_NUM_ENTRIES - 1);
+      if (Trace_dropped < 0xff)
+      {
+        Trace_dropped++;
+      }
+    }
+    entry->point = point;
+    entry->arg = arg;
+    entry->timestamp[0] = high;
+    entry->timestamp[1] = low;
+  }
+  enableAllInterrupt();
+}
+
+/**
+ * Empties the ring after it was dumped and resumes tracing
+ */
+void Trace_release(void)
+{
+  disableAllInterrupt();
+  Trace_first = 0;
+  Trace_count = 0;
+  Trace_dropped = 0;
+  Trace_paused = 0;
+  enableAllInterrupt();
+}
+
+/** @}*/
@@ -0,0 +1,63 @@
+/** @ingroup Trace
+ * @{
+ */
+#ifndef TRACE_H_
+#define TRACE_H_
+
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include "Config.h"
+   
+/*******************| Macros |*****************************************/
+
+/**
+ * Trace points, recorded as first byte of Trace_Entry_t. Argument of each
+ * trace point in brackets.
+ */
+#define TRACE_UART_HEADER               (uint8_t)0x01   /* UART frame header read (low byte of length) */
+#define TRACE_UART_FRAME                (uint8_t)0x02   /* UART frame parsed completely (API identifier) */
+#define TRACE_DISPATCH                  (uint8_t)0x03   /* UART frame dispatched by main loop (API identifier) */
+#define TRACE_RADIO_TX_START            (uint8_t)0x04   /* IEEE802154_radioSentDataFrame called (sequence number) */
+#define TRACE_RADIO_TX_DONE             (uint8_t)0x05   /* IEEE802154_radioSentDataFrame returned (sequence number) */
+#define TRACE_ACK                       (uint8_t)0x06   /* ACK callback (sequence number) */
+#define TRACE_RX_ENTRY                  (uint8_t)0x07   /* Data frame callback entered (payload length) */
+#define TRACE_RX_EXIT                   (uint8_t)0x08   /* Data frame callback left (payload length) */
+#define TRACE_UART_EMIT_START           (uint8_t)0x09   /* UART frame started (API identifier) */
+#define TRACE_UART_EMIT_END             (uint8_t)0x0a   /* Last byte of UART frame handed to USART (API identifier) */
+
+/**
+ * Records trace point if TRACE_ENABLE is defined, else compiles to nothing
+ */
+#ifdef TRACE_ENABLE
+#define TRACE(point, arg)               Trace_record((point), (uint8_t)(arg))
+#else
+#define TRACE(point, arg)
+#endif
+
+/*******************| Type definitions |*******************************/
+
+/**
+ * \brief Trace entry as sent in trace dump API frame.
+ * Timestamp is the free running Timer 1 count, big-endian as all values in
+ * API frames.
+ */
+typedef struct {
+  uint8_t point;                /*!< TRACE_* */
+  uint8_t arg;                  /*!< Argument of trace point */
+  uint8_t timestamp[2];         /*!< Timer 1 count, high byte first */
+} Trace_Entry_t;
+
+/*******************| Global variables |*******************************/
+extern Trace_Entry_t Trace_entries[TRACE_NUM_ENTRIES];
+extern uint8_t Trace_first;
+extern uint8_t Trace_count;
+extern uint8_t Trace_dropped;
+extern uint8_t Trace_paused;
+
+/*******************| Function prototypes |****************************/
+void Trace_init(void);
+void Trace_record(uint8_t point, uint8_t arg);
+void Trace_release(void);
+
+#endif
+/** @}*/
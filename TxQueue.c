@@ -0,0 +1,189 @@
+/** @ingroup TxQueue
+ * @{
+ */
+#include <PlatformTypes.h>
+#include <string.h>
+#include "TxQueue.h"
+#include "FramePool.h"
+
+/*
+ * Transmit queue with fixed number of slots (#TXQUEUE_NUM_SLOTS) used as ring. The UART frame
+ * receiver writes directly into the free slot at the head while the radio
+ * drains the oldest slot at the tail. Both sides are served from main loop
+ * only, thus no locking is needed. Frames are stored in frame pool buffers,
+ * the one being received is taken once the first byte arrived and kept by
+ * the slot until the frame was sent.
+ */
+
+/**
+ * Slots of transmit queue
+ */
+static TxQueue_Slot_t TxQueue_slots[TXQUEUE_NUM_SLOTS];
+
+/**
+ * Buffer frame is received into, NULL if none was taken yet
+ */
+static APIFramePayload_t *TxQueue_pending;
+
+/**
+ * Index of next slot to be filled
+ */
+static uint8_t TxQueue_head;
+
+/**
+ * Index of oldest filled slot
+ */
+static uint8_t TxQueue_tail;
+
+/**
+ * Number of filled slots
+ */
+static uint8_t TxQueue_count;
+
+/**
+ * Most slots filled at once since init
+ */
+uint8_t TxQueue_highWater;
+
+/**
+ * Empties the queue and resets high-water mark
+ */
+void TxQueue_init(void)
+{
+  TxQueue_pending = NULL;
+  TxQueue_head = 0;
+  TxQueue_tail = 0;
+  TxQueue_count = 0;
+  TxQueue_highWater = 0;
+}
+
+/**
+ * Returns buffer of next free slot, it is taken from frame pool on first
+ * call. The buffer stays the same until TxQueue_commit or TxQueue_discard is
+ * called, thus it can be filled over several calls.
+ * @return data buffer of free slot, NULL if queue is full or frame pool is
+ * exhausted
+ */
+APIFramePayload_t *TxQueue_getFreeSlot(void)
+{
+  if (TxQueue_count == TXQUEUE_NUM_SLOTS)
+  {
+    return NULL;
+  }
+  if (TxQueue_pending == NULL)
+  {
+    TxQueue_pending = FramePool_alloc();
+  }
+  return TxQueue_pending;
+}
+
+/**
+ * Fills slot at head of queue
+ * @param data frame pool buffer holding frame
+ * @param length number of bytes in data
+ */
+static void TxQueue_add(APIFramePayload_t *data, uint16_t length)
+{
+  TxQueue_slots[TxQueue_head].length = length;
+  TxQueue_slots[TxQueue_head].data = data;
+  TxQueue_head = (TxQueue_head + 1) % TXQUEUE_NUM_SLOTS;
+  TxQueue_count++;
+  if (TxQueue_count > TxQueue_highWater)
+  {
+    TxQueue_highWater = TxQueue_count;
+  }
+}
+
+/**
+ * Appends slot previously returned by TxQueue_getFreeSlot to queue
+ * @param length number of bytes in slot data
+ */
+void TxQueue_commit(uint16_t length)
+{
+  TxQueue_add(TxQueue_pending, length);
+  TxQueue_pending = NULL;
+}
+
+/**
+ * Appends frame built by firmware itself, e.g. remote AT command response.
+ * A slot is left for the frame being received into TxQueue_getFreeSlot.
+ * @param data frame pool buffer, owned by queue if frame was appended
+ * @param length number of bytes in data
+ * @return 1 if frame was appended, 0 if queue is full
+ */
+uint8_t TxQueue_append(APIFramePayload_t *data, uint16_t length)
+{
+  if (TxQueue_count + ((TxQueue_pending != NULL) ? 1 : 0) >= TXQUEUE_NUM_SLOTS)
+  {
+    return 0;
+  }
+  TxQueue_add(data, length);
+  return 1;
+}
+
+/**
+ * Returns buffer previously returned by TxQueue_getFreeSlot to frame pool,
+ * e.g. as frame was handled at once and not queued
+ */
+void TxQueue_discard(void)
+{
+  if (TxQueue_pending != NULL)
+  {
+    FramePool_release(TxQueue_pending);
+    TxQueue_pending = NULL;
+  }
+}
+
+/**
+ * @return oldest slot in queue, NULL if queue is empty
+ */
+TxQueue_Slot_t *TxQueue_peek(void)
+{
+  if (TxQueue_count == 0)
+  {
+    return NULL;
+  }
+  return &(TxQueue_slots[TxQueue_tail]);
+}
+
+/**
+ * @param index position in queue, 0 is oldest slot
+ * @return slot at given position, NULL if less slots are filled
+ */
+TxQueue_Slot_t *TxQueue_peekAt(uint8_t index)
+{
+  if (index >= TxQueue_count)
+  {
+    return NULL;
+  }
+  return &(TxQueue_slots[(TxQueue_tail + index) % TXQUEUE_NUM_SLOTS]);
+}
+
+/**
+ * Removes oldest slot from queue after it was sent and releases its buffer
+ */
+void TxQueue_release(void)
+{
+  FramePool_release(TxQueue_slots[TxQueue_tail].data);
+  TxQueue_tail = (TxQueue_tail + 1) % TXQUEUE_NUM_SLOTS;
+  TxQueue_count--;
+}
+
+/**
+ * @return number of slots waiting to be sent
+ */
+uint8_t TxQueue_numSlotsUsed(void)
+{
+  return TxQueue_count;
+}
+
+/**
+ * @return 1 if no further frame can be received, i.e. queue is full or frame
+ * pool has no buffer left for it
+ */
+uint8_t TxQueue_isFull(void)
+{
+  return (TxQueue_count == TXQUEUE_NUM_SLOTS) || ((TxQueue_pending == NULL) && (FramePool_numAvailable() == 0));
+}
+
+/** @}*/
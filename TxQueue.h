@@ -0,0 +1,43 @@
+/** @ingroup TxQueue
+ * @{
+ */
+#ifndef TXQUEUE_H_
+#define TXQUEUE_H_
+
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include "Config.h"
+#include "CC2530Bee.h"
+   
+/*******************| Macros |*****************************************/
+
+/*******************| Type definitions |*******************************/
+
+/**
+ * \brief Slot of transmit queue.
+ * Refers to a complete TX request API frame as received via UART. Frame ID,
+ * destination address, options and payload are taken from it when the frame
+ * is handed to the radio.
+ */
+typedef struct {
+  uint16_t length;                                      /*!< Length of API frame data */
+  APIFramePayload_t *data;                              /*!< Frame pool buffer holding API frame data starting with API identifier */
+} TxQueue_Slot_t;
+
+/*******************| Global variables |*******************************/
+extern uint8_t TxQueue_highWater;
+
+/*******************| Function prototypes |****************************/
+void TxQueue_init(void);
+APIFramePayload_t *TxQueue_getFreeSlot(void);
+void TxQueue_commit(uint16_t length);
+uint8_t TxQueue_append(APIFramePayload_t *data, uint16_t length);
+void TxQueue_discard(void);
+TxQueue_Slot_t *TxQueue_peek(void);
+TxQueue_Slot_t *TxQueue_peekAt(uint8_t index);
+void TxQueue_release(void);
+uint8_t TxQueue_numSlotsUsed(void);
+uint8_t TxQueue_isFull(void);
+
+#endif
+/** @}*/
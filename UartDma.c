@@ -0,0 +1,314 @@
+/** @ingroup UartDma
+ * @{
+ */
+#include <ioCC2530.h>
+#include <PlatformTypes.h>
+#include <board.h>
+#include "UartDma.h"
+
+/*
+ * USART 0 rx and tx via DMA instead of one interrupt per byte.
+ *
+ * Rx: channel UARTDMA_CHANNEL_RX copies each byte received together with
+ * U0BAUD, the register following U0DBUF in xdata, as one word into a circular
+ * buffer, over and over. A word whose upper byte equals U0BAUD holds a byte
+ * not read yet, UartDma_read marks it as read by storing inverted U0BAUD.
+ * U0BAUD is 59 or 216 for all baud rates supported, thus a read mark never
+ * looks like a new byte after the baud rate was changed. Bytes not read yet
+ * are marked again by UartDma_setBaudrate. CC2530 DMA has no readable address
+ * register, the marks tell how far DMA has got.
+ *
+ * Tx: frames are written to a ring, already escaped, and handed to DMA by
+ * UartDma_flush. Channel UARTDMA_CHANNEL_TX sends one contiguous block of the
+ * ring, UTX0 triggers each byte once the previous one left U0DBUF. The
+ * transfer complete interrupt starts the next block.
+ */
+
+/**
+ * Circular rx buffer written by DMA, see above
+ */
+volatile uint16_t UartDma_rxBuffer[UARTDMA_RX_BUFFER_SIZE];
+
+/**
+ * Index of next word to read, runs freely and is masked with
+ * UARTDMA_RX_BUFFER_SIZE - 1
+ */
+static uint8_t UartDma_rxHead;
+
+/**
+ * Tx ring, bytes UartDma_txTail up to UartDma_txFill are not sent yet.
+ * Indexes run freely and are masked with UARTDMA_TX_BUFFER_SIZE - 1.
+ */
+uint8_t UartDma_txBuffer[UARTDMA_TX_BUFFER_SIZE];
+
+/**
+ * Bytes written by main loop, not yet handed over to DMA
+ */
+static uint16_t UartDma_txFill;
+
+/**
+ * Bytes handed over to DMA, written with interrupts disabled
+ */
+static volatile uint16_t UartDma_txHead;
+
+/**
+ * Bytes sent, written from DMA interrupt only
+ */
+static volatile uint16_t UartDma_txTail;
+
+/**
+ * UartDma_txTail + UARTDMA_TX_BUFFER_SIZE as last read by main loop, thus
+ * writing only looks at the interrupt side once this much was written
+ */
+static uint16_t UartDma_txLimit;
+
+/**
+ * Number of bytes of block channel is sending, 0 if channel is idle
+ */
+static volatile uint16_t UartDma_txBlock;
+
+static DMA_Descriptor_t UartDma_rxDescriptor;
+static DMA_Descriptor_t UartDma_txDescriptor;
+
+/**
+ * Takes USART 0 over from the interrupt driven USART module. Must be called
+ * after UART_init, bytes in its ring buffers are discarded.
+ */
+void UartDma_init(void)
+{
+  uint8_t i;
+  uint16_t readMark = (uint16_t)(U0BAUD ^ 0xff) << 8;
+  URX0IE = 0;
+  IEN2 &= ~UARTDMA_IEN2_UTX0IE;
+  DMA_abort(UARTDMA_CHANNEL_RX);
+  DMA_abort(UARTDMA_CHANNEL_TX);
+  for (i=0; i<UARTDMA_RX_BUFFER_SIZE; i++)
+  {
+    UartDma_rxBuffer[i] = readMark;
+  }
+  UartDma_rxHead = 0;
+  UartDma_txFill = 0;
+  UartDma_txHead = 0;
+  UartDma_txTail = 0;
+  UartDma_txLimit = UARTDMA_TX_BUFFER_SIZE;
+  UartDma_txBlock = 0;
+
+  UartDma_rxDescriptor.source = &X_U0DBUF;
+  UartDma_rxDescriptor.destination = UartDma_rxBuffer;
+  UartDma_rxDescriptor.length = UARTDMA_RX_BUFFER_SIZE;
+  UartDma_rxDescriptor.trigger = DMA_WORDSIZE_16BIT | DMA_TMODE_REPEATED_SINGLE | DMA_TRIG_URX0;
+  UartDma_rxDescriptor.config = DMA_SRCINC_0 | DMA_DESTINC_1 | DMA_PRIORITY_HIGH;
+  DMA_setDescriptor(UARTDMA_CHANNEL_RX, &UartDma_rxDescriptor);
+
+  UartDma_txDescriptor.destination = &X_U0DBUF;
+  UartDma_txDescriptor.trigger = DMA_WORDSIZE_8BIT | DMA_TMODE_SINGLE | DMA_TRIG_UTX0;
+  UartDma_txDescriptor.config = DMA_SRCINC_1 | DMA_DESTINC_0 | DMA_IRQMASK_ENABLE | DMA_PRIORITY_GUARANTEED;
+
+  DMA_arm(UARTDMA_CHANNEL_RX);
+}
+
+/**
+ * @return 1 if a byte was received which was not read yet
+ */
+uint8_t UartDma_rxAvailable(void)
+{
+  uint8_t newMark = U0BAUD;
+  return HI_UINT16(UartDma_rxBuffer[UartDma_rxHead & (UARTDMA_RX_BUFFER_SIZE - 1)]) == newMark;
+}
+
+/**
+ * @return 1 if all words of rx buffer hold bytes not read yet, further bytes
+ * overwrite them. DMA fills words in order, thus it is enough to look at the
+ * word before the next one to read.
+ */
+uint8_t UartDma_rxFull(void)
+{
+  uint8_t newMark = U0BAUD;
+  return HI_UINT16(UartDma_rxBuffer[(uint8_t)(UartDma_rxHead - 1) & (UARTDMA_RX_BUFFER_SIZE - 1)]) == newMark;
+}
+
+/**
+ * Copies bytes received out of rx buffer and marks their words as read. Upper
+ * byte of a word is checked before its data byte is read, DMA writes it last.
+ * @param buffer Buffer to receive bytes into
+ * @param maxLength Maximum number of bytes to read
+ * @return Number of bytes read
+ */
+uint8_t UartDma_read(uint8_t *buffer, uint8_t maxLength)
+{
+  uint8_t newMark = U0BAUD;
+  uint16_t readMark = (uint16_t)(newMark ^ 0xff) << 8;
+  uint8_t index;
+  uint8_t n;
+  for (n=0; n<maxLength; n++)
+  {
+    index = UartDma_rxHead & (UARTDMA_RX_BUFFER_SIZE - 1);
+    if (HI_UINT16(UartDma_rxBuffer[index]) != newMark)
+    {
+      break;
+    }
+    *buffer++ = LO_UINT16(UartDma_rxBuffer[index]);
+    UartDma_rxBuffer[index] = readMark;
+    UartDma_rxHead++;
+  }
+  return n;
+}
+
+/**
+ * Sets baud rate of USART 0. Words holding bytes not read yet are marked with
+ * new U0BAUD, else they would look like read words and stop UartDma_read.
+ * DMA marks bytes received after the change with new U0BAUD itself.
+ * @param baudrate New baud rate
+ */
+void UartDma_setBaudrate(USART_Baudrate_t baudrate)
+{
+  uint8_t oldMark = U0BAUD;
+  uint8_t newMark;
+  uint8_t i;
+  USART_setBaudrate(baudrate);
+  newMark = U0BAUD;
+  if (newMark == oldMark)
+  {
+    return;
+  }
+  for (i=0; i<UARTDMA_RX_BUFFER_SIZE; i++)
+  {
+    if (HI_UINT16(UartDma_rxBuffer[i]) == oldMark)
+    {
+      UartDma_rxBuffer[i] = ((uint16_t)newMark << 8) | LO_UINT16(UartDma_rxBuffer[i]);
+    }
+  }
+}
+
+/**
+ * Starts transfer of next contiguous block handed over, if any
+ * @note Interrupts must be disabled or called from DMA interrupt
+ */
+static void UartDma_startBlock(void)
+{
+  uint16_t offset = UartDma_txTail & (UARTDMA_TX_BUFFER_SIZE - 1);
+  uint16_t length = UartDma_txHead - UartDma_txTail;
+  if (length > UARTDMA_TX_BUFFER_SIZE - offset)
+  {
+    length = UARTDMA_TX_BUFFER_SIZE - offset;
+  }
+  UartDma_txBlock = length;
+  if (length == 0)
+  {
+    return;
+  }
+  UartDma_txDescriptor.source = &UartDma_txBuffer[offset];
+  UartDma_txDescriptor.length = length;
+  DMA_setDescriptor(UARTDMA_CHANNEL_TX, &UartDma_txDescriptor);
+  DMA_arm(UARTDMA_CHANNEL_TX);
+  /* U0DBUF is empty, thus UTX0 does not trigger the first byte */
+  DMA_trigger(UARTDMA_CHANNEL_TX);
+}
+
+/**
+ * Tx block sent, frees it and starts the next one. Called from DMA interrupt.
+ */
+void DMA_UserCbk_TransferComplete(uint8_t channel)
+{
+  if (channel == UARTDMA_CHANNEL_TX)
+  {
+    UartDma_txTail += UartDma_txBlock;
+    UartDma_startBlock();
+  }
+}
+
+/**
+ * Hands bytes written so far over to DMA
+ */
+void UartDma_flush(void)
+{
+  disableAllInterrupt();
+  UartDma_txHead = UartDma_txFill;
+  if (UartDma_txBlock == 0)
+  {
+    UartDma_startBlock();
+  }
+  enableAllInterrupt();
+}
+
+/**
+ * @return Number of bytes which can be written without waiting
+ */
+uint16_t UartDma_txSpace(void)
+{
+  disableAllInterrupt();
+  UartDma_txLimit = UartDma_txTail + UARTDMA_TX_BUFFER_SIZE;
+  enableAllInterrupt();
+  return UartDma_txLimit - UartDma_txFill;
+}
+
+/**
+ * @return Number of bytes written but not completely sent, including byte
+ * being shifted out
+ */
+uint16_t UartDma_numBytesInTxBuffer(void)
+{
+  uint16_t tail;
+  disableAllInterrupt();
+  tail = UartDma_txTail;
+  enableAllInterrupt();
+  return (UartDma_txFill - tail) + ((U0CSR & UARTDMA_U0CSR_ACTIVE) ? 1 : 0);
+}
+
+/**
+ * Waits until at least one byte can be written. Bytes written so far are
+ * handed over first as the ring would never drain else.
+ */
+static void UartDma_waitSpace(void)
+{
+  while (UartDma_txSpace() == 0)
+  {
+    UartDma_flush();
+  }
+}
+
+/**
+ * Writes one byte to tx ring, see UartDma_flush
+ */
+void UartDma_putc(uint8_t c)
+{
+  if (UartDma_txFill == UartDma_txLimit)
+  {
+    UartDma_waitSpace();
+  }
+  UartDma_txBuffer[UartDma_txFill++ & (UARTDMA_TX_BUFFER_SIZE - 1)] = c;
+}
+
+/**
+ * Writes bytes to tx ring, see UartDma_flush. Waits while ring is full.
+ */
+void UartDma_write(const uint8_t *data, uint16_t length)
+{
+  uint16_t offset;
+  uint16_t n;
+  while (length > 0)
+  {
+    if (UartDma_txFill == UartDma_txLimit)
+    {
+      UartDma_waitSpace();
+    }
+    offset = UartDma_txFill & (UARTDMA_TX_BUFFER_SIZE - 1);
+    n = UartDma_txLimit - UartDma_txFill;
+    if (n > UARTDMA_TX_BUFFER_SIZE - offset)
+    {
+      n = UARTDMA_TX_BUFFER_SIZE - offset;
+    }
+    if (n > length)
+    {
+      n = length;
+    }
+    UartDma_txFill += n;
+    length -= n;
+    while (n--)
+    {
+      UartDma_txBuffer[offset++] = *data++;
+    }
+  }
+}
+
+/** @}*/
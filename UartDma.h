@@ -0,0 +1,51 @@
+/** @ingroup UartDma
+ * @{
+ */
+#ifndef UARTDMA_H_
+#define UARTDMA_H_
+
+/*******************| Inclusions |*************************************/
+#include <PlatformTypes.h>
+#include <DMA.h>
+#include <USART.h>
+#include "Config.h"
+
+/*******************| Macros |*****************************************/
+/**
+ * DMA channels used for USART 0. Rx has highest priority so that no byte is
+ * overwritten in U0DBUF while tx transfers are pending.
+ */
+#define UARTDMA_CHANNEL_RX              (uint8_t)0
+#define UARTDMA_CHANNEL_TX              (uint8_t)1
+
+/**
+ * U0CSR: byte is being shifted out (or in)
+ */
+#define UARTDMA_U0CSR_ACTIVE            (uint8_t)0x01
+
+/**
+ * Interrupt enable bits of USART 0 used by USART module, disabled so that
+ * DMA alone reads and writes U0DBUF
+ */
+#define UARTDMA_IEN2_UTX0IE             (uint8_t)0x04
+
+/*******************| Type definitions |*******************************/
+
+/*******************| Global variables |*******************************/
+extern volatile uint16_t UartDma_rxBuffer[UARTDMA_RX_BUFFER_SIZE];
+extern uint8_t UartDma_txBuffer[UARTDMA_TX_BUFFER_SIZE];
+
+/*******************| Function prototypes |****************************/
+void UartDma_init(void);
+uint8_t UartDma_rxAvailable(void);
+uint8_t UartDma_rxFull(void);
+uint8_t UartDma_read(uint8_t *buffer, uint8_t maxLength);
+void UartDma_setBaudrate(USART_Baudrate_t baudrate);
+uint16_t UartDma_txSpace(void);
+uint16_t UartDma_numBytesInTxBuffer(void);
+void UartDma_putc(uint8_t c);
+void UartDma_write(const uint8_t *data, uint16_t length);
+void UartDma_flush(void);
+
+#endif
+/** @}*/
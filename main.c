@@ -9,7 +9,17 @@
 #include <IEEE_802.15.4.h>
 #include <CC253x.h>
 #include <string.h>
+#include <stddef.h>
 #include "CC2530Bee.h"
+#include "TxQueue.h"
+#include "RxQueue.h"
+#include "ConfigStore.h"
+#include "Trace.h"
+#include "Neighbour.h"
+#include "Duplicate.h"
+#include "Sniffer.h"
+#include "UartDma.h"
+#include "FramePool.h"
 
 /**
  * \mainpage CC2530Bee
@@ -17,28 +27,39 @@
  *
  * The firmware for CC2530 was implemented to be able to use this chip as a drop-in replacement for the famous XBee devices together
  * with Arduino XBee library (see https://code.google.com/p/xbee-arduino/).
- * This implementation only supports "API Operation" using escape characters called "AP = 2: API Operation (with escaped characters)" in
- * XBee documentation. The reason is that this is the only mode supported by the Arduino library.
+ * This implementation supports "API Operation" using escape characters called "AP = 2: API Operation (with escaped characters)" in
+ * XBee documentation. The reason is that this is the only mode supported by the Arduino library. "AP = 1: API Operation" without
+ * escaping can be selected at runtime via AP command.
+ * With CC2530BEE_Default_APIMode set to CC2530BEE_APIMODE_TRANSPARENT ("AP = 0: Transparent Operation") bytes received via UART are
+ * sent to DH/DL once RO character times passed without further byte or a frame is full, received payload is written to UART as is.
  * A simple python script is provided to test the functionality. Rx tests will only works with SmartRF Studio.
  * 
  * Implemented API Commands
  * ========================
  * - AT Command: API Identifier Value: 0x08. Partial, test for implemented parts exists. Not all AT commands are supported (see list below which)
+ * - AT Command - Queue Parameter Value: API Identifier Value: 0x09. Fully implemented, test exists. Changes are applied
+ *   with next AT Command (0x08) write or AC.
  * - AT Command Response: API Identifier Value: 0x88. Fully implemented, test exists
+ * - Remote AT Command Request: API Identifier Value: 0x17. Fully implemented, test exists. Sent as data frame without ACK
+ *   (see CC2530BEE_FRAME_TYPE_REMOTEAT), nodes answer broadcast requests after a jitter of up to CC2530BEE_REMOTEAT_JITTER.
+ * - Remote Command Response: API Identifier Value: 0x97. Fully implemented, test exists. No response is generated if
+ *   request or response is lost.
  * - TX (Transmit) Request: 64-bit address: API Identifier Value: 0x00. Fully implemented, test exists
  * - TX (Transmit) Request: 16-bit address: API Identifier Value: 0x01. Fully implemented, test exists
- * - TX (Transmit) Status: API Identifier Value: 0x89. Fully implemented, test exists (not all return values can be tested)
+ * - TX (Transmit) Status: API Identifier Value: 0x89. Fully implemented, test exists. Sent once ACK was received, after RR
+ *   retries without ACK (NOACK), after CSMA-CA found channel busy too often (CCA failure) or if radio was re-initialized
+ *   meanwhile (purged). No TX status for frame ID 0.
+ * - TX requests with more than CC2530BEE_MAX_FRAME_PAYLOAD_LENGTH bytes of payload (up to FRAGMENT_MAX_PAYLOAD_LENGTH) are
+ *   sent in fragments (see CC2530BEE_FRAME_TYPE_FRAGMENT) with one TX status for all of them. Receiver reassembles fragments
+ *   arriving in order in one of REASSEMBLY_NUM_BUFFERS buffers and sends one RX packet.
  * - RX (Receive) Packet: 64-bit Address: API Identifier Value: 0x80. Fully implemented, test exists
  * - RX (Receive) Packet: 16-bit Address: API Identifier Value: 0x81. Fully implemented, test exists
+ * - Trace Dump Request: API Identifier Value: 0x45 (not defined by XBee). Answered by Trace Dump 0xc5 with the trace points
+ *   recorded since last dump (see Trace.h), only recorded if TRACE_ENABLE is defined. Test exists.
+ * - Neighbour Table Request: API Identifier Value: 0x46 (not defined by XBee). Answered by Neighbour Table 0xc6 with link
+ *   quality of all nodes heard of (see Neighbour.h). Test exists.
 
- * Functionality missing:
- * ========================
- * - AT Command - Queue Parameter Value: API Identifier Value: 0x09
- * - Remote AT Command Request: API Identifier Value: 0x17
- * - Remote Command Response: API Identifier Value: 0x97
- * - All kind of non-volatile storage of parameters 
-
- * Supported AT commands:
+ * Supported AT commands (see #UARTAPI_atCommands, a new command only needs a table entry):
  * ========================
  * - Software Reset FR (R): 0x4652
  * - Channel CH (R/W): 0x4848
@@ -48,6 +69,50 @@
  * - Source Address 16Bit MY (R/W): 0x 4d59
  * - Serial number High SH (R): 0x5348
  * - Serial number Low SL (R): 0x534c
+ * - API Enable AP (R/W): 0x4150
+ * - Interface Data Rate BD (R/W): 0x4244. 1 (2400) to 7 (115200) as XBee, 8 selects 230400. New rate is set once response was sent.
+ * - Write WR: 0x5752. Appends configuration to flash (see ConfigStore.h), loaded on next boot.
+ * - Restore Defaults RE: 0x5245. Restores default configuration in RAM, use WR to store it. Queued changes are discarded.
+ * - Apply Changes AC: 0x4143. Applies queued changes, radio is re-initialized at most once.
+ * - MAC Retries RR (R/W): 0x5252. 0 to 7 retransmissions if no ACK was received.
+ * - Random Delay Slots RN (R/W): 0x524e. Minimum backoff exponent of CSMA-CA, 0 to 3.
+ * - Aggregation Window AG (R/W): 0x4147. TX requests to the same destination queued within this many milliseconds
+ *   are sent as one frame and split into separate RX packets by the receiver. Each frame ID gets its own TX status.
+ *   0 (default) disables aggregation.
+ * - Sleep Mode SM (R/W): 0x534d. 0 no sleep (default), 1 pin hibernate and 2 pin doze while SLEEP_RQ is high, 4 cyclic
+ *   sleep, 5 cyclic sleep with pin wake-up. Module only sleeps once UART, queues and radio are idle, CTS is deasserted
+ *   while asleep. Radio frames sent to a sleeping module are lost.
+ * - Cyclic Sleep Period SP (R/W): 0x5350. Sleep time of cyclic sleep in 10 ms, 0 disables cyclic sleep.
+ * - Time before Sleep ST (R/W): 0x5354. Milliseconds of inactivity after which cyclic sleep starts.
+ * - ACK Failures EA (R/W): 0x4541. Transmissions given up after RR retries without ACK, write 0 to reset.
+ * - CCA Failures EC (R/W): 0x4543. Transmissions given up as channel was busy, write 0 to reset.
+ * - Statistics XS (R/W): 0x5853. Counters of CC2530Bee_Statistics_t in one response: UART frames per API identifier and
+ *   errors, radio frames, ACK timeouts, CRC errors, duplicates, queue overflows, queue and frame pool high-water marks and
+ *   watchdog resets. Counters survive watchdog resets, write 0 to reset all of them.
+ * - Energy Scan ED: 0x4544. Samples energy on each channel of SC for 2^SD * 15.36 ms and responds with the peak energy
+ *   of each of them in -dBm, in channel order. UART is served during the scan, radio frames are held back until it is done.
+ * - Scan Channels SC (R/W): 0x5343. Channels scanned by ED and A2, bit 0 is channel 11. All channels by default.
+ * - Scan Duration SD (R/W): 0x5344. Exponent of scan time per channel, 0 to 15.
+ * - Coordinator Association A2 (R/W): 0x4132. Only bit 1 (reassign channel) is used: channels of SC are scanned at boot
+ *   and the one with least energy is used instead of CH. CH reads the channel chosen, WR stores it.
+ * - Link Quality LQ (R): 0x4c51. Without parameter number of neighbours in table, with index as parameter link quality
+ *   of that neighbour: address, smoothed RSSI, age, frames received and lost (sequence gaps), frames sent and ACKed.
+ *   The least recently seen of NEIGHBOUR_NUM_ENTRIES neighbours is replaced by a new one.
+ * - Duplicate Window DW (R/W): 0x4457. Milliseconds a received frame is remembered by source and sequence number, copies
+ *   received meanwhile (retransmissions after a lost ACK) are dropped and counted in XS. 0 disables suppression.
+ * - Sniffer Mode SN (R/W): 0x534e. 1 disables address filtering and ACKs and streams every frame received, including
+ *   beacons, ACKs, MAC commands and frames with CRC errors, as capture records (see Sniffer.h) instead of RX packets.
+ *   AT command frames are still answered in between, so SN 0 ends sniffing.
+
+ * Host simulation:
+ * ========================
+ * HostSim/Makefile builds the firmware logic of this file for Linux together with a port layer standing in for
+ * USART, DMA, radio, flash, watchdog and board functions (see HostSim/HostSim.h).
+ * - make check: runs ModuleTests/HostSimTest.c
+ * - make bench: reports frames/s and cycles per frame for each API identifier and latency of traced stages. Trace points
+ *   are compiled in unless TRACE=0 is given, Timer 1 follows host time so that traces have the same format as on target.
+ * - cc2530bee_sim -p: runs the firmware on a pseudo terminal which can be passed to ModuleTests/BaseTest.py
+ * - cc2530bee_pcap: converts capture records of sniffer mode read from a serial port or stdin to pcap
 */
 
 /**
@@ -55,33 +120,253 @@
 */
 CC2530Bee_Config_t CC2530Bee_Config;
 
+/**
+  * Configuration including tx header template with changes staged by AT
+  * commands but not applied yet. Only valid if CC2530Bee_pendingChanges is not 0.
+*/
+CC2530Bee_Config_t CC2530Bee_shadowConfig;
+
+/**
+  * Side effects (CC2530BEE_CONFIGCHANGE_*) of changes in CC2530Bee_shadowConfig
+*/
+uint8_t CC2530Bee_pendingChanges;
+
 /**
   * For each frame that is sent or received a buffer must be allocated before
   * sending or receiving.
-  * For this a message element (struct, array etc.) must be declared and allocated
-  * to which the payload pointer of the IEEE802154_header_t will point.
+  * The payload pointer of IEEE802154_RxDataFrame points to a frame pool buffer
+  * which is handed over to receive queue once a frame was received into it.
   */
 IEEE802154_DataFrameHeader_t  IEEE802154_TxDataFrame;
 IEEE802154_DataFrameHeader_t  IEEE802154_RxDataFrame;
-IEEE802154_Payload radioRxPayload[100];
 
+/**
+ * Header used for the frame currently being sent. Loaded from
+ * #IEEE802154_TxDataFrame and altered per transmission.
+ */
+IEEE802154_DataFrameHeader_t radioTxFrame;
+
+/**
+ * CSMA-CA and ACK wait state of frame currently being sent
+ */
+CC2530Bee_RadioTx_t CC2530Bee_radioTx;
+
+/**
+ * Payload of radio frame not sent directly from transmit queue slot, i.e.
+ * aggregated frame (see CC2530Bee_aggregatePayload) or fragment (see
+ * CC2530Bee_fragment)
+ */
+IEEE802154_Payload CC2530Bee_radioTxPayload[CC2530BEE_MAX_FRAME_PAYLOAD_LENGTH];
+
+/**
+ * Tag of last fragmented payload sent
+ */
+uint8_t CC2530Bee_fragmentTag;
+
+/**
+ * Buffers for fragmented payloads being received
+ */
+CC2530Bee_Reassembly_t CC2530Bee_reassembly[REASSEMBLY_NUM_BUFFERS];
+
+/**
+ * State of pseudo random generator for CSMA-CA backoffs, see CC2530Bee_random
+ */
+uint16_t CC2530Bee_randomState;
+
+/**
+ * Sequence number of next radio frame sent (DSN). Retransmissions keep the
+ * number, so that receivers can drop copies (see Duplicate.h).
+ */
+uint8_t CC2530Bee_sequenceNumber;
+
+/**
+ * UART API frames received and sent. Data of received frame is a transmit
+ * queue slot, data of frame sent is a reserved frame pool buffer taken while
+ * a response is built, see FramePool_allocReserved.
+ */
 APIFrame_t rxAPIFrame;
-APIFramePayload_t uartRxPayload[100];
 APIFrame_t txAPIFrame;
-APIFramePayload_t uartTxPayload[100];
+
+/**
+ * State of incremental UART API frame receiver
+ */
+UARTAPI_RxParser_t UARTAPI_rxParser;
+
+/**
+ * Frame codecs of API mode 2 (escaped) and 1 (unescaped) and the one in use
+ */
+const UARTAPI_Codec_t UARTAPI_codecEscaped = { UARTAPI_writeEscaped, UARTAPI_receiveDataEscaped };
+const UARTAPI_Codec_t UARTAPI_codecUnescaped = { UARTAPI_writeUnescaped, UARTAPI_receiveDataUnescaped };
+const UARTAPI_Codec_t *UARTAPI_codec = &UARTAPI_codecEscaped;
+
+/**
+ * USART baud rate settings for BD values starting at #UARTAPI_BAUDRATE_FIRST
+ * (XBee numbering, 8 is not defined by XBee)
+ */
+static const __code USART_Baudrate_t UARTAPI_baudrates[UARTAPI_NUM_BAUDRATES] = {
+  USART_Baudrate_2400,          /* 1 */
+  USART_Baudrate_4800,          /* 2 */
+  USART_Baudrate_9600,          /* 3 */
+  USART_Baudrate_19200,         /* 4 */
+  USART_Baudrate_38400,         /* 5 */
+  USART_Baudrate_57600,         /* 6 */
+  USART_Baudrate_115200,        /* 7 */
+  USART_Baudrate_230400,        /* 8 */
+};
+
+/**
+ * Supported AT commands, must be sorted by command (see UARTAPI_findATCommand)
+ */
+const __code UARTAPI_ATCommand_t UARTAPI_atCommands[UARTAPI_NUM_ATCOMMANDS] = {
+  { UARTAPI_ATCOMMAND_COORDINATORASSOCIATION, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE,
+    offsetof(CC2530Bee_Config_t, CoordinatorAssociation), sizeof(uint8_t),
+    0, CC2530BEE_A2_LAST, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_APPLYCHANGES, UARTAPI_ATPARAM_EXECUTE, 0, 0, 0, 0, 0, CC2530Bee_applyConfig },
+  { UARTAPI_ATCOMMAND_AGGREGATIONWINDOW, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE,
+    offsetof(CC2530Bee_Config_t, AggregationWindow), sizeof(uint8_t),
+    0, 0xff, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_APIENABLE, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE,
+    offsetof(CC2530Bee_Config_t, APIMode), sizeof(uint8_t),
+    CC2530BEE_APIMODE_TRANSPARENT, CC2530BEE_APIMODE_ESCAPED, CC2530BEE_CONFIGCHANGE_APIMODE, NULL },
+  { UARTAPI_ATCOMMAND_BAUDRATE, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE | UARTAPI_ATPARAM_BAUDRATE,
+    offsetof(CC2530Bee_Config_t, USART_Baudrate), sizeof(uint8_t),
+    UARTAPI_BAUDRATE_FIRST, UARTAPI_BAUDRATE_FIRST + UARTAPI_NUM_BAUDRATES - 1, CC2530BEE_CONFIGCHANGE_BAUDRATE, NULL },
+  { UARTAPI_ATCOMMAND_CHANNEL, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE,
+    offsetof(CC2530Bee_Config_t, IEEE802154_config.Channel), sizeof(uint8_t),
+    CC2530BEE_CHANNEL_FIRST, CC2530BEE_CHANNEL_LAST, CC2530BEE_CONFIGCHANGE_RADIO, NULL },
+  { UARTAPI_ATCOMMAND_DESTINATIONADDRESSHIGH, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE | UARTAPI_ATPARAM_TXHEADER,
+    offsetof(IEEE802154_DataFrameHeader_t, destinationAddress.extendedAdress[4]), sizeof(IEEE802154_ExtendedAddress_t)/2,
+    0, 0, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_DESTINATIONADDRESSLOW, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE | UARTAPI_ATPARAM_TXHEADER,
+    offsetof(IEEE802154_DataFrameHeader_t, destinationAddress.extendedAdress[0]), sizeof(IEEE802154_ExtendedAddress_t)/2,
+    0, 0, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_DUPLICATEWINDOW, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE | UARTAPI_ATPARAM_NUMBER,
+    offsetof(CC2530Bee_Config_t, DuplicateWindow), sizeof(uint16_t),
+    0, 0, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_ACKFAILURES, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE | UARTAPI_ATPARAM_STATISTICS | UARTAPI_ATPARAM_NUMBER,
+    offsetof(CC2530Bee_Statistics_t, ackFailures), sizeof(uint16_t),
+    0, 0, 0, NULL },
+  { UARTAPI_ATCOMMAND_CCAFAILURES, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE | UARTAPI_ATPARAM_STATISTICS | UARTAPI_ATPARAM_NUMBER,
+    offsetof(CC2530Bee_Statistics_t, ccaFailures), sizeof(uint16_t),
+    0, 0, 0, NULL },
+  { UARTAPI_ATCOMMAND_ENERGYSCAN, UARTAPI_ATPARAM_EXECUTE | UARTAPI_ATPARAM_DEFERRED, 0, 0, 0, 0, 0, CC2530Bee_energyScan },
+  { UARTAPI_ATCOMMAND_SOFTWARERESET, UARTAPI_ATPARAM_EXECUTE, 0, 0, 0, 0, 0, CC2530Bee_softwareReset },
+  { UARTAPI_ATCOMMAND_PANID, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE,
+    offsetof(CC2530Bee_Config_t, IEEE802154_config.PanID), sizeof(IEEE802154_PANIdentifier_t),
+    0, 0, CC2530BEE_CONFIGCHANGE_RADIO, NULL },
+  { UARTAPI_ATCOMMAND_LINKQUALITY, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_NEIGHBOUR, 0, NEIGHBOUR_ENTRY_LENGTH, 0, 0, 0, NULL },
+  { UARTAPI_ATCOMMAND_SOURCEADDRESS16BIT, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE | UARTAPI_ATPARAM_TXHEADER,
+    offsetof(IEEE802154_DataFrameHeader_t, sourceAddress.shortAddress), sizeof(IEEE802154_ShortAddress_t),
+    0, 0, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_RESTOREDEFAULTS, UARTAPI_ATPARAM_EXECUTE, 0, 0, 0, 0, 0, CC2530Bee_restoreDefaults },
+  { UARTAPI_ATCOMMAND_RANDOMDELAYSLOTS, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE,
+    offsetof(CC2530Bee_Config_t, MinBackoffExponent), sizeof(uint8_t),
+    0, CC2530BEE_MIN_BACKOFF_EXPONENT_LAST, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_MACRETRIES, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE,
+    offsetof(CC2530Bee_Config_t, MACRetries), sizeof(uint8_t),
+    0, CC2530BEE_MACRETRIES_LAST, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_SCANCHANNELS, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE | UARTAPI_ATPARAM_NUMBER,
+    offsetof(CC2530Bee_Config_t, ScanChannels), sizeof(uint16_t),
+    0, 0, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_SCANDURATION, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE,
+    offsetof(CC2530Bee_Config_t, ScanDuration), sizeof(uint8_t),
+    0, CC2530BEE_SCANDURATION_LAST, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_SERIALNUMBERHIGH, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_TXHEADER,
+    offsetof(IEEE802154_DataFrameHeader_t, sourceAddress.extendedAdress[4]), sizeof(IEEE802154_ExtendedAddress_t)/2,
+    0, 0, 0, NULL },
+  { UARTAPI_ATCOMMAND_SERIALNUMBERLOW, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_TXHEADER,
+    offsetof(IEEE802154_DataFrameHeader_t, sourceAddress.extendedAdress[0]), sizeof(IEEE802154_ExtendedAddress_t)/2,
+    0, 0, 0, NULL },
+  { UARTAPI_ATCOMMAND_SLEEPMODE, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE,
+    offsetof(CC2530Bee_Config_t, SleepMode), sizeof(uint8_t),
+    CC2530BEE_SLEEPMODE_NONE, CC2530BEE_SLEEPMODE_CYCLIC_PIN, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_SNIFFERMODE, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE,
+    offsetof(CC2530Bee_Config_t, SnifferMode), sizeof(uint8_t),
+    CC2530BEE_SNIFFERMODE_OFF, CC2530BEE_SNIFFERMODE_ON, CC2530BEE_CONFIGCHANGE_RADIO, NULL },
+  { UARTAPI_ATCOMMAND_SLEEPPERIOD, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE | UARTAPI_ATPARAM_NUMBER,
+    offsetof(CC2530Bee_Config_t, SleepPeriod), sizeof(uint16_t),
+    0, 0, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_TIMEBEFORESLEEP, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE | UARTAPI_ATPARAM_NUMBER,
+    offsetof(CC2530Bee_Config_t, TimeBeforeSleep), sizeof(uint16_t),
+    0, 0, CC2530BEE_CONFIGCHANGE_PARAMETER, NULL },
+  { UARTAPI_ATCOMMAND_WRITE, UARTAPI_ATPARAM_EXECUTE, 0, 0, 0, 0, 0, CC2530Bee_writeConfig },
+  { UARTAPI_ATCOMMAND_STATISTICS, UARTAPI_ATPARAM_READ | UARTAPI_ATPARAM_WRITE | UARTAPI_ATPARAM_STATISTICS,
+    0, sizeof(CC2530Bee_Statistics_t),
+    0, 0, 0, NULL },
+};
+
+/**
+ * Response to remote AT command request waiting to be sent
+ */
+CC2530Bee_RemoteATResponse_t CC2530Bee_remoteATResponse;
+
+/**
+ * Frame currently collected from UART in transparent mode
+ */
+CC2530Bee_TransparentTx_t CC2530Bee_transparentTx;
+
+/**
+ * Character class (UARTAPI_CHARCLASS_*) of each byte value. Allows sending
+ * runs of bytes which need no escaping and receiving runs of plain data
+ * bytes with a single lookup per byte.
+ */
+static const __code uint8_t UARTAPI_charClass[256] = {
+  [UARTFrame_XON] = UARTAPI_CHARCLASS_ESCAPE,
+  [UARTFrame_XOFF] = UARTAPI_CHARCLASS_ESCAPE,
+  [UARTFrame_Escape_Character] = UARTAPI_CHARCLASS_ESCAPE | UARTAPI_CHARCLASS_CONTROL,
+  [UARTFrame_Delimiter] = UARTAPI_CHARCLASS_ESCAPE | UARTAPI_CHARCLASS_CONTROL,
+};
+
+/**
+ * Sleep state (SM)
+*/
+CC2530Bee_Sleep_t CC2530Bee_sleep;
+
+/**
+ * Runtime statistics (XS). Not initialized by startup code, so that counters
+ * survive watchdog resets, see CC2530Bee_init.
+*/
+__no_init CC2530Bee_Statistics_t CC2530Bee_statistics;
+__no_init uint16_t CC2530Bee_statisticsMagic;
+
+/**
+ * Energy scan (ED, A2)
+*/
+CC2530Bee_Scan_t CC2530Bee_scan;
+
+/**
+ * Frame ID of UARTAPI_ATPARAM_DEFERRED command being executed
+*/
+uint8_t UARTAPI_deferredFrameId;
 
 /**
  * State of main state machine
 */
 CC2530BeeState_t CC2530BeeState = CC2530BeeState_Normal;
 
+/**
+ * Firmware entry point. Initializes the module and then runs the main loop
+ * forever.
+ */
+#ifndef CC2530BEE_HOSTSIM
 void main( void )
 {
-  uint16_t atCommand;
-  IEEE802154_PANIdentifier_t tempPanID;
-  uint8_t UART_rxLength = 0;
-  uint8_t led_status = 0;
-  sleepTimer_t sleepTime;
+  CC2530Bee_init();
+  /* now everyhting is set-up, start main loop now */
+  while(1)
+  {
+    CC2530Bee_mainFunction();
+  }  // while(1)
+}
+#endif
+
+/**
+ * Initializes board, configuration, USART and radio and reports reset reason
+ * via USART. Watchdog will be enabled as last step.
+ */
+void CC2530Bee_init(void)
+{
+  uint8_t i;
   Board_init(); /* calls CC253x_Init */
   /*P0DIR_0 = HAL_PINOUTPUT;
   P0DIR_2 = HAL_PINOUTPUT;
@@ -89,20 +374,59 @@ void main( void )
   P0DIR_4 = HAL_PINOUTPUT;*/
   P0DIR_4 = HAL_PININPUT;
   P0DIR_5 = HAL_PININPUT;
+  P0DIR_1 = HAL_PININPUT;
+  P0DIR_0 = HAL_PINOUTPUT;
+  CC2530BEE_CTS_PIN = CC2530BEE_CTS_ASSERTED;
   
   CC2530Bee_loadConfig(&CC2530Bee_Config);
+  UARTAPI_setAPIMode(CC2530Bee_Config.APIMode);
   ledInit();
   
-  /* Prepare rx and tx UART frames */
-  rxAPIFrame.data = uartRxPayload;
-  txAPIFrame.data = uartTxPayload;
+  Trace_init();
+  /* Prepare rx and tx UART frames. Rx frames are received into transmit queue
+   * slots, both take their buffers from frame pool */
+  FramePool_init();
+  TxQueue_init();
+  memset(&UARTAPI_rxParser, 0, sizeof(UARTAPI_rxParser));
   UART_init();
-  USART_setBaudrate(CC2530Bee_Config.USART_Baudrate);
+  UartDma_init();
+  memset(&CC2530Bee_transparentTx, 0, sizeof(CC2530Bee_transparentTx));
+  CC2530Bee_remoteATResponse.length = 0;
+  CC2530Bee_remoteATResponse.queued = 0;
+  memset(&CC2530Bee_radioTx, 0, sizeof(CC2530Bee_radioTx));
+  for (i=0; i<REASSEMBLY_NUM_BUFFERS; i++)
+  {
+    CC2530Bee_reassembly[i].inUse = 0;
+  }
+  /* Seed backoff generator with own 64bit address, so that nodes do not back off in lockstep */
+  CC2530Bee_randomState = 0xace1;
+  for (i=0; i<sizeof(IEEE802154_ExtendedAddress_t); i++)
+  {
+    CC2530Bee_randomState = CC2530Bee_randomState * 31 + IEEE802154_TxDataFrame.sourceAddress.extendedAdress[i];
+  }
+  if (CC2530Bee_randomState == 0)
+  {
+    CC2530Bee_randomState = 0xace1;
+  }
+  /* random start, so that frames sent after a reset are not taken as copies of earlier ones */
+  CC2530Bee_sequenceNumber = CC2530Bee_random() ^ (uint8_t)CC2530Bee_readSleepTimer();
+  CC2530Bee_setBaudrate(CC2530Bee_Config.USART_Baudrate);
   USART_setParity(CC2530Bee_Config.USART_Parity);
   
   /* Prepare rx buffer for IEEE 802.15.4 */
-  IEEE802154_RxDataFrame.payload = radioRxPayload;
-  IEEE802154_radioInit(&(CC2530Bee_Config.IEEE802154_config));
+  IEEE802154_RxDataFrame.payload = FramePool_alloc();
+  RxQueue_init();
+  Neighbour_init();
+  Duplicate_init((uint32_t)CC2530Bee_Config.DuplicateWindow * CC2530BEE_SLEEPTIMER_FREQUENCY / 1000);
+  Sniffer_init();
+  CC2530Bee_radioInit();
+  /* Channel is reassigned once scan is done, frames are held back meanwhile */
+  memset(&CC2530Bee_scan, 0, sizeof(CC2530Bee_scan));
+  if (CC2530Bee_Config.CoordinatorAssociation & CC2530BEE_A2_REASSIGN_CHANNEL)
+  {
+    CC2530Bee_scan.reassign = 1;
+    CC2530Bee_scan.state = CC2530BeeScan_Pending;
+  }
   /* Tx source address is preloaded with chip's own 64bit address. Check if it should be used. */
   if (IEEE802154_TxDataFrame.sourceAddress.shortAddress == CC2530BEE_USE_64BIT_ADDRESSING)
   {
@@ -112,446 +436,2364 @@ void main( void )
     IEEE802154_TxDataFrame.fcf.sourceAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
   }
   enableAllInterrupt();
+  CC2530Bee_sleep.asleep = 0;
+  CC2530Bee_sleep.lastActivity = CC2530Bee_getSleepTimer();
   
-  //sleepTime.value = 0xffff;
+  /* RAM content is undefined after power-on */
+  if ((CC2530Bee_statisticsMagic != CC2530BEE_STATISTICS_MAGIC) ||
+      ((SLEEPSTA & SLEEPSTA_RST_MASK) == SLEEPSTA_RST_POWERONRESET))
+  {
+    CC2530Bee_clearStatistics();
+  }
+  if ((SLEEPSTA & SLEEPSTA_RST_MASK) == SLEEPSTA_RST_WATCHDOGRESET)
+  {
+    CC2530Bee_statistics.watchdogResets++;
+  }
   
-  /* Check for reset reason and report via USART */
+  /* Check for reset reason and report via USART (API mode only) */
+  txAPIFrame.data = FramePool_allocReserved();
   txAPIFrame.data[0] = UARTAPI_MODEMSTATUS;
-  if ((SLEEPSTA & SLEEPSTA_RST_MASK) == SLEEPSTA_RST_EXTERNALRESET)
+  if (CC2530Bee_Config.APIMode == CC2530BEE_APIMODE_TRANSPARENT)
+  {
+    /* no modem status in transparent mode */
+  }
+  else if ((SLEEPSTA & SLEEPSTA_RST_MASK) == SLEEPSTA_RST_EXTERNALRESET)
   {
     txAPIFrame.data[UARTAPI_MODEMSTATUS_DATA] = UARTAPI_MODEMSTATUS_HARDWARE_RESET;
    UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_MODEMSTATUS_LENGTH); 
+    CC2530Bee_statistics.uartTxModemStatus++;
   }
-  if ((SLEEPSTA & SLEEPSTA_RST_MASK) == SLEEPSTA_RST_WATCHDOGRESET)
+  else if ((SLEEPSTA & SLEEPSTA_RST_MASK) == SLEEPSTA_RST_WATCHDOGRESET)
   {
     txAPIFrame.data[UARTAPI_MODEMSTATUS_DATA] = UARTAPI_MODEMSTATUS_WATCHDOG_RESET;
     UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_MODEMSTATUS_LENGTH);
+    CC2530Bee_statistics.uartTxModemStatus++;
   }
+  FramePool_release(txAPIFrame.data);
   
   /* Enable watchdog to 250ms */
   WDT_init(WDT_INT_CLOCKTIMES8192);
   
-  /* now everyhting is set-up, start main loop now */
-  while(1)
+}
+
+/**
+ * One iteration of the main loop. Checks for state changes, feeds bytes
+ * received via USART to frame parser and dispatches frame once complete.
+ */
+void CC2530Bee_mainFunction(void)
+{
+  TxQueue_Slot_t *txSlot;
+  RxQueue_Slot_t *rxSlot;
+  uint8_t numFrames;
+  uint8_t rxStatus;
+  static uint8_t led_status = 0;
+  WDT_trigger();
+  /* while asleep neither UART nor radio is served, see CC2530Bee_sleepPoll.
+   * Once woken up, bytes held back by host are read in the same iteration. */
+  if (CC2530Bee_sleep.asleep)
   {
-    WDT_trigger();
-    /* Analyze current state, if in state CC2530BeeState_Normal read from UART */
-    if (CC2530BeeState == CC2530BeeState_ReInitIEEE802154)
+    CC2530Bee_sleepPoll();
+    if (CC2530Bee_sleep.asleep)
     {
-      IEEE802154_radioInit(&(CC2530Bee_Config.IEEE802154_config));
-      CC2530BeeState = CC2530BeeState_Normal;
+      return;
     }
-    /* if enough bytes in Rx buffer parse it */
-    if (USART_numBytesInRxBuffer() >= sizeof(APIFrameHeader_t))
+  }
+  /* New baud rate is set once AT command response left USART completely */
+  if ((CC2530BeeState == CC2530BeeState_SetBaudrate) && (UartDma_numBytesInTxBuffer() == 0))
+  {
+    CC2530Bee_setBaudrate(CC2530Bee_Config.USART_Baudrate);
+    CC2530BeeState = CC2530BeeState_Normal;
+  }
+  /* Feed bytes received so far to frame parser. Never blocks, returns
+   * UARTFrame_Incomplete until a whole frame was received. Frames are received
+   * directly into next free slot of transmit queue, which takes a frame pool
+   * buffer once bytes arrived. If queue or pool is full, bytes stay in DMA rx
+   * buffer until radio freed a slot. */
+  rxStatus = UARTFrame_Incomplete;
+  if (CC2530BeeState == CC2530BeeState_SetBaudrate)
+  {
+    /* bytes received meanwhile stay in DMA rx buffer until new baud rate is set */
+  }
+  else if (CC2530Bee_Config.APIMode == CC2530BEE_APIMODE_TRANSPARENT)
+  {
+    CC2530Bee_transparentReceive();
+  }
+  else if (UartDma_rxAvailable() || (UARTAPI_numBytesInRxBuffer() > 0))
+  {
+    rxAPIFrame.data = TxQueue_getFreeSlot();
+    if (rxAPIFrame.data != NULL)
     {
-      /* receive header via UART and convert length to little-endian */
-      USART_read((char *)&(rxAPIFrame.header), sizeof(APIFrameHeader_t));
-      /* received data is big-endian, mcu is little endian */
-      SWAP_UINT16(rxAPIFrame.header.length);
-      /* @todo Check for frame length to be maximum of buffer */
-      /* only proceed if CRC was ok */
-      if ((rxAPIFrame.header.delimiter == UARTFrame_Delimiter) && UARTAPI_receiveFrame(&rxAPIFrame) == UARTFrame_CRC_OK)
-      {
-        switch (rxAPIFrame.data[0])
-          {
-            case UARTAPI_ATCOMMAND:
-              if (rxAPIFrame.header.length == UARTAPI_ATCOMMAND_READ_LENGTH)
-              {
-                UARTAPI_readParameter(rxAPIFrame.data);
-              }
-              else {
-                UARTAPI_setParameter(rxAPIFrame.data);
-              }
-              break;
-            case UARTAPI_ATCOMMAND_QUEUE:
-              break;
-            case UARTAPI_REMOTE_AT_COMMAND_REQUEST:
-              USART_writeline("Option 01 selected");
-              break;
-            case UARTAPI_TRAMSMIT_REQUEST_64BIT:
-              IEEE802154_TxDataFrame.sequenceNumber = rxAPIFrame.data[UARTAPI_64BITTRANSMIT_FRAMEID];
-              memcpy(&(IEEE802154_TxDataFrame.destinationAddress.extendedAdress), &(rxAPIFrame.data[UARTAPI_64BITTRANSMIT_ADDRESS]), sizeof(IEEE802154_ExtendedAddress_t) );
-              /* save PAN ID in temporary variable in case it needs to be altered for this transmission */
-              tempPanID = IEEE802154_TxDataFrame.destinationPANID;
-              if (rxAPIFrame.data[UARTAPI_64BITTRANSMIT_OPTIONS] & UARTAPI_TRANSMIT_OPTIONS_DISABLEACK) {
-                IEEE802154_TxDataFrame.fcf.ackRequired = 0;
-              }
-              if (rxAPIFrame.data[UARTAPI_64BITTRANSMIT_OPTIONS] & UARTAPI_TRANSMIT_OPTIONS_BROADCASTPANID) {
-                IEEE802154_TxDataFrame.destinationPANID = IEEE802154_BROADCAST_PAN_ID;
-              }
-              /* set correct address mode in fcf for destination address. The corresponding bit for source address will 
-               * be set whenever source address is changed */
-              IEEE802154_TxDataFrame.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_64BIT;
-              /* point IEEE802154 payload pointer to data received via UART */
-              IEEE802154_TxDataFrame.payload = &(rxAPIFrame.data[UARTAPI_64BITTRANSMIT_DATA]);
-              IEEE802154_radioSentDataFrame(&(IEEE802154_TxDataFrame), rxAPIFrame.header.length - UARTAPI_64BITTRANSMIT_DATA);
-              /* reset values back to "normal" which might have been changed above */
-              IEEE802154_TxDataFrame.destinationPANID = tempPanID;
-              IEEE802154_TxDataFrame.fcf.ackRequired = 1;
-              break;
-            case UARTAPI_TRAMSMIT_REQUEST_16BIT:
-              IEEE802154_TxDataFrame.sequenceNumber = rxAPIFrame.data[UARTAPI_16BITTRANSMIT_FRAMEID];
-              IEEE802154_TxDataFrame.destinationAddress.shortAddress = *((IEEE802154_ShortAddress_t*)&rxAPIFrame.data[UARTAPI_16BITTRANSMIT_ADDRESS]);
-              /* save PAN ID in temporary variable in case it needs to be altered for this transmission */
-              tempPanID = IEEE802154_TxDataFrame.destinationPANID;
-              if (rxAPIFrame.data[UARTAPI_16BITTRANSMIT_OPTIONS] & UARTAPI_TRANSMIT_OPTIONS_DISABLEACK) {
-                IEEE802154_TxDataFrame.fcf.ackRequired = 0;
-              }
-              if (rxAPIFrame.data[UARTAPI_16BITTRANSMIT_OPTIONS] & UARTAPI_TRANSMIT_OPTIONS_BROADCASTPANID) {
-                IEEE802154_TxDataFrame.destinationPANID = IEEE802154_BROADCAST_PAN_ID;
-              }
-              /* set correct address mode in fcf for destination address. The corresponding bit for source address will 
-               * be set whenever source address is changed */
-              IEEE802154_TxDataFrame.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
-              /* point IEEE802154 payload pointer to data received via UART */
-              IEEE802154_TxDataFrame.payload = &(rxAPIFrame.data[UARTAPI_16BITTRANSMIT_DATA]);
-              IEEE802154_radioSentDataFrame(&(IEEE802154_TxDataFrame), rxAPIFrame.header.length - UARTAPI_16BITTRANSMIT_DATA);
-              /* reset values back to "normal" which might have been changed above */
-              IEEE802154_TxDataFrame.destinationPANID = tempPanID;
-              IEEE802154_TxDataFrame.fcf.ackRequired = 1;
-              break;
-            case UARTAPI_ECHOTEST:
-              /* Service only implemented for USART testing 
-               * Will sent every valid frame back exactly as it was received */
-              UARTAPI_sentFrame(uartRxPayload, rxAPIFrame.header.length);
-              break;
-            /* no default as the frame will be silently discarded */
-          }
-      }
-      else {
-        /* if crc NOT_OK just ignore the frame */
-      }
-      led_status = ~led_status;
+      rxStatus = UARTAPI_receiveFrame(&rxAPIFrame);
+    }
+  }
+  if (rxStatus != UARTFrame_Incomplete)
+  {
+    /* only proceed if CRC was ok */
+    if (rxStatus == UARTFrame_CRC_OK)
+    {
+      TRACE(TRACE_DISPATCH, rxAPIFrame.data[0]);
+      switch (rxAPIFrame.data[0])
+        {
+          case UARTAPI_ATCOMMAND:
+          case UARTAPI_ATCOMMAND_QUEUE:
+            CC2530Bee_statistics.uartRxATCommand++;
+            UARTAPI_atCommand(rxAPIFrame.data, rxAPIFrame.header.length);
+            break;
+          case UARTAPI_REMOTE_AT_COMMAND_REQUEST:
+            CC2530Bee_statistics.uartRxRemoteAT++;
+            TxQueue_commit(rxAPIFrame.header.length);
+            break;
+          case UARTAPI_TRAMSMIT_REQUEST_64BIT:
+          case UARTAPI_TRAMSMIT_REQUEST_16BIT:
+            /* Frame was received directly into transmit queue slot, hand it over to radio side */
+            CC2530Bee_statistics.uartRxTxRequest++;
+            TxQueue_commit(rxAPIFrame.header.length);
+            break;
+          case UARTAPI_ECHOTEST:
+            /* Service only implemented for USART testing 
+             * Will sent every valid frame back exactly as it was received */
+            CC2530Bee_statistics.uartRxEcho++;
+            UARTAPI_sentFrame(rxAPIFrame.data, rxAPIFrame.header.length);
+            break;
+          case UARTAPI_TRACE_DUMP_REQUEST:
+            UARTAPI_traceDump(rxAPIFrame.data, rxAPIFrame.header.length);
+            break;
+          case UARTAPI_NEIGHBOUR_TABLE_REQUEST:
+            UARTAPI_neighbourTable(rxAPIFrame.data, rxAPIFrame.header.length);
+            break;
+          default:
+            /* frame is silently discarded */
+            CC2530Bee_statistics.uartRxUnknown++;
+            break;
+        }
     }
     else {
-      /* noting */
+      /* if crc NOT_OK just ignore the frame */
+      CC2530Bee_statistics.uartChecksumErrors++;
     }
-    /* ledOn();
-    IEEE802154_radioSentDataFrame(&sentFrameOne, sizeof(sensorInformation_t));
-    ledOff();
-    CC253x_IncrementSleepTimer(sleepTime);
-    CC253x_ActivatePowerMode(SLEEPCMD_MODE_PM2);*/
-  }  // while(1)
+    /* buffer of frame not queued goes back to pool */
+    TxQueue_discard();
+    led_status = ~led_status;
+  }
+  else {
+    /* noting */
+  }
+  /* Energy scan retunes radio, so nothing is sent while it runs */
+  CC2530Bee_scanPoll();
+  /* Sent oldest queued frame, together with the following ones if they are
+   * aggregated. Slots are kept until outcome is known, meanwhile further frames
+   * are received via UART into the other slots. */
+  txSlot = ((CC2530Bee_radioTx.state == CC2530BeeRadioTx_Idle) && (CC2530Bee_scan.state != CC2530BeeScan_Running)) ?
+           TxQueue_peek() : NULL;
+  numFrames = (txSlot != NULL) ? CC2530Bee_aggregate() : 0;
+  if (numFrames > 0)
+  {
+    if (!CC2530Bee_radioTransmit(txSlot->data, txSlot->length))
+    {
+      TxQueue_release();
+    }
+    else if (numFrames > 1)
+    {
+      CC2530Bee_aggregatePayload(numFrames);
+    }
+  }
+  CC2530Bee_radioTxPoll();
+  /* Sent oldest frame received via radio. Done here and not in radio
+   * interrupt as it takes up to 20ms at 57600 baud. */
+  rxSlot = (CC2530BeeState == CC2530BeeState_SetBaudrate) ? NULL : RxQueue_peek();
+  if ((rxSlot != NULL) && CC2530Bee_deliverRxFrame(rxSlot))
+  {
+    RxQueue_release();
+  }
+  /* Capture records are sent in runs which fit into UART tx ring without waiting */
+  if (CC2530BeeState != CC2530BeeState_SetBaudrate)
+  {
+    Sniffer_poll();
+  }
+  CC2530Bee_remoteATPoll();
+  CC2530Bee_reassemblyPoll();
+  Neighbour_poll(CC2530Bee_getSleepTimer());
+  Duplicate_poll(CC2530Bee_getSleepTimer());
+  CC2530Bee_sleepPoll();
 }
 
 /**
- * Load config from EEPROM. If invalid CRC found default config is loaded
- * @param config Pointer to configuration struct in which to store the configuration read from EEPROM
- * @todo Implement EEPROM stuff
+ * Checks whether module may sleep, i.e. nothing is received or sent via UART
+ * and radio, queued or waiting for a timeout.
+ * @return 1 if idle
  */
-void CC2530Bee_loadConfig(CC2530Bee_Config_t *config)
+uint8_t CC2530Bee_isIdle(void)
 {
-  config->USART_Baudrate = USART_Baudrate_57600;
-  config->USART_Parity = USART_Parity_8BitNoParity;
-  
-  /* General radio configuration */
-  config->IEEE802154_config.Channel = CC2530BEE_Default_Channel;
-  config->IEEE802154_config.PanID = CC2530BEE_Default_PanID;
-  config->IEEE802154_config.shortAddress = CC2530BEE_Default_ShortAddress;
-  
-  /* prepare header for IEEE 802.15.4 Tx message. Values are stored in config but must be copied 
-   * to #IEEE802154_TxDataFrame in order to be effective. */
-  IEEE802154_TxDataFrame.fcf.frameType = IEEE802154_FCF_FRAME_TYPE_DATA;  /* 3: 0x01 */
-  IEEE802154_TxDataFrame.fcf.securityEnabled = IEEE802154_FCF_SECURITY_DISABLED; /* 1: 0x0 */
-  IEEE802154_TxDataFrame.fcf.framePending = 0x0; /* 1:0x0 */
-  IEEE802154_TxDataFrame.fcf.ackRequired = IEEE802154_FCF_ACKNOWLEDGE_REQUIRED; /* 1: 0x1 */
-#ifdef IEEE802154_ENABLE_PANID_COMPRESSION
-  IEEE802154_TxDataFrame.fcf.panIdCompression = IEEE802154_FCF_PANIDCOMPRESSION_ENABLED; /* 1: 0x1 */
-#else
-  IEEE802154_TxDataFrame.fcf.panIdCompression = IEEE802154_FCF_PANIDCOMPRESSION_DISABLED; /* 1: 0x0 */
-#endif
-  IEEE802154_TxDataFrame.fcf.destinationAddressMode = CC2530BEE_Default_DestinationAdressingMode;
-  IEEE802154_TxDataFrame.fcf.frameVersion = 0x00;
-  IEEE802154_TxDataFrame.fcf.sourceAddressMode = CC2530BEE_Default_SourceAdressingMode;
-  /* preset variable to some meaningfull values */
-  IEEE802154_TxDataFrame.sequenceNumber = 0x00;
-  IEEE802154_TxDataFrame.destinationPANID = CC2530BEE_Default_PanID;
-  IEEE802154_TxDataFrame.destinationAddress.shortAddress = 0xffff;   /* broadcast */
-  IEEE802154_TxDataFrame.sourceAddress.shortAddress = CC2530BEE_Default_ShortAddress;
-  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[0] = IEEE_EXTENDED_ADDRESS0;
-  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[1] = IEEE_EXTENDED_ADDRESS1;
-  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[2] = IEEE_EXTENDED_ADDRESS2;
-  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[3] = IEEE_EXTENDED_ADDRESS3;
-  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[4] = IEEE_EXTENDED_ADDRESS4;
-  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[5] = IEEE_EXTENDED_ADDRESS5;
-  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[6] = IEEE_EXTENDED_ADDRESS6;
-  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[7] = IEEE_EXTENDED_ADDRESS7;
-  
-  config->RO_PacketizationTimeout = CC2530BEE_Default_RO_PacketizationTimeout * 10;
-  
+  uint8_t i;
+  if ((CC2530BeeState != CC2530BeeState_Normal) ||
+      UartDma_rxAvailable() || (UARTAPI_numBytesInRxBuffer() > 0) ||
+      (UartDma_numBytesInTxBuffer() > 0) ||
+      (TxQueue_peek() != NULL) || (RxQueue_peek() != NULL) ||
+      (CC2530Bee_radioTx.state != CC2530BeeRadioTx_Idle) ||
+      (CC2530Bee_transparentTx.length > 0) ||
+      (CC2530Bee_remoteATResponse.length > 0) ||
+      (CC2530Bee_scan.state != CC2530BeeScan_Idle) ||
+      (Sniffer_pending() > 0))
+  {
+    return 0;
+  }
+  for (i=0; i<REASSEMBLY_NUM_BUFFERS; i++)
+  {
+    if (CC2530Bee_reassembly[i].inUse)
+    {
+      return 0;
+    }
+  }
+  return 1;
 }
 
 /**
- * Receives a frame via USART, un-escapes the data, copy the result to data
- * pointer of frame and calculates crc.
- * This function used blocking USART_getc function to read data from UART. Also 
- * make sure that enough space is be provided in frame->data pointer to receive
- * frame.
- * @param frame UART API frame with pre-filled header
- * @return UARTFrame_CRC_OK if crc matched, UARTFrame_CRC_Not_OK else
+ * Runs sleep mode (SM) state machine at end of each main loop iteration.
+ * Awake, module goes to sleep once it is idle and SLEEP_RQ is high (pin
+ * sleep) or ST passed since it was busy last (cyclic sleep). Asleep, it wakes
+ * up once SLEEP_RQ is low (pin sleep, cyclic sleep with pin wake-up) or SP
+ * passed (cyclic sleep), else it sleeps on for at most
+ * #CC2530BEE_SLEEP_MAX_TICKS.
  */
-uint8_t UARTAPI_receiveFrame(APIFrame_t *frame)
+void CC2530Bee_sleepPoll(void)
 {
-  APIFramePayload_t *dataPtr = frame->data;
-  uint8_t crc = 0;
-  for (uint16_t i=0; i<frame->header.length; i++)
+  uint8_t mode = CC2530Bee_Config.SleepMode;
+  uint8_t pinSleep = (mode == CC2530BEE_SLEEPMODE_PIN_HIBERNATE) || (mode == CC2530BEE_SLEEPMODE_PIN_DOZE);
+  uint8_t cyclicSleep = ((mode == CC2530BEE_SLEEPMODE_CYCLIC) || (mode == CC2530BEE_SLEEPMODE_CYCLIC_PIN)) &&
+                        (CC2530Bee_Config.SleepPeriod > 0);
+  uint32_t now = CC2530Bee_getSleepTimer();
+  uint32_t period = (uint32_t)CC2530Bee_Config.SleepPeriod * CC2530BEE_SLEEPTIMER_FREQUENCY / 100;
+  uint32_t elapsed;
+  if (CC2530Bee_sleep.asleep)
   {
-    USART_getc((char *) dataPtr);
-    /* if needed un-escape the data */
-    if ( *dataPtr == UARTFrame_Escape_Character )
+    elapsed = (now - CC2530Bee_sleep.sleepStart) & CC2530BEE_SLEEPTIMER_MASK;
+    if (((pinSleep || (mode == CC2530BEE_SLEEPMODE_CYCLIC_PIN)) && !CC2530BEE_SLEEPRQ_PIN) ||
+        (cyclicSleep && (elapsed >= period)) ||
+        (!pinSleep && !cyclicSleep))
+    {
+      CC2530Bee_wakeUp();
+    }
+    else if (pinSleep)
+    {
+      CC2530Bee_sleepFor(CC2530BEE_PINSLEEP_POLL_TICKS);
+    }
+    else if (mode == CC2530BEE_SLEEPMODE_CYCLIC_PIN)
+    {
+      CC2530Bee_sleepFor((period - elapsed < CC2530BEE_PINSLEEP_POLL_TICKS) ? period - elapsed : CC2530BEE_PINSLEEP_POLL_TICKS);
+    }
+    else
     {
-      USART_getc((char *) dataPtr);
-      *dataPtr ^= UARTFrame_Escape_Mask;
+      CC2530Bee_sleepFor(period - elapsed);
     }
-    crc += *dataPtr;
-    dataPtr++;
+    return;
   }
-  /* Check crc. The sum of received data + received crc must be 0xff */
-  USART_getc((char *) &(frame->crc));
-  crc += frame->crc;
-  if (crc == 0xff)
+  if (!pinSleep && !cyclicSleep)
   {
-    return UARTFrame_CRC_OK;
-  } 
-  else
+    return;
+  }
+  if (!CC2530Bee_isIdle())
+  {
+    CC2530Bee_sleep.lastActivity = now;
+    return;
+  }
+  if (pinSleep && CC2530BEE_SLEEPRQ_PIN)
+  {
+    CC2530Bee_enterSleep((mode == CC2530BEE_SLEEPMODE_PIN_DOZE) ? SLEEPCMD_MODE_PM1 : SLEEPCMD_MODE_PM2);
+  }
+  else if (cyclicSleep && ((mode == CC2530BEE_SLEEPMODE_CYCLIC) || CC2530BEE_SLEEPRQ_PIN) &&
+           (((now - CC2530Bee_sleep.lastActivity) & CC2530BEE_SLEEPTIMER_MASK) >=
+            (uint32_t)CC2530Bee_Config.TimeBeforeSleep * CC2530BEE_SLEEPTIMER_FREQUENCY / 1000))
   {
-    return UARTFrame_CRC_Not_OK;
+    CC2530Bee_enterSleep(SLEEPCMD_MODE_PM2);
   }
 }
 
 /**
- * Adds correct header and CRC to global variable txAPIFrame. Precondition is 
- * that data in txAPIFrame.data was already filled.
- * @param data Pointer to data to be send out via USART
- * @param length number of bytes of data 
+ * Deasserts CTS, module sleeps from next main loop iteration on. If a byte
+ * arrived before host saw CTS deasserted, module stays awake to receive it.
+ * @param powerMode SLEEPCMD_MODE_PM1 or SLEEPCMD_MODE_PM2
  */
-void UARTAPI_sentFrame(APIFramePayload_t *data, uint16_t length)
+void CC2530Bee_enterSleep(uint8_t powerMode)
 {
-  uint16_t i;
-  uint8_t crc = 0;
-  txAPIFrame.header.delimiter = UARTFrame_Delimiter;
-  /* convert from little-endian to big-endian */
-  SWAP_UINT16(length);
-  txAPIFrame.header.length = length;
-  USART_write((char const*)&txAPIFrame, sizeof(APIFrameHeader_t));
-  for (i=0; i<length; i++)
+  CC2530BEE_CTS_PIN = CC2530BEE_CTS_DEASSERTED;
+  if (UartDma_rxAvailable())
   {
-    if ( (data[i] == UARTFrame_Delimiter) || (data[i] == UARTFrame_Escape_Character) || (data[i] == UARTFrame_XON) || (data[i] == UARTFrame_XOFF) ) {
-      USART_putc(UARTFrame_Escape_Character);
-      USART_putc(data[i]^0x20);
-    }
-    else {
-      USART_putc(data[i]);
-    }
-    crc += data[i];
+    CC2530BEE_CTS_PIN = CC2530BEE_CTS_ASSERTED;
+    return;
   }
-  crc = 0xff-crc;
-  txAPIFrame.crc = crc;
-  USART_putc(crc);
+  CC2530Bee_sleep.asleep = 1;
+  CC2530Bee_sleep.powerMode = powerMode;
+  CC2530Bee_sleep.sleepStart = CC2530Bee_getSleepTimer();
 }
 
 /**
- * Reads different system parametes via AT commands
- * Prepares and sents tx frame according to the atCommand requested.
- * @param data Pointer to data received within UART API frame
-*/
-void UARTAPI_readParameter(APIFramePayload_t *data)
-{
-  uint16_t atCommand;
-  /* get AT command and convert to little-endian */
-  atCommand = data[UARTAPI_ATCOMMAND_COMMAND] << 8 | data[UARTAPI_ATCOMMAND_COMMAND + 1];
-  /* Prepare general tx frame data. Copy frame ID an AT command to sent frame */  
-  txAPIFrame.data[0] = UARTAPI_ATCOMMAND_RESPONSE;
-  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_FRAMEID] = data[UARTAPI_ATCOMMAND_FRAMEID];
-  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_COMMAND] = data[UARTAPI_ATCOMMAND_COMMAND];
-  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_COMMAND + 1] = data[UARTAPI_ATCOMMAND_COMMAND + 1];
-  /* as we will handle response status for each command, preset command status to "invalid command" */
-  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_CMD;
-  switch (atCommand)
-  {
-  case UARTAPI_ATCOMMAND_WRITE:
-    /* not really a read but as it has no parameter it will be handled here */
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    break;
-  case UARTAPI_ATCOMMAND_RESTOREDEFAULTS:
-    /* not really a read but as it has no parameter it will be handled here */
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    break;
-  case UARTAPI_ATCOMMAND_SOFTWARERESET:
-    /* not really a read but as it has no parameter it will be handled here */
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    /* Trigger watchdog one more time to make sure that UART tx buffer can be emptied before watchdog reset */
-    UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_ATCOMMAND_RESPONSE_DATA);
-    WDT_trigger();
-    while (1)
-    {
-      nop();
-    }
-    break;
-  case UARTAPI_ATCOMMAND_CHANNEL:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA] = CC2530Bee_Config.IEEE802154_config.Channel;
-    UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_ATCOMMAND_RESPONSE_DATA + sizeof(uint8_t));
-    break;
-  case UARTAPI_ATCOMMAND_PANID:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    *((IEEE802154_PANIdentifier_t*)&(txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA])) = CC2530Bee_Config.IEEE802154_config.PanID;
-    UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_ATCOMMAND_RESPONSE_DATA + sizeof(IEEE802154_PANIdentifier_t));
-    break;
-  case UARTAPI_ATCOMMAND_DESTINATIONADDRESSHIGH:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 0] = IEEE802154_TxDataFrame.destinationAddress.extendedAdress[4];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 1] = IEEE802154_TxDataFrame.destinationAddress.extendedAdress[5];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 2] = IEEE802154_TxDataFrame.destinationAddress.extendedAdress[6];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 3] = IEEE802154_TxDataFrame.destinationAddress.extendedAdress[7];
-    UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_ATCOMMAND_RESPONSE_DATA + sizeof(IEEE802154_ExtendedAddress_t)/2);
-    break;
-  case UARTAPI_ATCOMMAND_DESTINATIONADDRESSLOW:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 0] = IEEE802154_TxDataFrame.destinationAddress.extendedAdress[0];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 1] = IEEE802154_TxDataFrame.destinationAddress.extendedAdress[1];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 2] = IEEE802154_TxDataFrame.destinationAddress.extendedAdress[2];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 3] = IEEE802154_TxDataFrame.destinationAddress.extendedAdress[3];
-    UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_ATCOMMAND_RESPONSE_DATA + sizeof(IEEE802154_ExtendedAddress_t)/2);
-    break;
-  case UARTAPI_ATCOMMAND_SOURCEADDRESS16BIT:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    *((IEEE802154_ShortAddress_t*)&(txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA])) = IEEE802154_TxDataFrame.sourceAddress.shortAddress;
-    UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_ATCOMMAND_RESPONSE_DATA + sizeof(IEEE802154_ShortAddress_t));
-    break;
-  case UARTAPI_ATCOMMAND_SERIALNUMBERHIGH:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 0] = IEEE802154_TxDataFrame.sourceAddress.extendedAdress[4];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 1] = IEEE802154_TxDataFrame.sourceAddress.extendedAdress[5];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 2] = IEEE802154_TxDataFrame.sourceAddress.extendedAdress[6];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 3] = IEEE802154_TxDataFrame.sourceAddress.extendedAdress[7];
-    UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_ATCOMMAND_RESPONSE_DATA + sizeof(IEEE802154_ExtendedAddress_t)/2);
-    break;
-  case UARTAPI_ATCOMMAND_SERIALNUMBERLOW:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 0] = IEEE802154_TxDataFrame.sourceAddress.extendedAdress[0];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 1] = IEEE802154_TxDataFrame.sourceAddress.extendedAdress[1];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 2] = IEEE802154_TxDataFrame.sourceAddress.extendedAdress[2];
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA + 3] = IEEE802154_TxDataFrame.sourceAddress.extendedAdress[3];
-    UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_ATCOMMAND_RESPONSE_DATA + sizeof(IEEE802154_ExtendedAddress_t)/2);
-    break;
-  default:
-    break;
-  }
-}
-
-/**
- * Sets different system parametes via AT commands
- * If parameter is handled OK will be sent back if no invalid command is sent via UART
- * @param data Pointer to data received within UART API frame
-*/
-void UARTAPI_setParameter(APIFramePayload_t *data)
+ * Sleeps in power mode of CC2530Bee_sleep until sleep timer wakes module up.
+ * Sleep timer compare is set ahead by wake-up time of power mode, so that
+ * module is running again once ticks passed.
+ * @param ticks Sleep time in sleep timer ticks, limited to #CC2530BEE_SLEEP_MAX_TICKS
+ */
+void CC2530Bee_sleepFor(uint32_t ticks)
 {
-  uint16_t atCommand;
-  /* get AT command and convert to little-endian */
-  atCommand = data[UARTAPI_ATCOMMAND_COMMAND] << 8 | data[UARTAPI_ATCOMMAND_COMMAND + 1];
-  /* Prepare general tx frame data. Copy frame ID an AT command to sent frame */  
-  txAPIFrame.data[0] = UARTAPI_ATCOMMAND_RESPONSE;
-  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_FRAMEID] = data[UARTAPI_ATCOMMAND_FRAMEID];
-  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_COMMAND] = data[UARTAPI_ATCOMMAND_COMMAND];
-  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_COMMAND + 1] = data[UARTAPI_ATCOMMAND_COMMAND + 1];
-  /* As we will handle response status for each command, preset command status to "invalid command" */
-  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_CMD;
-  switch (atCommand)
-  {
-  case UARTAPI_ATCOMMAND_CHANNEL:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    /* Only set new configuration here, changes will be done later in main loop */
-    CC2530Bee_Config.IEEE802154_config.Channel = data[UARTAPI_ATCOMMAND_DATA];
-    CC2530BeeState = CC2530BeeState_ReInitIEEE802154;
-    /* fall through */
-  case UARTAPI_ATCOMMAND_PANID:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    CC2530Bee_Config.IEEE802154_config.PanID = *((IEEE802154_PANIdentifier_t*)&data[UARTAPI_ATCOMMAND_DATA]);
-    /* fall through */
-  case UARTAPI_ATCOMMAND_DESTINATIONADDRESSHIGH:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    IEEE802154_TxDataFrame.destinationAddress.extendedAdress[4] = data[UARTAPI_ATCOMMAND_DATA];
-    IEEE802154_TxDataFrame.destinationAddress.extendedAdress[5] = data[UARTAPI_ATCOMMAND_DATA + 1];
-    IEEE802154_TxDataFrame.destinationAddress.extendedAdress[6] = data[UARTAPI_ATCOMMAND_DATA + 2];
-    IEEE802154_TxDataFrame.destinationAddress.extendedAdress[7] = data[UARTAPI_ATCOMMAND_DATA + 3];
-    /* fall through */
-  case UARTAPI_ATCOMMAND_DESTINATIONADDRESSLOW:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    IEEE802154_TxDataFrame.destinationAddress.extendedAdress[0] = data[UARTAPI_ATCOMMAND_DATA];
-    IEEE802154_TxDataFrame.destinationAddress.extendedAdress[1] = data[UARTAPI_ATCOMMAND_DATA + 1];
-    IEEE802154_TxDataFrame.destinationAddress.extendedAdress[2] = data[UARTAPI_ATCOMMAND_DATA + 2];
-    IEEE802154_TxDataFrame.destinationAddress.extendedAdress[3] = data[UARTAPI_ATCOMMAND_DATA + 3];
-    /* fall through */
-  case UARTAPI_ATCOMMAND_SOURCEADDRESS16BIT:
-    txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
-    IEEE802154_TxDataFrame.sourceAddress.shortAddress = *((IEEE802154_ShortAddress_t*)&data[UARTAPI_ATCOMMAND_DATA]);
-    /* fall through */
-  case UARTAPI_ATCOMMAND_SERIALNUMBERHIGH:
-    /* 64bit address can't be changed */
-    /* fall through */
-  case UARTAPI_ATCOMMAND_SERIALNUMBERLOW:
-    /* 64bit address can't be changed */
-    /* fall through */
-  default:
-    /* all above cases are missing break-statement but just set response status. Sent UART frame now */
-    UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_ATCOMMAND_RESPONSE_DATA);
-    break;
+  sleepTimer_t increment;
+  uint32_t wakeupTicks = (CC2530Bee_sleep.powerMode == SLEEPCMD_MODE_PM1) ? CC2530BEE_WAKEUP_TICKS_PM1 : CC2530BEE_WAKEUP_TICKS_PM2;
+  if (ticks > CC2530BEE_SLEEP_MAX_TICKS)
+  {
+    ticks = CC2530BEE_SLEEP_MAX_TICKS;
   }
+  increment.value = (ticks > wakeupTicks) ? ticks - wakeupTicks : 1;
+  CC253x_IncrementSleepTimer(increment);
+  CC253x_ActivatePowerMode(CC2530Bee_sleep.powerMode);
 }
 
 /**
- * Callback whenever Beacon frame was received
- * @param payloadLength Length of data in IEEE802154_RxDataFrame.payload
- * @param rssi value measured over the firs eight symbols following SFD
- * @note This function runs in interrupt context
-*/
-void IEEE802154_UserCbk_BeaconFrameReceived(uint8_t payloadLength, sint8_t rssi)
+ * Initializes radio with CC2530Bee_Config. In sniffer mode frame filtering
+ * and automatic ACKs set up by driver are switched off again.
+ */
+void CC2530Bee_radioInit(void)
 {
-  
+  IEEE802154_radioInit(&(CC2530Bee_Config.IEEE802154_config));
+  if (CC2530Bee_Config.SnifferMode == CC2530BEE_SNIFFERMODE_ON)
+  {
+    FRMFILT0 &= ~CC2530BEE_FRMFILT0_FRM_FILTER_EN;
+    FRMCTRL0 &= ~CC2530BEE_FRMCTRL0_AUTOACK;
+  }
 }
 
 /**
- * Callback whenever Data frame was received
- * @param payloadLength Length of data in IEEE802154_RxDataFrame.payload
- * @param rssi value measured over the firs eight symbols following SFD
- * @note This function runs in interrupt context
-*/
-void IEEE802154_UserCbk_DataFrameReceived(uint8_t payloadLength, sint8_t rssi)
+ * Brings radio back to receive, asserts CTS and restarts time before sleep
+ */
+void CC2530Bee_wakeUp(void)
 {
-  uint8_t *payloadDataPtr = txAPIFrame.data;
-  if (IEEE802154_RxDataFrame.fcf.sourceAddressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT)
-  {
-    *(payloadDataPtr++) = UARTAPI_RECEIVE_PACKAGE_64BIT;
-    txAPIFrame.header.length = payloadLength + UARTAPI_64BITRECEIVE_HEADER_SIZE;
-    memcpy(payloadDataPtr, &(IEEE802154_RxDataFrame.sourceAddress.extendedAdress), sizeof(IEEE802154_ExtendedAddress_t) );
-    payloadDataPtr += sizeof(IEEE802154_ExtendedAddress_t);
-  }
-  else if (IEEE802154_RxDataFrame.fcf.sourceAddressMode == IEEE802154_FCF_ADDRESS_MODE_16BIT)
-  {
-    *(payloadDataPtr++) = UARTAPI_RECEIVE_PACKAGE_16BIT;
-    txAPIFrame.header.length = payloadLength + UARTAPI_16BITRECEIVE_HEADER_SIZE;
-    *(payloadDataPtr++) = HI_UINT16(IEEE802154_RxDataFrame.sourceAddress.shortAddress);
-    *(payloadDataPtr++) = LO_UINT16(IEEE802154_RxDataFrame.sourceAddress.shortAddress);
-  }
-  else /* IEEE802154_FCF_ADDRESS_MODE_NONE */
-  {
-    *(payloadDataPtr++) = UARTAPI_RECEIVE_PACKAGE_NONE;
-    txAPIFrame.header.length = payloadLength + UARTAPI_NONERECEIVE_HEADER_SIZE;
-  }
-  *(payloadDataPtr++) = rssi;
-  uint8_t optionByte = 0x00;
-  if (IEEE802154_RxDataFrame.destinationAddress.shortAddress == IEEE802154_BROADCAST_ADDRESS_16BIT)
-  {
-    optionByte |= UARTAPI_RECEVICE_OPTIONS_ADDRESS_BROADCAST;
-  }
-  if (IEEE802154_RxDataFrame.destinationPANID == IEEE802154_BROADCAST_PAN_ID)
-  {
-    optionByte |= UARTAPI_RECEVICE_OPTIONS_PAN_BROADCAST;
-  }
-  *(payloadDataPtr++) = optionByte;
-  memcpy(payloadDataPtr, IEEE802154_RxDataFrame.payload, payloadLength );
-  UARTAPI_sentFrame(txAPIFrame.data, txAPIFrame.header.length);
+  CC2530Bee_radioInit();
+  CC2530Bee_sleep.asleep = 0;
+  CC2530Bee_sleep.lastActivity = CC2530Bee_getSleepTimer();
+  CC2530BEE_CTS_PIN = CC2530BEE_CTS_ASSERTED;
+}
+
+/**
+ * Clears all runtime statistics including those kept by the queues
+ */
+void CC2530Bee_clearStatistics(void)
+{
+  disableAllInterrupt();
+  memset(&CC2530Bee_statistics, 0, sizeof(CC2530Bee_statistics));
+  RxQueue_overflowCount = 0;
+  Sniffer_overflowCount = 0;
+  RxQueue_highWater = 0;
+  TxQueue_highWater = 0;
+  FramePool_highWater = FramePool_numUsed();
+  enableAllInterrupt();
+  CC2530Bee_statisticsMagic = CC2530BEE_STATISTICS_MAGIC;
+}
+
+/**
+ * Copies counters kept by the queues to #CC2530Bee_statistics before it is
+ * read
+ * @note To be called with interrupts disabled, as radio counters are updated
+ * in interrupt context
+ */
+void CC2530Bee_collectStatistics(void)
+{
+  CC2530Bee_statistics.rxQueueOverflows = RxQueue_overflowCount;
+  CC2530Bee_statistics.snifferOverflows = Sniffer_overflowCount;
+  CC2530Bee_statistics.rxQueueHighWater = RxQueue_highWater;
+  CC2530Bee_statistics.txQueueHighWater = TxQueue_highWater;
+  CC2530Bee_statistics.framePoolHighWater = FramePool_highWater;
+}
+
+/**
+ * Executes ED: starts energy scan of channels in SC, response is sent by
+ * CC2530Bee_scanFinish. Fails if a scan is already running.
+ */
+void CC2530Bee_energyScan(void)
+{
+  if (CC2530Bee_scan.state != CC2530BeeScan_Idle)
+  {
+    UARTAPI_sendDeferredResponse(UARTAPI_ATCOMMAND_ENERGYSCAN, UARTAPI_deferredFrameId,
+                                 UARTAPI_ATCOMMAND_RESPONSE_STATUS_ERROR, CC2530Bee_scan.energy, 0);
+    return;
+  }
+  CC2530Bee_scan.reassign = 0;
+  CC2530Bee_scan.frameId = UARTAPI_deferredFrameId;
+  CC2530Bee_scan.state = CC2530BeeScan_Pending;
+}
+
+/**
+ * Runs energy scan at each main loop iteration. Scan starts once radio has
+ * finished current frame, then RSSI is sampled on each channel of SC for
+ * 2^SD * 15.36 ms and the highest value is kept. Never blocks, UART is served
+ * meanwhile.
+ */
+void CC2530Bee_scanPoll(void)
+{
+  CC2530Bee_Scan_t *scan = &CC2530Bee_scan;
+  sint8_t energy;
+  if ((scan->state == CC2530BeeScan_Pending) && (CC2530Bee_radioTx.state == CC2530BeeRadioTx_Idle))
+  {
+    scan->state = CC2530BeeScan_Running;
+    scan->dwell = CC2530BEE_SCAN_TICKS << CC2530Bee_Config.ScanDuration;
+    scan->channel = CC2530BEE_CHANNEL_FIRST - 1;
+    CC2530Bee_scanNext();
+    return;
+  }
+  if (scan->state != CC2530BeeScan_Running)
+  {
+    return;
+  }
+  if (RSSISTAT & CC2530BEE_RSSISTAT_VALID)
+  {
+    energy = (sint8_t)RSSI + CC2530BEE_RSSI_OFFSET;
+    if (energy > scan->peak)
+    {
+      scan->peak = energy;
+    }
+  }
+  if (((CC2530Bee_getSleepTimer() - scan->startTime) & CC2530BEE_SLEEPTIMER_MASK) >= scan->dwell)
+  {
+    scan->energy[scan->channel - CC2530BEE_CHANNEL_FIRST] = (scan->peak < 0) ? (uint8_t)(-scan->peak) : 0;
+    CC2530Bee_scanNext();
+  }
+}
+
+/**
+ * Tunes radio to next channel of SC to be scanned, finishes scan after last
+ * one
+ */
+void CC2530Bee_scanNext(void)
+{
+  CC2530Bee_Scan_t *scan = &CC2530Bee_scan;
+  do {
+    scan->channel++;
+  } while ((scan->channel <= CC2530BEE_CHANNEL_LAST) &&
+           !(CC2530Bee_Config.ScanChannels & ((uint16_t)1 << (scan->channel - CC2530BEE_CHANNEL_FIRST))));
+  if (scan->channel > CC2530BEE_CHANNEL_LAST)
+  {
+    CC2530Bee_scanFinish();
+    return;
+  }
+  RFST = CC2530BEE_RFST_ISRFOFF;
+  FREQCTRL = CC2530BEE_FREQCTRL_FIRST + CC2530BEE_FREQCTRL_SPACING * (scan->channel - CC2530BEE_CHANNEL_FIRST);
+  RFST = CC2530BEE_RFST_ISRXON;
+  scan->peak = -128;
+  scan->startTime = CC2530Bee_getSleepTimer();
+}
+
+/**
+ * Ends energy scan. ED is answered with the energy of each channel of SC in
+ * -dBm, in channel order. At boot (A2) the channel with least energy is
+ * applied like a changed CH instead, changes queued meanwhile are applied
+ * along with it. Radio is re-initialized in both cases so that it is tuned
+ * to CH again.
+ */
+void CC2530Bee_scanFinish(void)
+{
+  CC2530Bee_Scan_t *scan = &CC2530Bee_scan;
+  uint8_t response[CC2530BEE_CHANNEL_LAST - CC2530BEE_CHANNEL_FIRST + 1];
+  uint8_t length = 0;
+  uint8_t quietest = 0;
+  uint8_t i;
+  scan->state = CC2530BeeScan_Idle;
+  for (i=0; i<sizeof(scan->energy); i++)
+  {
+    if (CC2530Bee_Config.ScanChannels & ((uint16_t)1 << i))
+    {
+      /* energy is in -dBm, so quietest channel has highest value */
+      if ((length == 0) || (scan->energy[i] > scan->energy[quietest]))
+      {
+        quietest = i;
+      }
+      response[length++] = scan->energy[i];
+    }
+  }
+  if (!scan->reassign)
+  {
+    CC2530Bee_radioInit();
+    UARTAPI_sendDeferredResponse(UARTAPI_ATCOMMAND_ENERGYSCAN, scan->frameId, UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK, response, length);
+  }
+  else if (length > 0)
+  {
+    CC2530Bee_stageConfig(CC2530BEE_CONFIGCHANGE_RADIO)->IEEE802154_config.Channel = CC2530BEE_CHANNEL_FIRST + quietest;
+    CC2530Bee_applyConfig();
+  }
+  else
+  {
+    CC2530Bee_radioInit();
+  }
+}
+
+/**
+ * Starts sending TX request API frame (64bit or 16bit address), remote AT
+ * command request or remote AT command response (see
+ * CC2530Bee_remoteATQueue) via radio. Frame ID, destination address and options of the
+ * frame are applied to #radioTxFrame, a copy of #IEEE802154_TxDataFrame, thus
+ * the configured header is never altered by a transmission. Frame is sent
+ * by CC2530Bee_radioTxPoll once CSMA-CA found the channel clear.
+ * @param data API frame data starting with API identifier
+ * @param length number of bytes of data
+ * @return 1 if transmission was started, 0 if frame was discarded
+ */
+uint8_t CC2530Bee_radioTransmit(APIFramePayload_t *data, uint16_t length)
+{
+  uint8_t options;
+  uint8_t dataOffset;
+  uint8_t isData = 1;
+  radioTxFrame = IEEE802154_TxDataFrame;
+  /* set correct address mode in fcf for destination address. The corresponding bit for source address will 
+   * be set whenever source address is changed */
+  if (data[0] == UARTAPI_TRAMSMIT_REQUEST_64BIT)
+  {
+    dataOffset = UARTAPI_64BITTRANSMIT_DATA;
+    options = data[UARTAPI_64BITTRANSMIT_OPTIONS];
+    memcpy(&(radioTxFrame.destinationAddress.extendedAdress), &(data[UARTAPI_64BITTRANSMIT_ADDRESS]), sizeof(IEEE802154_ExtendedAddress_t) );
+    radioTxFrame.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_64BIT;
+  }
+  else if ((data[0] == UARTAPI_REMOTE_AT_COMMAND_REQUEST) || (data[0] == UARTAPI_REMOTE_AT_COMMAND_RESPONSE))
+  {
+    isData = 0;
+    /* addresses of request are replaced by frame type, API identifier and frame ID in front of options */
+    dataOffset = (data[0] == UARTAPI_REMOTE_AT_COMMAND_REQUEST) ? (UARTAPI_REMOTEAT_OPTIONS - CC2530BEE_REMOTEAT_REQUEST_OPTIONS) :
+                 CC2530BEE_REMOTEAT_RESPONSE_PAYLOAD;
+    /* remote AT commands are never fragmented */
+    if ((length < UARTAPI_REMOTEAT_COMMAND + sizeof(uint16_t)) || (length - dataOffset > CC2530BEE_MAX_FRAME_PAYLOAD_LENGTH))
+    {
+      return 0;
+    }
+    if ((data[UARTAPI_REMOTEAT_ADDRESS16] == HI_UINT16(UARTAPI_REMOTEAT_USE_64BIT_ADDRESS)) &&
+        (data[UARTAPI_REMOTEAT_ADDRESS16 + 1] == LO_UINT16(UARTAPI_REMOTEAT_USE_64BIT_ADDRESS)))
+    {
+      memcpy(&(radioTxFrame.destinationAddress.extendedAdress), &(data[UARTAPI_REMOTEAT_ADDRESS64]), sizeof(IEEE802154_ExtendedAddress_t) );
+      radioTxFrame.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_64BIT;
+    }
+    else {
+      radioTxFrame.destinationAddress.shortAddress = *((IEEE802154_ShortAddress_t*)&data[UARTAPI_REMOTEAT_ADDRESS16]);
+      radioTxFrame.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+    }
+    if (data[0] == UARTAPI_REMOTE_AT_COMMAND_REQUEST)
+    {
+      data[dataOffset + CC2530BEE_REMOTEAT_REQUEST_FRAMEID] = data[UARTAPI_REMOTEAT_FRAMEID];
+      data[dataOffset + CC2530BEE_REMOTEAT_API_IDENTIFIER] = UARTAPI_REMOTE_AT_COMMAND_REQUEST;
+      data[dataOffset + CC2530BEE_FRAME_TYPE] = CC2530BEE_FRAME_TYPE_REMOTEAT;
+      /* there is neither ACK nor TX status for remote AT command requests */
+      options = UARTAPI_TRANSMIT_OPTIONS_DISABLEACK;
+    }
+    else
+    {
+      /* response is acknowledged by requesting node, but there is no TX status for it */
+      options = 0x00;
+    }
+  }
+  else {
+    dataOffset = UARTAPI_16BITTRANSMIT_DATA;
+    options = data[UARTAPI_16BITTRANSMIT_OPTIONS];
+    radioTxFrame.destinationAddress.shortAddress = *((IEEE802154_ShortAddress_t*)&data[UARTAPI_16BITTRANSMIT_ADDRESS]);
+    radioTxFrame.fcf.destinationAddressMode = IEEE802154_FCF_ADDRESS_MODE_16BIT;
+  }
+  /* frame too short to contain header or payload too large to be reassembled, discard it */
+  if ((length < dataOffset) || (length - dataOffset > FRAGMENT_MAX_PAYLOAD_LENGTH))
+  {
+    return 0;
+  }
+  radioTxFrame.sequenceNumber = CC2530Bee_sequenceNumber++;
+  if (options & UARTAPI_TRANSMIT_OPTIONS_DISABLEACK) {
+    radioTxFrame.fcf.ackRequired = 0;
+  }
+  /* broadcasts are never acknowledged */
+  if ((radioTxFrame.fcf.destinationAddressMode == IEEE802154_FCF_ADDRESS_MODE_16BIT) &&
+      (radioTxFrame.destinationAddress.shortAddress == IEEE802154_BROADCAST_ADDRESS_16BIT))
+  {
+    radioTxFrame.fcf.ackRequired = 0;
+  }
+  if (options & UARTAPI_TRANSMIT_OPTIONS_BROADCASTPANID) {
+    radioTxFrame.destinationPANID = IEEE802154_BROADCAST_PAN_ID;
+  }
+  CC2530Bee_radioTx.numFragments = 0;
+  if (!isData)
+  {
+    radioTxFrame.fcf.reserved = CC2530BEE_FCF_RESERVED_CONTROL;
+    CC2530Bee_radioTx.payloadLength = (uint8_t)(length - dataOffset);
+  }
+  else if (length - dataOffset <= CC2530BEE_MAX_FRAME_PAYLOAD_LENGTH)
+  {
+    CC2530Bee_radioTx.payloadLength = (uint8_t)(length - dataOffset);
+  }
+  else
+  {
+    /* payload is sent in fragments, see CC2530Bee_fragment */
+    CC2530Bee_radioTx.data = &(data[dataOffset]);
+    CC2530Bee_radioTx.length = length - dataOffset;
+    CC2530Bee_radioTx.numFragments = (CC2530Bee_radioTx.length + CC2530BEE_FRAGMENT_DATA_LENGTH - 1) / CC2530BEE_FRAGMENT_DATA_LENGTH;
+    CC2530Bee_radioTx.fragmentIndex = 0;
+    CC2530Bee_fragmentTag++;
+    CC2530Bee_fragment();
+  }
+  /* point IEEE802154 payload pointer to data received via UART */
+  if (CC2530Bee_radioTx.numFragments == 0)
+  {
+    radioTxFrame.payload = &(data[dataOffset]);
+  }
+  CC2530Bee_radioTx.numFrames = 1;
+  CC2530Bee_radioTx.statusRequired = isData && (CC2530Bee_Config.APIMode != CC2530BEE_APIMODE_TRANSPARENT);
+  CC2530Bee_radioTx.retries = 0;
+  CC2530Bee_radioTx.backoffs = 0;
+  CC2530Bee_radioTx.backoffExponent = CC2530Bee_Config.MinBackoffExponent;
+  CC2530Bee_radioTxBackoff();
+  return 1;
+}
+
+/**
+ * Advances frame at head of transmit queue: CCA once backoff passed, send
+ * frame if channel is clear, else back off again (unslotted CSMA-CA). If an
+ * ACK is required, frame is sent again after ACK wait until RR retries are
+ * used up. Outcome is reported by CC2530Bee_radioTxFinish.
+ */
+void CC2530Bee_radioTxPoll(void)
+{
+  CC2530Bee_RadioTx_t *tx = &CC2530Bee_radioTx;
+  if ((tx->state == CC2530BeeRadioTx_Backoff) &&
+      (((CC2530Bee_getSleepTimer() - tx->startTime) & CC2530BEE_SLEEPTIMER_MASK) >= tx->delay))
+  {
+    if (FSMSTAT1 & CC2530BEE_FSMSTAT1_CCA)
+    {
+      if (radioTxFrame.fcf.ackRequired)
+      {
+        /* ACK may be received before radioSentDataFrame returns */
+        tx->ackReceived = 0;
+        tx->state = CC2530BeeRadioTx_WaitAck;
+        TRACE(TRACE_RADIO_TX_START, radioTxFrame.sequenceNumber);
+        IEEE802154_radioSentDataFrame(&radioTxFrame, tx->payloadLength);
+        TRACE(TRACE_RADIO_TX_DONE, radioTxFrame.sequenceNumber);
+        CC2530Bee_statistics.radioTxFrames++;
+        tx->startTime = CC2530Bee_getSleepTimer();
+        tx->delay = CC2530BEE_ACK_WAIT_TICKS;
+      }
+      else
+      {
+        TRACE(TRACE_RADIO_TX_START, radioTxFrame.sequenceNumber);
+        IEEE802154_radioSentDataFrame(&radioTxFrame, tx->payloadLength);
+        TRACE(TRACE_RADIO_TX_DONE, radioTxFrame.sequenceNumber);
+        CC2530Bee_statistics.radioTxFrames++;
+        CC2530Bee_radioTxSent();
+      }
+    }
+    else if (tx->backoffs < CC2530BEE_CSMA_MAX_BACKOFFS)
+    {
+      tx->backoffs++;
+      if (tx->backoffExponent < CC2530BEE_CSMA_MAX_BACKOFF_EXPONENT)
+      {
+        tx->backoffExponent++;
+      }
+      CC2530Bee_radioTxBackoff();
+    }
+    else
+    {
+      CC2530Bee_statistics.ccaFailures++;
+      CC2530Bee_radioTxFinish(UARTAPI_TX_STATUS_CCAFAILURE);
+    }
+  }
+  if (tx->state == CC2530BeeRadioTx_WaitAck)
+  {
+    if (tx->ackReceived)
+    {
+      CC2530Bee_radioTxNeighbour(1);
+      CC2530Bee_radioTxSent();
+    }
+    else if (((CC2530Bee_getSleepTimer() - tx->startTime) & CC2530BEE_SLEEPTIMER_MASK) >= tx->delay)
+    {
+      CC2530Bee_statistics.ackTimeouts++;
+      CC2530Bee_radioTxNeighbour(0);
+      if (tx->retries < CC2530Bee_Config.MACRetries)
+      {
+        /* retransmission starts with a new CSMA-CA */
+        tx->retries++;
+        tx->backoffs = 0;
+        tx->backoffExponent = CC2530Bee_Config.MinBackoffExponent;
+        CC2530Bee_radioTxBackoff();
+      }
+      else
+      {
+        CC2530Bee_statistics.ackFailures++;
+        CC2530Bee_radioTxFinish(UARTAPI_TX_STATUS_NOACK);
+      }
+    }
+  }
+}
+
+/**
+ * Records outcome of frame sent with ACK request in neighbour table
+ * @param acked 1 if ACK was received
+ */
+void CC2530Bee_radioTxNeighbour(uint8_t acked)
+{
+  Neighbour_transmitted(radioTxFrame.fcf.destinationAddressMode, radioTxFrame.destinationAddress.shortAddress,
+                        radioTxFrame.destinationAddress.extendedAdress, acked, CC2530Bee_getSleepTimer());
+}
+
+/**
+ * Continues with next fragment once a radio frame was sent successfully, or
+ * reports success if there is none
+ */
+void CC2530Bee_radioTxSent(void)
+{
+  CC2530Bee_RadioTx_t *tx = &CC2530Bee_radioTx;
+  if (tx->fragmentIndex + 1 < tx->numFragments)
+  {
+    tx->fragmentIndex++;
+    CC2530Bee_fragment();
+    tx->retries = 0;
+    tx->backoffs = 0;
+    tx->backoffExponent = CC2530Bee_Config.MinBackoffExponent;
+    CC2530Bee_radioTxBackoff();
+  }
+  else
+  {
+    CC2530Bee_radioTxFinish(UARTAPI_TX_STATUS_SUCCESS);
+  }
+}
+
+/**
+ * Builds radio frame of current fragment of payload. Each fragment has its own
+ * sequence number, so that a late ACK of the previous one is not taken for it.
+ */
+void CC2530Bee_fragment(void)
+{
+  CC2530Bee_RadioTx_t *tx = &CC2530Bee_radioTx;
+  uint16_t offset = (uint16_t)tx->fragmentIndex * CC2530BEE_FRAGMENT_DATA_LENGTH;
+  uint8_t length = (tx->length - offset > CC2530BEE_FRAGMENT_DATA_LENGTH) ? CC2530BEE_FRAGMENT_DATA_LENGTH : (uint8_t)(tx->length - offset);
+  CC2530Bee_radioTxPayload[CC2530BEE_FRAME_TYPE] = CC2530BEE_FRAME_TYPE_FRAGMENT;
+  CC2530Bee_radioTxPayload[CC2530BEE_FRAGMENT_TAG] = CC2530Bee_fragmentTag;
+  CC2530Bee_radioTxPayload[CC2530BEE_FRAGMENT_INDEX] = tx->fragmentIndex;
+  CC2530Bee_radioTxPayload[CC2530BEE_FRAGMENT_COUNT] = tx->numFragments;
+  memcpy(&CC2530Bee_radioTxPayload[CC2530BEE_FRAGMENT_DATA], &(tx->data[offset]), length);
+  if (tx->fragmentIndex > 0)
+  {
+    radioTxFrame.sequenceNumber = CC2530Bee_sequenceNumber++;
+  }
+  radioTxFrame.fcf.reserved = CC2530BEE_FCF_RESERVED_CONTROL;
+  radioTxFrame.payload = CC2530Bee_radioTxPayload;
+  tx->payloadLength = CC2530BEE_FRAGMENT_DATA + length;
+}
+
+/**
+ * Waits a random number of backoff periods from 0 to 2^BE - 1 before next CCA
+ */
+void CC2530Bee_radioTxBackoff(void)
+{
+  CC2530Bee_RadioTx_t *tx = &CC2530Bee_radioTx;
+  tx->state = CC2530BeeRadioTx_Backoff;
+  tx->startTime = CC2530Bee_getSleepTimer();
+  tx->delay = (uint32_t)(CC2530Bee_random() & ((1 << tx->backoffExponent) - 1)) * CC2530BEE_BACKOFF_PERIOD_TICKS;
+}
+
+/**
+ * Reports outcome of transmission via TX status for each frame ID except 0
+ * and releases transmit queue slots sent. A remote AT command is finished
+ * once its response left the queue.
+ * @param status UARTAPI_TX_STATUS_*
+ */
+void CC2530Bee_radioTxFinish(uint8_t status)
+{
+  TxQueue_Slot_t *slot;
+  uint8_t remoteATSent = 0;
+  uint8_t i;
+  for (i=0; i<CC2530Bee_radioTx.numFrames; i++)
+  {
+    slot = TxQueue_peek();
+    if (slot->data[0] == UARTAPI_REMOTE_AT_COMMAND_RESPONSE)
+    {
+      remoteATSent = 1;
+    }
+    if (CC2530Bee_radioTx.statusRequired && (slot->data[UARTAPI_64BITTRANSMIT_FRAMEID] != 0))
+    {
+      txAPIFrame.data = FramePool_allocReserved();
+      txAPIFrame.data[0] = UARTAPI_TRANSMIT_STATUS;
+      txAPIFrame.data[UARTAPI_TX_STATUS_FRAME_ID] = slot->data[UARTAPI_64BITTRANSMIT_FRAMEID];
+      txAPIFrame.data[UARTAPI_TX_STATUS_STATUS_BYTE] = status;
+      UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_TX_STATUS_LENGTH);
+      FramePool_release(txAPIFrame.data);
+      CC2530Bee_statistics.uartTxStatus++;
+    }
+    TxQueue_release();
+  }
+  CC2530Bee_radioTx.state = CC2530BeeRadioTx_Idle;
+  /* command may re-initialize radio, thus it runs once nothing is sent */
+  if (remoteATSent)
+  {
+    CC2530Bee_remoteATSent();
+  }
+}
+
+/**
+ * Aborts frame currently being sent, e.g. as radio is re-initialized
+ */
+void CC2530Bee_radioTxPurge(void)
+{
+  if (CC2530Bee_radioTx.state != CC2530BeeRadioTx_Idle)
+  {
+    CC2530Bee_radioTxFinish(UARTAPI_TX_STATUS_PURGED);
+  }
+}
+
+/**
+ * Decides how many TX requests at head of transmit queue are sent together.
+ * With AG set, TX requests with the same API identifier, destination and
+ * options are collected until AG milliseconds passed since the first one was
+ * ready, a different one is queued, the aggregated payload is full or the
+ * queue is full.
+ * @return Number of slots to send now, 0 to wait for further TX requests
+ */
+uint8_t CC2530Bee_aggregate(void)
+{
+  TxQueue_Slot_t *first = TxQueue_peek();
+  TxQueue_Slot_t *next;
+  uint8_t dataOffset;
+  uint8_t numFrames = 1;
+  uint16_t length;
+  if ((CC2530Bee_Config.AggregationWindow == 0) ||
+      ((first->data[0] != UARTAPI_TRAMSMIT_REQUEST_64BIT) && (first->data[0] != UARTAPI_TRAMSMIT_REQUEST_16BIT)))
+  {
+    return 1;
+  }
+  dataOffset = (first->data[0] == UARTAPI_TRAMSMIT_REQUEST_64BIT) ? UARTAPI_64BITTRANSMIT_DATA : UARTAPI_16BITTRANSMIT_DATA;
+  if (first->length < dataOffset)
+  {
+    /* discarded by CC2530Bee_radioTransmit */
+    return 1;
+  }
+  length = CC2530BEE_AGGREGATE_RECORDS + 1 + first->length - dataOffset;
+  if (length > CC2530BEE_MAX_FRAME_PAYLOAD_LENGTH)
+  {
+    /* fragmented by CC2530Bee_radioTransmit */
+    return 1;
+  }
+  while ((next = TxQueue_peekAt(numFrames)) != NULL)
+  {
+    /* address and options follow frame ID in both TX requests */
+    if ((next->data[0] != first->data[0]) || (next->length < dataOffset) ||
+        (memcmp(&(next->data[UARTAPI_64BITTRANSMIT_ADDRESS]), &(first->data[UARTAPI_64BITTRANSMIT_ADDRESS]), dataOffset - UARTAPI_64BITTRANSMIT_ADDRESS) != 0) ||
+        (length + 1 + next->length - dataOffset > CC2530BEE_MAX_FRAME_PAYLOAD_LENGTH))
+    {
+      CC2530Bee_radioTx.aggregating = 0;
+      return numFrames;
+    }
+    length += 1 + next->length - dataOffset;
+    numFrames++;
+  }
+  if (!CC2530Bee_radioTx.aggregating)
+  {
+    CC2530Bee_radioTx.aggregating = 1;
+    CC2530Bee_radioTx.aggregateStart = CC2530Bee_getSleepTimer();
+  }
+  if (TxQueue_isFull() ||
+      (((CC2530Bee_getSleepTimer() - CC2530Bee_radioTx.aggregateStart) & CC2530BEE_SLEEPTIMER_MASK) >=
+       (uint32_t)CC2530Bee_Config.AggregationWindow * CC2530BEE_SLEEPTIMER_FREQUENCY / 1000))
+  {
+    CC2530Bee_radioTx.aggregating = 0;
+    return numFrames;
+  }
+  return 0;
+}
+
+/**
+ * Replaces payload of frame prepared by CC2530Bee_radioTransmit by records of
+ * the TX requests at head of transmit queue
+ * @param numFrames Number of slots returned by CC2530Bee_aggregate
+ */
+void CC2530Bee_aggregatePayload(uint8_t numFrames)
+{
+  TxQueue_Slot_t *slot;
+  uint8_t dataOffset = (TxQueue_peek()->data[0] == UARTAPI_TRAMSMIT_REQUEST_64BIT) ? UARTAPI_64BITTRANSMIT_DATA : UARTAPI_16BITTRANSMIT_DATA;
+  uint8_t length = CC2530BEE_AGGREGATE_RECORDS;
+  uint8_t i;
+  CC2530Bee_radioTxPayload[CC2530BEE_FRAME_TYPE] = CC2530BEE_FRAME_TYPE_AGGREGATE;
+  for (i=0; i<numFrames; i++)
+  {
+    slot = TxQueue_peekAt(i);
+    CC2530Bee_radioTxPayload[length++] = slot->length - dataOffset;
+    memcpy(&CC2530Bee_radioTxPayload[length], &(slot->data[dataOffset]), slot->length - dataOffset);
+    length += slot->length - dataOffset;
+  }
+  radioTxFrame.fcf.reserved = CC2530BEE_FCF_RESERVED_CONTROL;
+  radioTxFrame.payload = CC2530Bee_radioTxPayload;
+  CC2530Bee_radioTx.payloadLength = length;
+  CC2530Bee_radioTx.numFrames = numFrames;
+}
+
+/**
+ * Pseudo random number for CSMA-CA backoffs (16bit Galois LFSR)
+ * @return Next random number
+ */
+uint8_t CC2530Bee_random(void)
+{
+  uint8_t lsb = CC2530Bee_randomState & 0x01;
+  CC2530Bee_randomState >>= 1;
+  if (lsb)
+  {
+    CC2530Bee_randomState ^= 0xb400;
+  }
+  return (uint8_t)CC2530Bee_randomState;
+}
+
+/**
+ * Sends RX packet API frame (64bit, 16bit or no address) for a radio frame
+ * from receive queue via UART. In transparent mode only the payload is sent.
+ * Remote AT command requests are executed, responses are sent as is.
+ * Aggregated frames are split into one RX packet per record. A remote AT
+ * command request is kept in receive queue while a response is pending.
+ * @param slot Receive queue slot filled by IEEE802154_UserCbk_DataFrameReceived
+ * @return 1 if slot can be released, 0 to deliver it again later
+ */
+uint8_t CC2530Bee_deliverRxFrame(RxQueue_Slot_t *slot)
+{
+  uint8_t offset;
+  uint8_t length;
+  if (CC2530Bee_isRemoteAT(slot) && (slot->payload[CC2530BEE_REMOTEAT_API_IDENTIFIER] == UARTAPI_REMOTE_AT_COMMAND_REQUEST) &&
+      (CC2530Bee_remoteATResponse.length > 0))
+  {
+    /* previous response is sent first, without waiting for its jitter */
+    CC2530Bee_remoteATQueue();
+    return 0;
+  }
+  if (slot->source.sourceAddressMode != IEEE802154_FCF_ADDRESS_MODE_NONE)
+  {
+    Neighbour_received(slot->source.sourceAddressMode, slot->source.shortAddress, slot->source.extendedAddress,
+                       slot->source.sequenceNumber, slot->source.rssi, CC2530Bee_getSleepTimer());
+  }
+  if (!slot->control)
+  {
+    /* plain data frame of this or any other node */
+    CC2530Bee_sendRxPacket(&(slot->source), slot->payload, slot->length);
+    return 1;
+  }
+  if (slot->length <= CC2530BEE_FRAME_TYPE)
+  {
+    /* control frame without type is not sent by any node */
+    return 1;
+  }
+  if (CC2530Bee_isRemoteAT(slot))
+  {
+    if (slot->payload[CC2530BEE_REMOTEAT_API_IDENTIFIER] == UARTAPI_REMOTE_AT_COMMAND_REQUEST)
+    {
+      CC2530Bee_remoteATRequest(slot);
+    }
+    else if (CC2530Bee_Config.APIMode != CC2530BEE_APIMODE_TRANSPARENT)
+    {
+      /* response already is an API frame */
+      UARTAPI_sentFrame(&(slot->payload[CC2530BEE_REMOTEAT_API_IDENTIFIER]), slot->length - CC2530BEE_REMOTEAT_API_IDENTIFIER);
+      CC2530Bee_statistics.uartTxRemoteAT++;
+    }
+    return 1;
+  }
+  if (slot->payload[CC2530BEE_FRAME_TYPE] == CC2530BEE_FRAME_TYPE_FRAGMENT)
+  {
+    if (slot->length > CC2530BEE_FRAGMENT_DATA)
+    {
+      CC2530Bee_reassemble(slot);
+    }
+    return 1;
+  }
+  if (slot->payload[CC2530BEE_FRAME_TYPE] == CC2530BEE_FRAME_TYPE_AGGREGATE)
+  {
+    offset = CC2530BEE_AGGREGATE_RECORDS;
+    while (offset < slot->length)
+    {
+      length = slot->payload[offset++];
+      if (length > slot->length - offset)
+      {
+        /* truncated record, discard rest of frame */
+        return 1;
+      }
+      CC2530Bee_sendRxPacket(&(slot->source), &(slot->payload[offset]), length);
+      offset += length;
+    }
+    return 1;
+  }
+  return 1;
+}
+
+/**
+ * Adds fragment to reassembly buffer of its sender and tag. First fragment
+ * takes a free buffer, if there is none or payload would not fit into it the
+ * fragment is dropped. Once last fragment was added, RX packet is sent.
+ * @param slot Receive queue slot holding fragment
+ */
+void CC2530Bee_reassemble(const RxQueue_Slot_t *slot)
+{
+  CC2530Bee_Reassembly_t *reassembly = NULL;
+  uint8_t index = slot->payload[CC2530BEE_FRAGMENT_INDEX];
+  uint8_t numFragments = slot->payload[CC2530BEE_FRAGMENT_COUNT];
+  uint8_t length = slot->length - CC2530BEE_FRAGMENT_DATA;
+  uint8_t i;
+  for (i=0; i<REASSEMBLY_NUM_BUFFERS; i++)
+  {
+    if (CC2530Bee_reassembly[i].inUse &&
+        (CC2530Bee_reassembly[i].tag == slot->payload[CC2530BEE_FRAGMENT_TAG]) &&
+        (CC2530Bee_reassembly[i].source.sourceAddressMode == slot->source.sourceAddressMode) &&
+        ((slot->source.sourceAddressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT) ?
+         (memcmp(CC2530Bee_reassembly[i].source.extendedAddress, slot->source.extendedAddress, sizeof(IEEE802154_ExtendedAddress_t)) == 0) :
+         (CC2530Bee_reassembly[i].source.shortAddress == slot->source.shortAddress)))
+    {
+      reassembly = &CC2530Bee_reassembly[i];
+    }
+  }
+  if (reassembly == NULL)
+  {
+    if ((index != 0) || (numFragments < 2) ||
+        ((uint16_t)(numFragments - 1) * CC2530BEE_FRAGMENT_DATA_LENGTH >= FRAGMENT_MAX_PAYLOAD_LENGTH))
+    {
+      /* start of payload was missed or it is too large */
+      return;
+    }
+    for (i=0; (i<REASSEMBLY_NUM_BUFFERS) && (reassembly == NULL); i++)
+    {
+      if (!CC2530Bee_reassembly[i].inUse)
+      {
+        reassembly = &CC2530Bee_reassembly[i];
+      }
+    }
+    if (reassembly == NULL)
+    {
+      return;
+    }
+    reassembly->inUse = 1;
+    reassembly->source = slot->source;
+    reassembly->tag = slot->payload[CC2530BEE_FRAGMENT_TAG];
+    reassembly->numFragments = numFragments;
+    reassembly->nextFragment = 0;
+    reassembly->length = 0;
+    reassembly->startTime = CC2530Bee_getSleepTimer();
+  }
+  if (index != reassembly->nextFragment)
+  {
+    /* repeated fragment (ACK was lost) is ignored, a missing one drops payload */
+    if (index + 1 != reassembly->nextFragment)
+    {
+      reassembly->inUse = 0;
+    }
+    return;
+  }
+  if ((numFragments != reassembly->numFragments) ||
+      ((index + 1 < numFragments) && (length != CC2530BEE_FRAGMENT_DATA_LENGTH)) ||
+      (reassembly->length + length > FRAGMENT_MAX_PAYLOAD_LENGTH))
+  {
+    reassembly->inUse = 0;
+    return;
+  }
+  memcpy(&(reassembly->payload[reassembly->length]), &(slot->payload[CC2530BEE_FRAGMENT_DATA]), length);
+  reassembly->length += length;
+  reassembly->nextFragment++;
+  if (reassembly->nextFragment == reassembly->numFragments)
+  {
+    CC2530Bee_sendRxPacket(&(reassembly->source), reassembly->payload, reassembly->length);
+    reassembly->inUse = 0;
+  }
+}
+
+/**
+ * Discards reassemblies whose remaining fragments did not arrive within
+ * CC2530BEE_REASSEMBLY_TIMEOUT
+ */
+void CC2530Bee_reassemblyPoll(void)
+{
+  uint8_t i;
+  for (i=0; i<REASSEMBLY_NUM_BUFFERS; i++)
+  {
+    if (CC2530Bee_reassembly[i].inUse &&
+        (((CC2530Bee_getSleepTimer() - CC2530Bee_reassembly[i].startTime) & CC2530BEE_SLEEPTIMER_MASK) >= CC2530BEE_REASSEMBLY_TIMEOUT))
+    {
+      CC2530Bee_reassembly[i].inUse = 0;
+    }
+  }
+}
+
+/**
+ * Sends payload received via radio as RX packet API frame via UART, or as is
+ * in transparent mode
+ * @param source Source address, RSSI and options
+ * @param payload Payload of RX packet
+ * @param length Number of bytes of payload
+ */
+void CC2530Bee_sendRxPacket(const RxQueue_Source_t *source, const IEEE802154_Payload *payload, uint16_t length)
+{
+  /* API identifier plus 16bit address, RSSI and options. 64bit address and
+   * payload are sent directly from where they are stored. */
+  APIFramePayload_t header[3];
+  APIFramePayload_t rssiOptions[2];
+  UARTAPI_Segment_t segments[4];
+  uint8_t numSegments = 0;
+  if (CC2530Bee_Config.APIMode == CC2530BEE_APIMODE_TRANSPARENT)
+  {
+    UARTAPI_writeUnescaped(payload, length);
+    UartDma_flush();
+    return;
+  }
+  segments[numSegments].data = header;
+  if (source->sourceAddressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT)
+  {
+    header[0] = UARTAPI_RECEIVE_PACKAGE_64BIT;
+    segments[numSegments++].length = 1;
+    segments[numSegments].data = source->extendedAddress;
+    segments[numSegments++].length = sizeof(IEEE802154_ExtendedAddress_t);
+  }
+  else if (source->sourceAddressMode == IEEE802154_FCF_ADDRESS_MODE_16BIT)
+  {
+    header[0] = UARTAPI_RECEIVE_PACKAGE_16BIT;
+    header[1] = HI_UINT16(source->shortAddress);
+    header[2] = LO_UINT16(source->shortAddress);
+    segments[numSegments++].length = 3;
+  }
+  else /* IEEE802154_FCF_ADDRESS_MODE_NONE */
+  {
+    header[0] = UARTAPI_RECEIVE_PACKAGE_NONE;
+    segments[numSegments++].length = 1;
+  }
+  rssiOptions[0] = source->rssi;
+  rssiOptions[1] = source->options;
+  segments[numSegments].data = rssiOptions;
+  segments[numSegments++].length = sizeof(rssiOptions);
+  segments[numSegments].data = payload;
+  segments[numSegments++].length = length;
+  UARTAPI_sentFrameSegments(segments, numSegments);
+  CC2530Bee_statistics.uartTxRxPacket++;
+}
+
+/**
+ * Collects bytes received via UART in transparent mode into next free transmit
+ * queue slot. Slot is handed over to radio side once it is full or no byte was
+ * received for RO_PacketizationTimeout character times. If transmit queue is
+ * full, bytes stay in DMA rx buffer.
+ */
+void CC2530Bee_transparentReceive(void)
+{
+  APIFramePayload_t *data;
+  uint32_t now;
+  uint8_t numBytes;
+  if ((CC2530Bee_transparentTx.length == 0) && !UartDma_rxAvailable())
+  {
+    /* no frame pool buffer is taken while UART is idle */
+    return;
+  }
+  data = TxQueue_getFreeSlot();
+  if (data == NULL)
+  {
+    return;
+  }
+  now = CC2530Bee_getSleepTimer();
+  if (UartDma_rxFull())
+  {
+    CC2530Bee_statistics.uartRxBufferFull++;
+  }
+  if (UartDma_rxAvailable())
+  {
+    if (CC2530Bee_transparentTx.length == 0)
+    {
+      CC2530Bee_transparentTx.length = CC2530Bee_transparentHeader(data);
+    }
+    numBytes = UartDma_read(&data[CC2530Bee_transparentTx.length],
+                            (uint8_t)(CC2530BEE_TRANSPARENT_MAX_LENGTH - CC2530Bee_transparentTx.length));
+    CC2530Bee_transparentTx.length += numBytes;
+    CC2530Bee_transparentTx.lastRxTime = now;
+  }
+  if ((CC2530Bee_transparentTx.length == CC2530BEE_TRANSPARENT_MAX_LENGTH) ||
+      ((CC2530Bee_transparentTx.length > 0) &&
+       (((now - CC2530Bee_transparentTx.lastRxTime) & CC2530BEE_SLEEPTIMER_MASK) >= CC2530Bee_transparentTx.timeout)))
+  {
+    TxQueue_commit(CC2530Bee_transparentTx.length);
+    CC2530Bee_transparentTx.length = 0;
+  }
+}
+
+/**
+ * Writes TX request API frame header addressed to configured destination
+ * (DH/DL) to data. Frame ID is 0, options are taken from configuration.
+ * @param data Transmit queue slot
+ * @return Offset of payload in data
+ */
+uint8_t CC2530Bee_transparentHeader(APIFramePayload_t *data)
+{
+  if (IEEE802154_TxDataFrame.fcf.destinationAddressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT)
+  {
+    data[0] = UARTAPI_TRAMSMIT_REQUEST_64BIT;
+    data[UARTAPI_64BITTRANSMIT_FRAMEID] = 0x00;
+    memcpy(&(data[UARTAPI_64BITTRANSMIT_ADDRESS]), &(IEEE802154_TxDataFrame.destinationAddress.extendedAdress), sizeof(IEEE802154_ExtendedAddress_t));
+    data[UARTAPI_64BITTRANSMIT_OPTIONS] = 0x00;
+    return UARTAPI_64BITTRANSMIT_DATA;
+  }
+  data[0] = UARTAPI_TRAMSMIT_REQUEST_16BIT;
+  data[UARTAPI_16BITTRANSMIT_FRAMEID] = 0x00;
+  *((IEEE802154_ShortAddress_t*)&data[UARTAPI_16BITTRANSMIT_ADDRESS]) = IEEE802154_TxDataFrame.destinationAddress.shortAddress;
+  data[UARTAPI_16BITTRANSMIT_OPTIONS] = 0x00;
+  return UARTAPI_16BITTRANSMIT_DATA;
+}
+
+/**
+ * Reads 24bit sleep timer count (32kHz). Interrupts are disabled meanwhile,
+ * so that a read from interrupt context does not latch ST1 and ST2 again.
+ * @return Current sleep timer count
+ */
+uint32_t CC2530Bee_getSleepTimer(void)
+{
+  uint32_t now;
+  disableAllInterrupt();
+  now = CC2530Bee_readSleepTimer();
+  enableAllInterrupt();
+  return now;
+}
+
+/**
+ * Reads 24bit sleep timer count (32kHz).
+ * @return Current sleep timer count
+ * @note Use CC2530Bee_getSleepTimer outside of interrupt context
+ */
+uint32_t CC2530Bee_readSleepTimer(void)
+{
+  sleepTimer_t sleepTimer;
+  /* reading ST0 latches ST1 and ST2 */
+  sleepTimer.byte[0] = ST0;
+  sleepTimer.byte[1] = ST1;
+  sleepTimer.byte[2] = ST2;
+  sleepTimer.byte[3] = 0x00;
+  return sleepTimer.value;
+}
+
+/**
+ * @return 1 if slot holds remote AT command request or response
+ */
+uint8_t CC2530Bee_isRemoteAT(const RxQueue_Slot_t *slot)
+{
+  return slot->control && (slot->length > CC2530BEE_REMOTEAT_API_IDENTIFIER) &&
+         (slot->payload[CC2530BEE_FRAME_TYPE] == CC2530BEE_FRAME_TYPE_REMOTEAT);
+}
+
+/**
+ * Runs remote AT command request received via radio through AT command
+ * handlers and prepares response to requesting node. Response to broadcast
+ * request is delayed by a jitter derived from own 64bit address and frame ID.
+ * Only called while no response is pending, see CC2530Bee_deliverRxFrame.
+ * @param slot Receive queue slot holding request
+ */
+void CC2530Bee_remoteATRequest(const RxQueue_Slot_t *slot)
+{
+  CC2530Bee_RemoteATResponse_t *response = &CC2530Bee_remoteATResponse;
+  APIFramePayload_t *frame = &(response->payload[CC2530BEE_REMOTEAT_API_IDENTIFIER]);
+  uint8_t parameterLength;
+  uint8_t responseLength;
+  uint16_t hash;
+  uint8_t i;
+  /* response needs requesting node as destination */
+  if ((slot->length < CC2530BEE_REMOTEAT_REQUEST_DATA) || (slot->source.sourceAddressMode == IEEE802154_FCF_ADDRESS_MODE_NONE))
+  {
+    return;
+  }
+  parameterLength = slot->length - CC2530BEE_REMOTEAT_REQUEST_DATA;
+  response->payload[CC2530BEE_FRAME_TYPE] = CC2530BEE_FRAME_TYPE_REMOTEAT;
+  frame[0] = UARTAPI_REMOTE_AT_COMMAND_RESPONSE;
+  frame[UARTAPI_REMOTEAT_RESPONSE_FRAMEID] = slot->payload[CC2530BEE_REMOTEAT_REQUEST_FRAMEID];
+  memcpy(&frame[UARTAPI_REMOTEAT_RESPONSE_ADDRESS64], IEEE802154_TxDataFrame.sourceAddress.extendedAdress, sizeof(IEEE802154_ExtendedAddress_t));
+  frame[UARTAPI_REMOTEAT_RESPONSE_ADDRESS16] = HI_UINT16(IEEE802154_TxDataFrame.sourceAddress.shortAddress);
+  frame[UARTAPI_REMOTEAT_RESPONSE_ADDRESS16 + 1] = LO_UINT16(IEEE802154_TxDataFrame.sourceAddress.shortAddress);
+  frame[UARTAPI_REMOTEAT_RESPONSE_COMMAND] = slot->payload[CC2530BEE_REMOTEAT_REQUEST_COMMAND];
+  frame[UARTAPI_REMOTEAT_RESPONSE_COMMAND + 1] = slot->payload[CC2530BEE_REMOTEAT_REQUEST_COMMAND + 1];
+  response->command = UARTAPI_handleATCommand(&(slot->payload[CC2530BEE_REMOTEAT_REQUEST_COMMAND]), parameterLength,
+                                              &frame[UARTAPI_REMOTEAT_RESPONSE_STATUS], &responseLength);
+  if ((response->command != NULL) && (response->command->flags & UARTAPI_ATPARAM_DEFERRED))
+  {
+    /* deferred commands only answer via UART */
+    frame[UARTAPI_REMOTEAT_RESPONSE_STATUS] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_ERROR;
+    response->command = NULL;
+  }
+  response->apply = (parameterLength > 0) && (slot->payload[CC2530BEE_REMOTEAT_REQUEST_OPTIONS] & UARTAPI_REMOTEAT_OPTIONS_APPLYCHANGES);
+  response->length = CC2530BEE_REMOTEAT_API_IDENTIFIER + UARTAPI_REMOTEAT_RESPONSE_STATUS + responseLength;
+  response->destinationAddressMode = slot->source.sourceAddressMode;
+  response->shortAddress = slot->source.shortAddress;
+  memcpy(response->extendedAddress, slot->source.extendedAddress, sizeof(IEEE802154_ExtendedAddress_t));
+  response->queued = 0;
+  response->startTime = CC2530Bee_getSleepTimer();
+  response->delay = 0;
+  if (slot->source.options & (UARTAPI_RECEVICE_OPTIONS_ADDRESS_BROADCAST | UARTAPI_RECEVICE_OPTIONS_PAN_BROADCAST))
+  {
+    hash = frame[UARTAPI_REMOTEAT_RESPONSE_FRAMEID];
+    for (i=0; i<sizeof(IEEE802154_ExtendedAddress_t); i++)
+    {
+      hash = hash * 31 + frame[UARTAPI_REMOTEAT_RESPONSE_ADDRESS64 + i];
+    }
+    response->delay = hash % CC2530BEE_REMOTEAT_JITTER;
+  }
+  CC2530Bee_remoteATPoll();
+}
+
+/**
+ * Queues pending remote AT command response once its jitter passed
+ */
+void CC2530Bee_remoteATPoll(void)
+{
+  if ((CC2530Bee_remoteATResponse.length > 0) &&
+      (((CC2530Bee_getSleepTimer() - CC2530Bee_remoteATResponse.startTime) & CC2530BEE_SLEEPTIMER_MASK) >= CC2530Bee_remoteATResponse.delay))
+  {
+    CC2530Bee_remoteATQueue();
+  }
+}
+
+/**
+ * Appends pending remote AT command response to transmit queue, so that it is
+ * sent with CSMA-CA, ACK and retries behind frames queued before. If transmit
+ * queue or frame pool is full, CC2530Bee_remoteATPoll tries again.
+ */
+void CC2530Bee_remoteATQueue(void)
+{
+  CC2530Bee_RemoteATResponse_t *response = &CC2530Bee_remoteATResponse;
+  APIFramePayload_t *data;
+  if (response->queued)
+  {
+    return;
+  }
+  data = FramePool_alloc();
+  if (data == NULL)
+  {
+    return;
+  }
+  data[0] = UARTAPI_REMOTE_AT_COMMAND_RESPONSE;
+  data[UARTAPI_REMOTEAT_FRAMEID] = 0x00;
+  if (response->destinationAddressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT)
+  {
+    memcpy(&data[UARTAPI_REMOTEAT_ADDRESS64], response->extendedAddress, sizeof(IEEE802154_ExtendedAddress_t));
+    data[UARTAPI_REMOTEAT_ADDRESS16] = HI_UINT16(UARTAPI_REMOTEAT_USE_64BIT_ADDRESS);
+    data[UARTAPI_REMOTEAT_ADDRESS16 + 1] = LO_UINT16(UARTAPI_REMOTEAT_USE_64BIT_ADDRESS);
+  }
+  else
+  {
+    *((IEEE802154_ShortAddress_t*)&data[UARTAPI_REMOTEAT_ADDRESS16]) = response->shortAddress;
+  }
+  memcpy(&data[CC2530BEE_REMOTEAT_RESPONSE_PAYLOAD], response->payload, response->length);
+  if (TxQueue_append(data, CC2530BEE_REMOTEAT_RESPONSE_PAYLOAD + response->length))
+  {
+    response->queued = 1;
+  }
+  else
+  {
+    FramePool_release(data);
+  }
+}
+
+/**
+ * Called once remote AT command response left transmit queue. Afterwards
+ * command is executed or staged changes are applied, just as for AT commands
+ * via UART.
+ */
+void CC2530Bee_remoteATSent(void)
+{
+  CC2530Bee_RemoteATResponse_t *response = &CC2530Bee_remoteATResponse;
+  response->length = 0;
+  response->queued = 0;
+  if (response->command != NULL)
+  {
+    UARTAPI_finishATCommand(response->command, response->apply);
+  }
+}
+
+/**
+ * Sets USART baud rate and adapts everything depending on character time.
+ * @param baudrate USART baud rate setting
+ */
+void CC2530Bee_setBaudrate(USART_Baudrate_t baudrate)
+{
+  uint32_t bitsPerSecond = CC2530Bee_getBaudrate(baudrate);
+  UartDma_setBaudrate(baudrate);
+  /* Packetization timeout for transparent mode in sleep timer ticks, rounded up */
+  CC2530Bee_transparentTx.timeout = ((uint32_t)CC2530Bee_Config.RO_PacketizationTimeout * CC2530BEE_UART_BITS_PER_CHARACTER * CC2530BEE_SLEEPTIMER_FREQUENCY
+                                     + bitsPerSecond - 1) / bitsPerSecond;
+}
+
+/**
+ * Restores default configuration in RAM and applies it. Radio is
+ * re-initialized immediately, a changed baud rate is applied as soon as
+ * USART tx buffer is empty. Configuration stored in flash is not changed.
+ */
+void CC2530Bee_restoreDefaults(void)
+{
+  USART_Baudrate_t baudrate = CC2530Bee_Config.USART_Baudrate;
+  CC2530Bee_pendingChanges = 0;
+  CC2530Bee_defaultConfig(&CC2530Bee_Config);
+  CC2530Bee_radioTxPurge();
+  CC2530Bee_radioInit();
+  UARTAPI_setAPIMode(CC2530Bee_Config.APIMode);
+  USART_setParity(CC2530Bee_Config.USART_Parity);
+  if (CC2530Bee_Config.USART_Baudrate != baudrate)
+  {
+    CC2530BeeState = CC2530BeeState_SetBaudrate;
+  }
+}
+
+/**
+ * Appends current configuration including tx header template to flash
+ */
+void CC2530Bee_writeConfig(void)
+{
+  CC2530Bee_Config.IEEE802154_TxDataFrame = IEEE802154_TxDataFrame;
+  ConfigStore_save(&CC2530Bee_Config);
+}
+
+/**
+ * Resets CC2530 via watchdog. Watchdog is triggered one more time to make sure
+ * that UART tx buffer can be emptied before watchdog reset.
+ */
+void CC2530Bee_softwareReset(void)
+{
+  WDT_trigger();
+  while (1)
+  {
+    nop();
+  }
+}
+
+/**
+ * Gets shadow configuration to stage a parameter change in. Shadow is a copy
+ * of current configuration and tx header template if no changes are pending.
+ * @param changes Side effects of change to be staged (CC2530BEE_CONFIGCHANGE_*)
+ * @return Pointer to shadow configuration
+ */
+CC2530Bee_Config_t *CC2530Bee_stageConfig(uint8_t changes)
+{
+  if (CC2530Bee_pendingChanges == 0)
+  {
+    CC2530Bee_shadowConfig = CC2530Bee_Config;
+    CC2530Bee_shadowConfig.IEEE802154_TxDataFrame = IEEE802154_TxDataFrame;
+  }
+  CC2530Bee_pendingChanges |= changes;
+  return &CC2530Bee_shadowConfig;
+}
+
+/**
+ * Applies all changes staged in shadow configuration at once. Radio is
+ * re-initialized at most once, a changed baud rate is applied as soon as
+ * USART tx buffer is empty. Must be called after AT command response was sent.
+ */
+void CC2530Bee_applyConfig(void)
+{
+  uint8_t changes = CC2530Bee_pendingChanges;
+  if (changes == 0)
+  {
+    return;
+  }
+  CC2530Bee_pendingChanges = 0;
+  CC2530Bee_Config = CC2530Bee_shadowConfig;
+  IEEE802154_TxDataFrame = CC2530Bee_shadowConfig.IEEE802154_TxDataFrame;
+  disableAllInterrupt();
+  Duplicate_init((uint32_t)CC2530Bee_Config.DuplicateWindow * CC2530BEE_SLEEPTIMER_FREQUENCY / 1000);
+  enableAllInterrupt();
+  if (changes & CC2530BEE_CONFIGCHANGE_RADIO)
+  {
+    CC2530Bee_radioTxPurge();
+    CC2530Bee_radioInit();
+  }
+  if (changes & CC2530BEE_CONFIGCHANGE_APIMODE)
+  {
+    UARTAPI_setAPIMode(CC2530Bee_Config.APIMode);
+  }
+  if (changes & CC2530BEE_CONFIGCHANGE_BAUDRATE)
+  {
+    CC2530BeeState = CC2530BeeState_SetBaudrate;
+  }
+}
+
+/**
+ * Converts USART baud rate setting to bits per second
+ * @param baudrate USART baud rate setting
+ * @return Baud rate in bits per second
+ */
+uint32_t CC2530Bee_getBaudrate(USART_Baudrate_t baudrate)
+{
+  switch (baudrate)
+  {
+    case USART_Baudrate_2400:
+      return 2400;
+    case USART_Baudrate_4800:
+      return 4800;
+    case USART_Baudrate_9600:
+      return 9600;
+    case USART_Baudrate_14400:
+      return 14400;
+    case USART_Baudrate_19200:
+      return 19200;
+    case USART_Baudrate_28800:
+      return 28800;
+    case USART_Baudrate_38400:
+      return 38400;
+    case USART_Baudrate_57600:
+      return 57600;
+    case USART_Baudrate_76800:
+      return 76800;
+    case USART_Baudrate_115200:
+      return 115200;
+    case USART_Baudrate_230400:
+      return 230400;
+  }
+  return 57600;
+}
+
+/**
+ * Load config from flash. If no record with valid CRC is found default config is loaded.
+ * Tx header template is copied to #IEEE802154_TxDataFrame.
+ * @param config Pointer to configuration struct in which to store the configuration read from flash
+ */
+void CC2530Bee_loadConfig(CC2530Bee_Config_t *config)
+{
+  CC2530Bee_defaultConfig(config);
+  if (ConfigStore_load(config))
+  {
+    IEEE802154_TxDataFrame = config->IEEE802154_TxDataFrame;
+  }
+}
+
+/**
+ * Load default config. Tx header template is prepared in #IEEE802154_TxDataFrame
+ * and copied to config.
+ * @param config Pointer to configuration struct in which to store the default configuration
+ */
+void CC2530Bee_defaultConfig(CC2530Bee_Config_t *config)
+{
+  config->USART_Baudrate = CC2530BEE_Default_Baudrate;
+  config->USART_Parity = USART_Parity_8BitNoParity;
+  
+  /* General radio configuration */
+  config->IEEE802154_config.Channel = CC2530BEE_Default_Channel;
+  config->IEEE802154_config.PanID = CC2530BEE_Default_PanID;
+  config->IEEE802154_config.shortAddress = CC2530BEE_Default_ShortAddress;
+  
+  /* prepare header for IEEE 802.15.4 Tx message. Values are stored in config but must be copied 
+   * to #IEEE802154_TxDataFrame in order to be effective. */
+  IEEE802154_TxDataFrame.fcf.frameType = IEEE802154_FCF_FRAME_TYPE_DATA;  /* 3: 0x01 */
+  IEEE802154_TxDataFrame.fcf.securityEnabled = IEEE802154_FCF_SECURITY_DISABLED; /* 1: 0x0 */
+  IEEE802154_TxDataFrame.fcf.framePending = 0x0; /* 1:0x0 */
+  IEEE802154_TxDataFrame.fcf.ackRequired = IEEE802154_FCF_ACKNOWLEDGE_REQUIRED; /* 1: 0x1 */
+#ifdef IEEE802154_ENABLE_PANID_COMPRESSION
+  IEEE802154_TxDataFrame.fcf.panIdCompression = IEEE802154_FCF_PANIDCOMPRESSION_ENABLED; /* 1: 0x1 */
+#else
+  IEEE802154_TxDataFrame.fcf.panIdCompression = IEEE802154_FCF_PANIDCOMPRESSION_DISABLED; /* 1: 0x0 */
+#endif
+  IEEE802154_TxDataFrame.fcf.destinationAddressMode = CC2530BEE_Default_DestinationAdressingMode;
+  IEEE802154_TxDataFrame.fcf.frameVersion = 0x00;
+  IEEE802154_TxDataFrame.fcf.reserved = 0x0;
+  IEEE802154_TxDataFrame.fcf.sourceAddressMode = CC2530BEE_Default_SourceAdressingMode;
+  /* preset variable to some meaningfull values */
+  IEEE802154_TxDataFrame.sequenceNumber = 0x00;
+  IEEE802154_TxDataFrame.destinationPANID = CC2530BEE_Default_PanID;
+  IEEE802154_TxDataFrame.destinationAddress.shortAddress = 0xffff;   /* broadcast */
+  IEEE802154_TxDataFrame.sourceAddress.shortAddress = CC2530BEE_Default_ShortAddress;
+  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[0] = IEEE_EXTENDED_ADDRESS0;
+  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[1] = IEEE_EXTENDED_ADDRESS1;
+  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[2] = IEEE_EXTENDED_ADDRESS2;
+  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[3] = IEEE_EXTENDED_ADDRESS3;
+  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[4] = IEEE_EXTENDED_ADDRESS4;
+  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[5] = IEEE_EXTENDED_ADDRESS5;
+  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[6] = IEEE_EXTENDED_ADDRESS6;
+  IEEE802154_TxDataFrame.sourceAddress.extendedAdress[7] = IEEE_EXTENDED_ADDRESS7;
+  
+  config->RO_PacketizationTimeout = CC2530BEE_Default_RO_PacketizationTimeout;
+  config->APIMode = CC2530BEE_Default_APIMode;
+  config->MACRetries = CC2530BEE_Default_MACRetries;
+  config->MinBackoffExponent = CC2530BEE_Default_MinBackoffExponent;
+  config->AggregationWindow = CC2530BEE_Default_AggregationWindow;
+  config->DuplicateWindow = CC2530BEE_Default_DuplicateWindow;
+  config->SnifferMode = CC2530BEE_Default_SnifferMode;
+  config->SleepMode = CC2530BEE_Default_SleepMode;
+  config->SleepPeriod = CC2530BEE_Default_SleepPeriod;
+  config->TimeBeforeSleep = CC2530BEE_Default_TimeBeforeSleep;
+  config->ScanChannels = CC2530BEE_Default_ScanChannels;
+  config->ScanDuration = CC2530BEE_Default_ScanDuration;
+  config->CoordinatorAssociation = CC2530BEE_Default_CoordinatorAssociation;
+  config->IEEE802154_TxDataFrame = IEEE802154_TxDataFrame;
+}
+
+/**
+ * Incremental receiver for UART API frames. Consumes all bytes currently in
+ * DMA rx buffer (but never more than one frame) and returns without
+ * blocking. Frame state is kept in #UARTAPI_rxParser between calls.
+ * Bytes are fetched from DMA rx buffer (see UartDma.h) in blocks of up to
+ * #UARTAPI_RX_BUFFER_SIZE,
+ * bytes following a completed frame are kept for the next call (see
+ * UARTAPI_numBytesInRxBuffer).
+ * An unescaped delimiter within frame data restarts reception, thus the
+ * parser re-synchronizes after truncated frames. Frames with length 0 or
+ * longer than #UARTAPI_MAX_PAYLOAD_LENGTH are discarded.
+ * @note Length and checksum are not escaped by host (see BaseTest.py), thus
+ * a delimiter value is only treated as start of frame within frame data.
+ * @param frame UART API frame to receive header and data into
+ * @return UARTFrame_CRC_OK if a complete frame with matching crc was received,
+ * UARTFrame_CRC_Not_OK if crc did not match, UARTFrame_Incomplete else
+ */
+uint8_t UARTAPI_receiveFrame(APIFrame_t *frame)
+{
+  uint8_t c;
+  if (UartDma_rxFull())
+  {
+    CC2530Bee_statistics.uartRxBufferFull++;
+  }
+  while (1)
+  {
+    if (UARTAPI_rxParser.bufferIndex == UARTAPI_rxParser.bufferLength)
+    {
+      UARTAPI_rxParser.bufferLength = UartDma_read(UARTAPI_rxParser.buffer, UARTAPI_RX_BUFFER_SIZE);
+      UARTAPI_rxParser.bufferIndex = 0;
+      if (UARTAPI_rxParser.bufferLength == 0)
+      {
+        break;
+      }
+    }
+    if (UARTAPI_rxParser.state == UARTAPI_RxState_Data)
+    {
+      UARTAPI_codec->receiveData(frame);
+      continue;
+    }
+    c = UARTAPI_rxParser.buffer[UARTAPI_rxParser.bufferIndex++];
+    switch (UARTAPI_rxParser.state)
+    {
+    case UARTAPI_RxState_Delimiter:
+      if (c == UARTFrame_Delimiter)
+      {
+        frame->header.delimiter = c;
+        UARTAPI_rxParser.state = UARTAPI_RxState_Length0;
+      }
+      break;
+    case UARTAPI_RxState_Length0:
+      /* length is stored in the same byte order it was received */
+      ((uint8_t *)&(frame->header.length))[0] = c;
+      UARTAPI_rxParser.state = UARTAPI_RxState_Length1;
+      break;
+    case UARTAPI_RxState_Length1:
+      ((uint8_t *)&(frame->header.length))[1] = c;
+      /* received data is big-endian, mcu is little endian */
+      SWAP_UINT16(frame->header.length);
+      if ((frame->header.length == 0) || (frame->header.length > UARTAPI_MAX_PAYLOAD_LENGTH))
+      {
+        CC2530Bee_statistics.uartLengthErrors++;
+        UARTAPI_rxParser.state = UARTAPI_RxState_Delimiter;
+      }
+      else
+      {
+        TRACE(TRACE_UART_HEADER, frame->header.length);
+        UARTAPI_rxParser.index = 0;
+        UARTAPI_rxParser.crc = 0;
+        UARTAPI_rxParser.escaped = 0;
+        UARTAPI_rxParser.state = UARTAPI_RxState_Data;
+      }
+      break;
+    case UARTAPI_RxState_Checksum:
+      UARTAPI_rxParser.state = UARTAPI_RxState_Delimiter;
+      TRACE(TRACE_UART_FRAME, frame->data[0]);
+      /* Check crc. The sum of received data + received crc must be 0xff */
+      frame->crc = c;
+      if ((uint8_t)(UARTAPI_rxParser.crc + c) == 0xff)
+      {
+        return UARTFrame_CRC_OK;
+      }
+      else
+      {
+        return UARTFrame_CRC_Not_OK;
+      }
+    default:
+      break;
+    }
+  }
+  return UARTFrame_Incomplete;
+}
+
+/**
+ * Decodes escaped frame data (API mode 2) from #UARTAPI_rxParser buffer until
+ * buffer is empty, frame data is complete or a control character is found.
+ * Plain data bytes are copied and added to checksum in a tight loop, escape
+ * characters and delimiters are handled one at a time.
+ * @param frame UART API frame to receive data into
+ */
+void UARTAPI_receiveDataEscaped(APIFrame_t *frame)
+{
+  uint8_t *in = &UARTAPI_rxParser.buffer[UARTAPI_rxParser.bufferIndex];
+  uint8_t *end = &UARTAPI_rxParser.buffer[UARTAPI_rxParser.bufferLength];
+  APIFramePayload_t *out = &frame->data[UARTAPI_rxParser.index];
+  APIFramePayload_t *outEnd = &frame->data[frame->header.length];
+  uint8_t crc = UARTAPI_rxParser.crc;
+  uint8_t c;
+
+  if (UARTAPI_rxParser.escaped && (*in != UARTFrame_Delimiter))
+  {
+    c = *in++ ^ UARTFrame_Escape_Mask;
+    UARTAPI_rxParser.escaped = 0;
+    *out++ = c;
+    crc += c;
+  }
+  while ((in < end) && (out < outEnd))
+  {
+    c = *in;
+    if (UARTAPI_charClass[c] & UARTAPI_CHARCLASS_CONTROL)
+    {
+      break;
+    }
+    in++;
+    *out++ = c;
+    crc += c;
+  }
+  if ((in < end) && (out < outEnd))
+  {
+    if (*in++ == UARTFrame_Delimiter)
+    {
+      /* start of new frame, previous one was truncated */
+      frame->header.delimiter = UARTFrame_Delimiter;
+      UARTAPI_rxParser.escaped = 0;
+      UARTAPI_rxParser.state = UARTAPI_RxState_Length0;
+    }
+    else
+    {
+      UARTAPI_rxParser.escaped = 1;
+    }
+  }
+  if (out == outEnd)
+  {
+    UARTAPI_rxParser.state = UARTAPI_RxState_Checksum;
+  }
+  UARTAPI_rxParser.bufferIndex = (uint8_t)(in - UARTAPI_rxParser.buffer);
+  UARTAPI_rxParser.index = (uint16_t)(out - frame->data);
+  UARTAPI_rxParser.crc = crc;
+}
+
+/**
+ * Copies unescaped frame data (API mode 1) from #UARTAPI_rxParser buffer until
+ * buffer is empty or frame data is complete. Delimiter values within frame
+ * data are data, re-synchronization relies on length and checksum.
+ * @param frame UART API frame to receive data into
+ */
+void UARTAPI_receiveDataUnescaped(APIFrame_t *frame)
+{
+  uint8_t *in = &UARTAPI_rxParser.buffer[UARTAPI_rxParser.bufferIndex];
+  uint8_t numBytes = UARTAPI_rxParser.bufferLength - UARTAPI_rxParser.bufferIndex;
+  APIFramePayload_t *out = &frame->data[UARTAPI_rxParser.index];
+  uint8_t crc = UARTAPI_rxParser.crc;
+  uint8_t i;
+  if (numBytes > frame->header.length - UARTAPI_rxParser.index)
+  {
+    numBytes = (uint8_t)(frame->header.length - UARTAPI_rxParser.index);
+  }
+  for (i=0; i<numBytes; i++)
+  {
+    out[i] = in[i];
+    crc += in[i];
+  }
+  UARTAPI_rxParser.bufferIndex += numBytes;
+  UARTAPI_rxParser.index += numBytes;
+  UARTAPI_rxParser.crc = crc;
+  if (UARTAPI_rxParser.index == frame->header.length)
+  {
+    UARTAPI_rxParser.state = UARTAPI_RxState_Checksum;
+  }
+}
+
+/**
+ * Returns number of bytes which were already read from USART by
+ * UARTAPI_receiveFrame but not yet parsed.
+ */
+uint8_t UARTAPI_numBytesInRxBuffer(void)
+{
+  return UARTAPI_rxParser.bufferLength - UARTAPI_rxParser.bufferIndex;
+}
+
+/**
+ * Adds correct header and CRC to global variable txAPIFrame. Precondition is 
+ * that data in txAPIFrame.data was already filled.
+ * @param data Pointer to data to be send out via USART
+ * @param length number of bytes of data 
+ */
+void UARTAPI_sentFrame(APIFramePayload_t *data, uint16_t length)
+{
+  UARTAPI_Segment_t segment;
+  segment.data = data;
+  segment.length = length;
+  UARTAPI_sentFrameSegments(&segment, 1);
+}
+
+/**
+ * Sends one UART API frame whose data is scattered over several buffers, e.g.
+ * API header bytes, source address and radio payload. Segments are escaped
+ * (depending on API mode, see #UARTAPI_codec) and added to checksum in one
+ * pass straight from where they are stored into the tx ring of UartDma, thus
+ * no staging copy of the data is needed. The frame is handed to DMA as a
+ * whole once complete.
+ * @param segments Array of (pointer, length) pairs forming frame data in order
+ * @param numSegments number of entries in segments
+ */
+void UARTAPI_sentFrameSegments(const UARTAPI_Segment_t *segments, uint8_t numSegments)
+{
+  uint16_t length = 0;
+  uint8_t crc = 0;
+  uint8_t s;
+  TRACE(TRACE_UART_EMIT_START, segments[0].data[0]);
+  for (s=0; s<numSegments; s++)
+  {
+    length += segments[s].length;
+  }
+  txAPIFrame.header.delimiter = UARTFrame_Delimiter;
+  /* convert from little-endian to big-endian */
+  SWAP_UINT16(length);
+  txAPIFrame.header.length = length;
+  UartDma_write((const uint8_t *)&txAPIFrame, sizeof(APIFrameHeader_t));
+  for (s=0; s<numSegments; s++)
+  {
+    crc += UARTAPI_codec->write(segments[s].data, segments[s].length);
+  }
+  crc = 0xff-crc;
+  txAPIFrame.crc = crc;
+  UartDma_putc(crc);
+  UartDma_flush();
+  TRACE(TRACE_UART_EMIT_END, segments[0].data[0]);
+}
+
+/**
+ * Writes data to UART tx ring escaping each byte which needs to be escaped in
+ * API mode 2. Runs of bytes which need no escaping are copied as a whole.
+ * Caller hands data over to DMA (see UartDma_flush).
+ * @param data Pointer to data to be send out via USART
+ * @param length number of bytes of data, at most #UARTAPI_MAX_PAYLOAD_LENGTH
+ * @return Sum of data bytes for checksum
+ */
+uint8_t UARTAPI_writeEscaped(const APIFramePayload_t *data, uint16_t length)
+{
+  uint16_t i;
+  uint16_t run = 0;
+  uint8_t crc = 0;
+  for (i=0; i<length; i++)
+  {
+    crc += data[i];
+    if (UARTAPI_charClass[data[i]] & UARTAPI_CHARCLASS_ESCAPE)
+    {
+      /* flush bytes before */
+      if (run > 0)
+      {
+        UartDma_write(&data[i-run], run);
+        run = 0;
+      }
+      UartDma_putc(UARTFrame_Escape_Character);
+      UartDma_putc(data[i]^UARTFrame_Escape_Mask);
+    }
+    else
+    {
+      run++;
+    }
+  }
+  if (run > 0)
+  {
+    UartDma_write(&data[i-run], run);
+  }
+  return crc;
+}
+
+/**
+ * Writes data to UART tx ring as is (API mode 1). Caller hands data over to
+ * DMA (see UartDma_flush).
+ * @param data Pointer to data to be send out via USART
+ * @param length number of bytes of data, at most #UARTAPI_MAX_PAYLOAD_LENGTH
+ * @return Sum of data bytes for checksum
+ */
+uint8_t UARTAPI_writeUnescaped(const APIFramePayload_t *data, uint16_t length)
+{
+  uint16_t i;
+  uint8_t crc = 0;
+  UartDma_write(data, length);
+  for (i=0; i<length; i++)
+  {
+    crc += data[i];
+  }
+  return crc;
+}
+
+/**
+ * Switches UART interface to given API mode (AP). Frame codec is selected
+ * here once, thus escaping and unescaping need no check of the mode per byte.
+ * @param apiMode One of CC2530BEE_APIMODE_*
+ */
+void UARTAPI_setAPIMode(uint8_t apiMode)
+{
+  CC2530Bee_Config.APIMode = apiMode;
+  if (apiMode == CC2530BEE_APIMODE_UNESCAPED)
+  {
+    UARTAPI_codec = &UARTAPI_codecUnescaped;
+  }
+  else
+  {
+    UARTAPI_codec = &UARTAPI_codecEscaped;
+  }
+}
+
+/**
+ * Handles trace dump request (0x45): sends entries recorded since last dump
+ * (see Trace.h) oldest first in one trace dump frame (0xc5). Entries are sent
+ * straight from the trace ring, which is paused meanwhile and emptied
+ * afterwards.
+ * @param data Pointer to data received within UART API frame
+ * @param length Number of bytes of data
+*/
+void UARTAPI_traceDump(const APIFramePayload_t *data, uint16_t length)
+{
+  APIFramePayload_t header[UARTAPI_TRACE_DUMP_ENTRIES];
+  UARTAPI_Segment_t segments[3];
+  uint8_t numSegments = 1;
+  uint8_t numEntries;
+  if (length < UARTAPI_TRACE_DUMP_REQUEST_LENGTH)
+  {
+    return;
+  }
+  Trace_paused = 1;
+  header[0] = UARTAPI_TRACE_DUMP;
+  header[UARTAPI_TRACE_DUMP_FRAMEID] = data[UARTAPI_TRACE_DUMP_FRAMEID];
+  header[UARTAPI_TRACE_DUMP_COUNT] = Trace_count;
+  header[UARTAPI_TRACE_DUMP_DROPPED] = Trace_dropped;
+  segments[0].data = header;
+  segments[0].length = sizeof(header);
+  /* ring may wrap around, entries up to its end come first */
+  numEntries = TRACE_NUM_ENTRIES - Trace_first;
+  if (numEntries > Trace_count)
+  {
+    numEntries = Trace_count;
+  }
+  if (numEntries > 0)
+  {
+    segments[numSegments].data = (const APIFramePayload_t *)&Trace_entries[Trace_first];
+    segments[numSegments++].length = numEntries * sizeof(Trace_Entry_t);
+  }
+  if (Trace_count > numEntries)
+  {
+    segments[numSegments].data = (const APIFramePayload_t *)&Trace_entries[0];
+    segments[numSegments++].length = (Trace_count - numEntries) * sizeof(Trace_Entry_t);
+  }
+  UARTAPI_sentFrameSegments(segments, numSegments);
+  Trace_release();
+}
+
+/**
+ * Handles neighbour table request (0x46): sends all entries of neighbour
+ * table (see Neighbour.h) in one neighbour table frame (0xc6). Frame is built
+ * in place of request, which was received into a transmit queue slot.
+ * @param data Pointer to data received within UART API frame
+ * @param length Number of bytes of data
+*/
+void UARTAPI_neighbourTable(APIFramePayload_t *data, uint16_t length)
+{
+  uint8_t i;
+  if (length < UARTAPI_NEIGHBOUR_TABLE_REQUEST_LENGTH)
+  {
+    return;
+  }
+  data[0] = UARTAPI_NEIGHBOUR_TABLE;
+  data[UARTAPI_NEIGHBOUR_TABLE_COUNT] = Neighbour_count;
+  for (i=0; i<Neighbour_count; i++)
+  {
+    Neighbour_read(i, &data[UARTAPI_NEIGHBOUR_TABLE_ENTRIES + i * NEIGHBOUR_ENTRY_LENGTH], CC2530Bee_getSleepTimer());
+  }
+  UARTAPI_sentFrame(data, UARTAPI_NEIGHBOUR_TABLE_ENTRIES + Neighbour_count * NEIGHBOUR_ENTRY_LENGTH);
+}
+
+/**
+ * Handles AT command (0x08) or queued AT command (0x09) received via UART.
+ * Response is sent before writes of an 0x08 frame or executed commands take
+ * effect as they might change API mode or baud rate.
+ * @param data Pointer to data received within UART API frame
+ * @param length Number of bytes of data
+*/
+void UARTAPI_atCommand(APIFramePayload_t *data, uint16_t length)
+{
+  const __code UARTAPI_ATCommand_t *command;
+  uint8_t parameterLength;
+  uint8_t responseLength;
+  if (length < UARTAPI_ATCOMMAND_READ_LENGTH)
+  {
+    return;
+  }
+  parameterLength = (uint8_t)(length - UARTAPI_ATCOMMAND_DATA);
+  /* Prepare general tx frame data. Copy frame ID an AT command to sent frame */  
+  txAPIFrame.data = FramePool_allocReserved();
+  txAPIFrame.data[0] = UARTAPI_ATCOMMAND_RESPONSE;
+  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_FRAMEID] = data[UARTAPI_ATCOMMAND_FRAMEID];
+  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_COMMAND] = data[UARTAPI_ATCOMMAND_COMMAND];
+  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_COMMAND + 1] = data[UARTAPI_ATCOMMAND_COMMAND + 1];
+  command = UARTAPI_handleATCommand(&data[UARTAPI_ATCOMMAND_COMMAND], parameterLength,
+                                    &txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS], &responseLength);
+  if ((command != NULL) && (command->flags & UARTAPI_ATPARAM_DEFERRED))
+  {
+    /* command sends response once it is done */
+    FramePool_release(txAPIFrame.data);
+    UARTAPI_deferredFrameId = data[UARTAPI_ATCOMMAND_FRAMEID];
+    command->execute();
+    return;
+  }
+  UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_ATCOMMAND_RESPONSE_STATUS + responseLength);
+  /* released before command takes effect, it might send frames itself */
+  FramePool_release(txAPIFrame.data);
+  CC2530Bee_statistics.uartTxATResponse++;
+  if (command != NULL)
+  {
+    /* queued parameters are applied together with parameter written by 0x08 */
+    UARTAPI_finishATCommand(command, (parameterLength > 0) && (data[0] == UARTAPI_ATCOMMAND));
+  }
+}
+
+/**
+ * Looks up AT command in #UARTAPI_atCommands. Without parameter it is read (or
+ * checked if it can be executed), with parameter it is written to shadow
+ * configuration. Used for AT commands received via UART or radio.
+ * @param command Pointer to two characters of AT command followed by parameter
+ * @param parameterLength Number of bytes of parameter
+ * @param response Buffer for response status followed by parameter read
+ * @param responseLength Set to number of bytes written to response
+ * @return Command descriptor to be passed to UARTAPI_finishATCommand once response was sent, NULL if command failed
+*/
+const __code UARTAPI_ATCommand_t *UARTAPI_handleATCommand(const APIFramePayload_t *command, uint8_t parameterLength, APIFramePayload_t *response, uint8_t *responseLength)
+{
+  const __code UARTAPI_ATCommand_t *descriptor;
+  uint8_t length;
+  /* get AT command and convert to little-endian */
+  descriptor = UARTAPI_findATCommand(command[0] << 8 | command[1]);
+  *responseLength = sizeof(uint8_t);
+  if (descriptor == NULL)
+  {
+    response[0] = UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_CMD;
+  }
+  else if (descriptor->flags & UARTAPI_ATPARAM_EXECUTE)
+  {
+    response[0] = (parameterLength == 0) ? UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK : UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM;
+  }
+  else if (descriptor->flags & UARTAPI_ATPARAM_NEIGHBOUR)
+  {
+    response[0] = UARTAPI_readNeighbour(&command[2], parameterLength, &response[1], &length);
+    *responseLength += length;
+  }
+  else if (parameterLength == 0)
+  {
+    response[0] = UARTAPI_readParameter(descriptor, &response[1]);
+    if (response[0] == UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK)
+    {
+      *responseLength += descriptor->width;
+    }
+  }
+  else
+  {
+    response[0] = UARTAPI_setParameter(descriptor, &command[2], parameterLength);
+  }
+  return (response[0] == UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK) ? descriptor : NULL;
+}
+
+/**
+ * Executes command or applies staged changes. Must be called once response
+ * of command was sent.
+ * @param command Command descriptor returned by UARTAPI_handleATCommand
+ * @param apply Apply changes staged in shadow configuration
+*/
+void UARTAPI_finishATCommand(const __code UARTAPI_ATCommand_t *command, uint8_t apply)
+{
+  if (command->flags & UARTAPI_ATPARAM_EXECUTE)
+  {
+    command->execute();
+  }
+  else if (apply)
+  {
+    CC2530Bee_applyConfig();
+  }
+}
+
+/**
+ * Sends AT command response (0x88) of UARTAPI_ATPARAM_DEFERRED command once
+ * it is done
+ * @param atCommand Two characters of AT command, e.g. 0x4544 for ED
+ * @param frameId Frame ID of AT command, see #UARTAPI_deferredFrameId
+ * @param status AT command response status
+ * @param value Response data
+ * @param length Number of bytes of value
+*/
+void UARTAPI_sendDeferredResponse(uint16_t atCommand, uint8_t frameId, uint8_t status, const APIFramePayload_t *value, uint8_t length)
+{
+  txAPIFrame.data = FramePool_allocReserved();
+  txAPIFrame.data[0] = UARTAPI_ATCOMMAND_RESPONSE;
+  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_FRAMEID] = frameId;
+  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_COMMAND] = HI_UINT16(atCommand);
+  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_COMMAND + 1] = LO_UINT16(atCommand);
+  txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_STATUS] = status;
+  memcpy(&txAPIFrame.data[UARTAPI_ATCOMMAND_RESPONSE_DATA], value, length);
+  UARTAPI_sentFrame(txAPIFrame.data, UARTAPI_ATCOMMAND_RESPONSE_DATA + length);
+  FramePool_release(txAPIFrame.data);
+  CC2530Bee_statistics.uartTxATResponse++;
+}
+
+/**
+ * Looks up AT command in #UARTAPI_atCommands by binary search
+ * @param atCommand Two characters of AT command, e.g. 0x4348 for CH
+ * @return Pointer to command descriptor, NULL if command is not supported
+*/
+const __code UARTAPI_ATCommand_t *UARTAPI_findATCommand(uint16_t atCommand)
+{
+  uint8_t low = 0;
+  uint8_t high = UARTAPI_NUM_ATCOMMANDS;
+  uint8_t middle;
+  while (low < high)
+  {
+    middle = (low + high) / 2;
+    if (UARTAPI_atCommands[middle].command < atCommand)
+    {
+      low = middle + 1;
+    }
+    else if (UARTAPI_atCommands[middle].command > atCommand)
+    {
+      high = middle;
+    }
+    else
+    {
+      return &UARTAPI_atCommands[middle];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @return Pointer to storage of AT command parameter in config or txHeader
+*/
+static uint8_t *UARTAPI_atParameter(const __code UARTAPI_ATCommand_t *command, CC2530Bee_Config_t *config, IEEE802154_DataFrameHeader_t *txHeader)
+{
+  if (command->flags & UARTAPI_ATPARAM_TXHEADER)
+  {
+    return (uint8_t *)txHeader + command->offset;
+  }
+  return (uint8_t *)config + command->offset;
+}
+
+/**
+ * Reads parameter of AT command from current configuration. Two byte numbers
+ * (UARTAPI_ATPARAM_NUMBER) are sent most significant byte first.
+ * @param command AT command descriptor
+ * @param value Buffer for command->width bytes of parameter value
+ * @return AT command response status
+*/
+uint8_t UARTAPI_readParameter(const __code UARTAPI_ATCommand_t *command, APIFramePayload_t *value)
+{
+  uint8_t *parameter;
+  uint8_t i;
+  if (!(command->flags & UARTAPI_ATPARAM_READ))
+  {
+    return UARTAPI_ATCOMMAND_RESPONSE_STATUS_ERROR;
+  }
+  if (command->flags & UARTAPI_ATPARAM_STATISTICS)
+  {
+    disableAllInterrupt();
+    CC2530Bee_collectStatistics();
+    parameter = (uint8_t *)&CC2530Bee_statistics + command->offset;
+    if (command->flags & UARTAPI_ATPARAM_NUMBER)
+    {
+      value[0] = HI_UINT16(*(uint16_t *)parameter);
+      value[1] = LO_UINT16(*(uint16_t *)parameter);
+    }
+    else
+    {
+      memcpy(value, parameter, command->width);
+    }
+    enableAllInterrupt();
+    return UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
+  }
+  parameter = UARTAPI_atParameter(command, &CC2530Bee_Config, &IEEE802154_TxDataFrame);
+  if (command->flags & UARTAPI_ATPARAM_BAUDRATE)
+  {
+    for (i=0; i<UARTAPI_NUM_BAUDRATES; i++)
+    {
+      if (UARTAPI_baudrates[i] == *(USART_Baudrate_t *)parameter)
+      {
+        value[0] = i + UARTAPI_BAUDRATE_FIRST;
+        return UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
+      }
+    }
+    return UARTAPI_ATCOMMAND_RESPONSE_STATUS_ERROR;
+  }
+  if (command->flags & UARTAPI_ATPARAM_NUMBER)
+  {
+    value[0] = HI_UINT16(*(uint16_t *)parameter);
+    value[1] = LO_UINT16(*(uint16_t *)parameter);
+    return UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
+  }
+  memcpy(value, parameter, command->width);
+  return UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
+}
+
+/**
+ * Reads neighbour table (LQ). Parameter is not written but selects entry.
+ * @param index Index of entry, or nothing to read number of entries
+ * @param length Number of bytes of index, 0 or 1
+ * @param value Buffer for #NEIGHBOUR_ENTRY_LENGTH bytes
+ * @param valueLength Set to number of bytes written to value
+ * @return AT command response status
+*/
+uint8_t UARTAPI_readNeighbour(const APIFramePayload_t *index, uint8_t length, APIFramePayload_t *value, uint8_t *valueLength)
+{
+  *valueLength = 0;
+  if (length == 0)
+  {
+    value[0] = Neighbour_count;
+    *valueLength = sizeof(uint8_t);
+    return UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
+  }
+  if ((length != sizeof(uint8_t)) || (index[0] >= Neighbour_count))
+  {
+    return UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM;
+  }
+  Neighbour_read(index[0], value, CC2530Bee_getSleepTimer());
+  *valueLength = NEIGHBOUR_ENTRY_LENGTH;
+  return UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
+}
+
+/**
+ * Stages parameter of AT command in shadow configuration, it is applied by
+ * CC2530Bee_applyConfig. Parameter must have exactly command->width bytes,
+ * one byte parameters must be in range of command. Two byte numbers
+ * (UARTAPI_ATPARAM_NUMBER) are received most significant byte first.
+ * Statistics counters are not staged but cleared by a single byte 0.
+ * @param command AT command descriptor
+ * @param value Parameter value received
+ * @param length Number of bytes of value
+ * @return AT command response status
+*/
+uint8_t UARTAPI_setParameter(const __code UARTAPI_ATCommand_t *command, const APIFramePayload_t *value, uint8_t length)
+{
+  CC2530Bee_Config_t *shadow;
+  uint8_t *parameter;
+  if (!(command->flags & UARTAPI_ATPARAM_WRITE))
+  {
+    return UARTAPI_ATCOMMAND_RESPONSE_STATUS_ERROR;
+  }
+  if (command->flags & UARTAPI_ATPARAM_STATISTICS)
+  {
+    /* counters are not staged, they are cleared right away */
+    if ((length != sizeof(uint8_t)) || (value[0] != 0))
+    {
+      return UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM;
+    }
+    if (command->width == sizeof(CC2530Bee_Statistics_t))
+    {
+      CC2530Bee_clearStatistics();
+    }
+    else
+    {
+      memset((uint8_t *)&CC2530Bee_statistics + command->offset, 0, command->width);
+    }
+    return UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
+  }
+  if ((length != command->width) ||
+      ((command->width == sizeof(uint8_t)) && ((value[0] < command->min) || (value[0] > command->max))))
+  {
+    return UARTAPI_ATCOMMAND_RESPONSE_STATUS_INVALID_PARAM;
+  }
+  shadow = CC2530Bee_stageConfig(command->changes);
+  parameter = UARTAPI_atParameter(command, shadow, &shadow->IEEE802154_TxDataFrame);
+  if (command->flags & UARTAPI_ATPARAM_BAUDRATE)
+  {
+    *(USART_Baudrate_t *)parameter = UARTAPI_baudrates[value[0] - UARTAPI_BAUDRATE_FIRST];
+  }
+  else if (command->flags & UARTAPI_ATPARAM_NUMBER)
+  {
+    *(uint16_t *)parameter = ((uint16_t)value[0] << 8) | value[1];
+  }
+  else
+  {
+    memcpy(parameter, value, command->width);
+  }
+  return UARTAPI_ATCOMMAND_RESPONSE_STATUS_OK;
+}
+
+/**
+ * Callback whenever Beacon frame was received
+ * @param payloadLength Length of data in IEEE802154_RxDataFrame.payload
+ * @param rssi value measured over the firs eight symbols following SFD
+ * @note This function runs in interrupt context
+*/
+void IEEE802154_UserCbk_BeaconFrameReceived(uint8_t payloadLength, sint8_t rssi)
+{
+  CC2530Bee_statistics.radioOtherFrames++;
+  if (CC2530Bee_Config.SnifferMode == CC2530BEE_SNIFFERMODE_ON)
+  {
+    Sniffer_record(&IEEE802154_RxDataFrame, payloadLength, rssi, 1, CC2530Bee_readSleepTimer());
+  }
+}
+
+/**
+ * Callback whenever Data frame was received
+ * @param payloadLength Length of data in IEEE802154_RxDataFrame.payload
+ * @param rssi value measured over the firs eight symbols following SFD
+ * @note This function runs in interrupt context
+*/
+void IEEE802154_UserCbk_DataFrameReceived(uint8_t payloadLength, sint8_t rssi)
+{
+  /* Only store what is needed for RX packet, frame will be sent via UART from main loop */
+  RxQueue_Slot_t *slot;
+  IEEE802154_Payload *payload;
+  uint32_t now;
+  TRACE(TRACE_RX_ENTRY, payloadLength);
+  CC2530Bee_statistics.radioRxFrames++;
+  if (CC2530Bee_Config.SnifferMode == CC2530BEE_SNIFFERMODE_ON)
+  {
+    /* captured instead of sent as RX packet */
+    Sniffer_record(&IEEE802154_RxDataFrame, payloadLength, rssi, 1, CC2530Bee_readSleepTimer());
+    TRACE(TRACE_RX_EXIT, payloadLength);
+    return;
+  }
+  slot = RxQueue_getFreeSlot();
+  if (slot == NULL)
+  {
+    /* queue full, frame is lost. Counted in RxQueue_overflowCount */
+    TRACE(TRACE_RX_EXIT, payloadLength);
+    return;
+  }
+  /* frame stays in buffer it was received into, next one is received into a new one */
+  payload = FramePool_alloc();
+  if (payload == NULL)
+  {
+    /* frame pool exhausted, frame is lost as if queue was full */
+    RxQueue_overflowCount++;
+    TRACE(TRACE_RX_EXIT, payloadLength);
+    return;
+  }
+  now = CC2530Bee_readSleepTimer();
+  if (Duplicate_check(IEEE802154_RxDataFrame.fcf.sourceAddressMode, IEEE802154_RxDataFrame.sourceAddress.shortAddress,
+                      IEEE802154_RxDataFrame.sourceAddress.extendedAdress, IEEE802154_RxDataFrame.sequenceNumber, now))
+  {
+    /* retransmission as ACK was lost, slot is not committed */
+    FramePool_release(payload);
+    CC2530Bee_statistics.radioRxDuplicates++;
+    TRACE(TRACE_RX_EXIT, payloadLength);
+    return;
+  }
+  slot->source.sourceAddressMode = IEEE802154_RxDataFrame.fcf.sourceAddressMode;
+  if (slot->source.sourceAddressMode == IEEE802154_FCF_ADDRESS_MODE_64BIT)
+  {
+    memcpy(&(slot->source.extendedAddress), &(IEEE802154_RxDataFrame.sourceAddress.extendedAdress), sizeof(IEEE802154_ExtendedAddress_t) );
+  }
+  else
+  {
+    slot->source.shortAddress = IEEE802154_RxDataFrame.sourceAddress.shortAddress;
+  }
+  slot->source.rssi = rssi;
+  slot->source.sequenceNumber = IEEE802154_RxDataFrame.sequenceNumber;
+  slot->source.options = 0x00;
+  if ((IEEE802154_RxDataFrame.fcf.destinationAddressMode == IEEE802154_FCF_ADDRESS_MODE_16BIT) &&
+      (IEEE802154_RxDataFrame.destinationAddress.shortAddress == IEEE802154_BROADCAST_ADDRESS_16BIT))
+  {
+    slot->source.options |= UARTAPI_RECEVICE_OPTIONS_ADDRESS_BROADCAST;
+  }
+  if (IEEE802154_RxDataFrame.destinationPANID == IEEE802154_BROADCAST_PAN_ID)
+  {
+    slot->source.options |= UARTAPI_RECEVICE_OPTIONS_PAN_BROADCAST;
+  }
+  if (payloadLength > RXQUEUE_MAX_PAYLOAD_LENGTH)
+  {
+    payloadLength = RXQUEUE_MAX_PAYLOAD_LENGTH;
+  }
+  slot->control = IEEE802154_RxDataFrame.fcf.reserved & CC2530BEE_FCF_RESERVED_CONTROL;
+  slot->length = payloadLength;
+  slot->payload = IEEE802154_RxDataFrame.payload;
+  IEEE802154_RxDataFrame.payload = payload;
+  RxQueue_commit();
+  /* only a frame which is passed on is recorded, a lost one is taken again when it is repeated */
+  Duplicate_record(IEEE802154_RxDataFrame.fcf.sourceAddressMode, IEEE802154_RxDataFrame.sourceAddress.shortAddress,
+                   IEEE802154_RxDataFrame.sourceAddress.extendedAdress, IEEE802154_RxDataFrame.sequenceNumber, now);
+  TRACE(TRACE_RX_EXIT, payloadLength);
 }
 
 /**
@@ -562,11 +2804,17 @@ void IEEE802154_UserCbk_DataFrameReceived(uint8_t payloadLength, sint8_t rssi)
 */
 void IEEE802154_UserCbk_AckFrameReceived(uint8_t payloadLength, sint8_t rssi)
 {
-  txAPIFrame.header.length = UARTAPI_TX_STATUS_HEADER_SIZE + UARTAPI_TX_STATUS_PAYLOAD_SIZE;
-  txAPIFrame.data[0] = UARTAPI_TRANSMIT_STATUS;
-  txAPIFrame.data[UARTAPI_TX_STATUS_FRAME_ID] = IEEE802154_RxDataFrame.sequenceNumber;
-  txAPIFrame.data[UARTAPI_TX_STATUS_STATUS_BYTE] = UARTAPI_TX_STATUS_SUCCESS;
-  UARTAPI_sentFrame(txAPIFrame.data, txAPIFrame.header.length);
+  /* TX status is sent from main loop, see CC2530Bee_radioTxPoll */
+  TRACE(TRACE_ACK, IEEE802154_RxDataFrame.sequenceNumber);
+  if (CC2530Bee_Config.SnifferMode == CC2530BEE_SNIFFERMODE_ON)
+  {
+    Sniffer_record(&IEEE802154_RxDataFrame, payloadLength, rssi, 1, CC2530Bee_readSleepTimer());
+  }
+  if ((CC2530Bee_radioTx.state == CC2530BeeRadioTx_WaitAck) &&
+      (IEEE802154_RxDataFrame.sequenceNumber == radioTxFrame.sequenceNumber))
+  {
+    CC2530Bee_radioTx.ackReceived = 1;
+  }
 }
 
 /**
@@ -577,7 +2825,11 @@ void IEEE802154_UserCbk_AckFrameReceived(uint8_t payloadLength, sint8_t rssi)
 */
 void IEEE802154_UserCbk_MACCommandFrameReceived(uint8_t payloadLength, sint8_t rssi)
 {
-  
+  CC2530Bee_statistics.radioOtherFrames++;
+  if (CC2530Bee_Config.SnifferMode == CC2530BEE_SNIFFERMODE_ON)
+  {
+    Sniffer_record(&IEEE802154_RxDataFrame, payloadLength, rssi, 1, CC2530Bee_readSleepTimer());
+  }
 }
 
 /**
@@ -588,7 +2840,11 @@ void IEEE802154_UserCbk_MACCommandFrameReceived(uint8_t payloadLength, sint8_t r
 */
 void IEEE802154_UserCbk_CRCError(uint8_t payloadLength, sint8_t rssi)
 {
-  
+  CC2530Bee_statistics.radioCRCErrors++;
+  if (CC2530Bee_Config.SnifferMode == CC2530BEE_SNIFFERMODE_ON)
+  {
+    Sniffer_record(&IEEE802154_RxDataFrame, payloadLength, rssi, 0, CC2530Bee_readSleepTimer());
+  }
 }
 
 /** @}*/
\ No newline at end of file